@@ -0,0 +1,52 @@
+/**
+ * @file alias_table.h
+ * @brief Walker/Vose alias tables for constant-time weighted draws.
+ *
+ * A table is built once from a list of non-negative weights (O(n)) and then
+ * answers every draw with one column lookup and one comparison, whatever the
+ * number of outcomes. Draws take 64 random bits from the caller, so a table
+ * can be sampled from any seeded stream (counter_rng, worldgen splitmix, ...)
+ * without owning random state of its own.
+ */
+
+#ifndef ALIAS_TABLE_H
+#define ALIAS_TABLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct AliasTable
+{
+    int    count;       /**< Number of outcomes (columns). */
+    float* threshold;   /**< Probability of keeping the column's own outcome. */
+    int*   alias;       /**< Outcome returned when the column is not kept. */
+    float  totalWeight; /**< Sum of the weights the table was built from. */
+} AliasTable;
+
+/**
+ * @brief Builds the table for @p count weights; negative weights count as zero.
+ *
+ * Any previous contents of @p table are released first.
+ *
+ * @return false when the weights sum to zero or allocation fails; the table
+ *         is then empty and every draw returns -1.
+ */
+bool alias_table_build(AliasTable* table, const float* weights, int count);
+
+/** @brief Releases the table's arrays and leaves it empty. */
+void alias_table_free(AliasTable* table);
+
+/** @brief True when the table has at least one outcome with positive weight. */
+bool alias_table_ready(const AliasTable* table);
+
+/**
+ * @brief Draws an outcome index from 64 uniformly random bits.
+ *
+ * The high half selects the column and the low 24 bits decide between the
+ * column and its alias.
+ *
+ * @return Index in [0, count), or -1 for an empty table.
+ */
+int alias_table_sample(const AliasTable* table, uint64_t bits);
+
+#endif /* ALIAS_TABLE_H */
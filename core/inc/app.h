@@ -6,6 +6,11 @@
 #ifndef APP_H
 #define APP_H
 
+/** @brief Seed used to generate the default world. */
+#define APP_WORLD_SEED 0x12042023u
+/** @brief Salt mixed into @ref APP_WORLD_SEED to seed the entity RNG. */
+#define APP_ENTITY_SEED_SALT 0x13572468u
+
 /**
  * @brief Runs the main application loop that manages initialization, updates, and cleanup.
  */
@@ -13,6 +13,17 @@
 #define ZOOM_MIN 0.9f
 /** @brief Largest allowed zoom factor for the top-down camera. */
 #define ZOOM_MAX 4.5f
+/** @brief Time constant (seconds) of the smoothed camera velocity and zoom trend. */
+#define CAMERA_MOTION_SMOOTHING 0.15f
+
+/**
+ * @brief Smoothed motion of one camera, kept by update_camera for camera_predict.
+ */
+typedef struct CameraMotion
+{
+    Vector2 velocity; /**< Pan velocity in world units per second. */
+    float   zoomRate; /**< Zoom change per second. */
+} CameraMotion;
 
 /**
  * @brief Initializes a top-down camera centered on the middle of the map.
@@ -30,8 +41,25 @@ Camera2D init_camera(void);
  * It only applies movement and zoom based on the provided CameraInput.
  *
  * @param[in,out] camera Pointer to the active camera.
+ * @param[in,out] motion Smoothed motion of @p camera, updated from the movement applied; may be NULL.
  * @param[in] input Pointer to a CameraInput structure describing user intent.
  */
-void update_camera(Camera2D* camera, const CameraInput* input);
+void update_camera(Camera2D* camera, CameraMotion* motion, const CameraInput* input);
+
+/**
+ * @brief World-space rectangle covered by the screen for @p camera.
+ */
+Rectangle camera_view_rect(const Camera2D* camera);
+
+/**
+ * @brief Extrapolates the camera @p seconds ahead from its recent motion.
+ *
+ * update_camera keeps an exponentially smoothed pan velocity (world units per
+ * second) and zoom rate in @p motion from the movement it actually applies.
+ * The prediction moves the target along that velocity and the zoom along its
+ * trend (clamped to [ZOOM_MIN, ZOOM_MAX]); the target is not wrapped. A NULL
+ * @p motion is a still camera, such as a headless replay's, which predicts itself.
+ */
+Camera2D camera_predict(const Camera2D* camera, const CameraMotion* motion, float seconds);
 
 #endif // CAMERA_H
@@ -0,0 +1,57 @@
+/**
+ * @file counter_rng.h
+ * @brief Stateless counter-based random numbers.
+ *
+ * Each value is a pure function of a 64-bit key and a counter, so streams can
+ * be consumed in any order, split across threads, or replayed without sharing
+ * state. Keys are derived from a seed and a stream id (rule index, entity id,
+ * ...); counters usually number the draws within that stream.
+ */
+
+#ifndef COUNTER_RNG_H
+#define COUNTER_RNG_H
+
+#include <stdint.h>
+
+/** @brief splitmix64 finaliser; a strong 64-bit mixing function. */
+static inline uint64_t counter_rng_mix(uint64_t z)
+{
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/** @brief Derives the key of an independent stream from a seed. */
+static inline uint64_t counter_rng_key(uint64_t seed, uint64_t stream)
+{
+    return counter_rng_mix(seed ^ counter_rng_mix(stream + 0x9E3779B97F4A7C15ull));
+}
+
+/** @brief 64 random bits for draw @p counter of stream @p key. */
+static inline uint64_t counter_rng_u64(uint64_t key, uint64_t counter)
+{
+    return counter_rng_mix(key + counter * 0x9E3779B97F4A7C15ull);
+}
+
+/** @brief Uniform float in [0, 1). */
+static inline float counter_rng_unit(uint64_t key, uint64_t counter)
+{
+    return (float)(counter_rng_u64(key, counter) >> 40) * (1.0f / 16777216.0f);
+}
+
+/** @brief Uniform float in [min, max). */
+static inline float counter_rng_range(uint64_t key, uint64_t counter, float min, float max)
+{
+    return max <= min ? min : min + counter_rng_unit(key, counter) * (max - min);
+}
+
+/** @brief Uniform integer in [min, max]. */
+static inline int counter_rng_int(uint64_t key, uint64_t counter, int min, int max)
+{
+    if (max < min)
+        return min;
+    uint64_t span = (uint64_t)((int64_t)max - (int64_t)min + 1);
+    return min + (int)(counter_rng_u64(key, counter) % span);
+}
+
+#endif /* COUNTER_RNG_H */
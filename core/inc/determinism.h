@@ -0,0 +1,86 @@
+/**
+ * @file determinism.h
+ * @brief Headless determinism checker comparing state hashes across thread counts.
+ *
+ * The checker replays the same seed several times (1, 2, 4 and all available
+ * worker threads), records a @ref StateHash after world generation and after
+ * every fixed simulation tick, and reports the first tick and subsystem where
+ * two runs disagree. Each run executes in its own process so that no global
+ * state leaks from one replay into the next.
+ *
+ * The seed sweep instead runs consecutive seeds as successive WorldContexts in
+ * one process, replays the first seed to prove no state carried over, then
+ * steps all of them at once on their own threads to prove live worlds share
+ * no mutable state.
+ *
+ * Command line:
+ *   containment_tycoon --determinism-check [ticks]
+ *   containment_tycoon --hash-trace <threads> <ticks> <output-file>
+ *   containment_tycoon --seed-sweep [seeds] [ticks]
+ *   containment_tycoon --hibernate-check
+ */
+
+#ifndef DETERMINISM_H
+#define DETERMINISM_H
+
+#include <stdbool.h>
+
+/** @brief Number of fixed simulation ticks replayed when none is requested. */
+#define DETERMINISM_DEFAULT_TICKS 600
+/** @brief Fixed simulation step used by headless replays (seconds). */
+#define DETERMINISM_TICK_SECONDS (1.0f / 60.0f)
+/** @brief Number of seeds run by the seed sweep when none is requested. */
+#define DETERMINISM_SWEEP_DEFAULT_SEEDS 4
+
+/**
+ * @brief Handles the determinism command-line modes.
+ *
+ * @param argc Argument count forwarded from main().
+ * @param argv Argument vector forwarded from main().
+ * @param[out] exitCode Process exit code when a headless mode ran.
+ * @return true if a headless mode was recognised and executed, false to start the game normally.
+ */
+bool determinism_handle_command_line(int argc, char** argv, int* exitCode);
+
+/**
+ * @brief Runs one headless replay and writes one hash line per tick.
+ *
+ * @param threads Worker thread count to use for parallel passes.
+ * @param ticks Number of fixed ticks to simulate after world generation.
+ * @param outputPath Destination text file (one "tick h0 h1 h2 h3" line per tick).
+ * @return 0 on success, non-zero on failure.
+ */
+int determinism_run_trace(int threads, int ticks, const char* outputPath);
+
+/**
+ * @brief Replays the default seed at several thread counts and compares the traces.
+ *
+ * @param executable Path of the current executable, used to spawn the replays.
+ * @param ticks Number of fixed ticks per replay.
+ * @return 0 when every replay matches the single-threaded reference, 1 otherwise.
+ */
+int determinism_run_check(const char* executable, int ticks);
+
+/**
+ * @brief Runs @p count seeds one after another in this process and prints their final hashes.
+ *
+ * Seeds start at APP_WORLD_SEED. Every world uses all hardware threads for
+ * its parallel passes; the first seed is replayed at the end and must hash
+ * identically, and every world stepped concurrently with the others must
+ * reach its serial hash.
+ *
+ * @return 0 when the replay and the parallel run match, 1 otherwise.
+ */
+int determinism_run_seed_sweep(int count, int ticks);
+
+/**
+ * @brief Promotes a streamed resident, hibernates it and wakes it again.
+ *
+ * The archived record and the woken entity must both carry the promoted form,
+ * age, hunger and behaviour state the resident had when it left the view.
+ *
+ * @return 0 when the state survived the round trip, 1 otherwise.
+ */
+int determinism_run_hibernate_check(void);
+
+#endif /* DETERMINISM_H */
@@ -0,0 +1,99 @@
+/**
+ * @file frame_budget.h
+ * @brief Frame-time governor that defers or thins optional work under load.
+ *
+ * Each deferrable task is declared once in a static table with a priority and
+ * a maximum number of frames it may be postponed. The governor measures the
+ * CPU time of each frame (excluding the vsync wait) against the target from
+ * @ref TUNABLE_FRAME_BUDGET_MS, derives a load level from a smoothed average,
+ * and answers "may this task run now?" for every subsystem.
+ *
+ * The governor stays disabled until @ref frame_budget_init is called, so the
+ * headless determinism replay always runs every task.
+ */
+
+#ifndef FRAME_BUDGET_H
+#define FRAME_BUDGET_H
+
+#include <stdbool.h>
+
+/**
+ * @enum FramePriority
+ * @brief Importance of a deferrable task (lower values survive longer).
+ */
+typedef enum FramePriority
+{
+    FRAME_PRIORITY_HIGH = 0, /**< Only thinned when the frame is badly over budget. */
+    FRAME_PRIORITY_NORMAL,   /**< Thinned, then deferred, as load increases. */
+    FRAME_PRIORITY_LOW,      /**< First to go when the frame runs long. */
+    FRAME_PRIORITY_COUNT
+} FramePriority;
+
+/**
+ * @enum FrameTask
+ * @brief Deferrable work registered with the governor.
+ */
+typedef enum FrameTask
+{
+    FRAME_TASK_CHUNK_PREWARM = 0,   /**< Rebuilding chunks outside the visible area. */
+    FRAME_TASK_BUILDING_DETECTION,  /**< Incremental building detection after edits. */
+    FRAME_TASK_RESIDENT_REFRESH,    /**< Periodic structure resident scheduling. */
+    FRAME_TASK_REPATH,              /**< Periodic A* re-pathing (interval is stretched). */
+    FRAME_TASK_LABEL_DETAILS,       /**< Aura/pantry/resident lines under building names. */
+    FRAME_TASK_COUNT
+} FrameTask;
+
+/**
+ * @enum FrameTaskState
+ * @brief Decision for a task during the current frame.
+ */
+typedef enum FrameTaskState
+{
+    FRAME_TASK_RUN = 0, /**< Run normally. */
+    FRAME_TASK_THIN,    /**< Run at a reduced rate. */
+    FRAME_TASK_DEFER    /**< Skip this frame. */
+} FrameTaskState;
+
+/** @brief Enables the governor and clears its history. */
+void frame_budget_init(void);
+
+/** @brief Marks the start of a frame and recomputes the load level. */
+void frame_budget_begin_frame(void);
+
+/** @brief Marks the end of the frame's CPU work (call before the buffer swap). */
+void frame_budget_end_frame(void);
+
+/**
+ * @brief Returns the current decision for a task without consuming it.
+ *
+ * Level based, so it does not flicker between frames; useful for drawing
+ * decisions.
+ */
+FrameTaskState frame_budget_task_state(FrameTask task);
+
+/**
+ * @brief Asks whether a task may run now.
+ *
+ * Thinned tasks run every other request, deferred tasks are refused, and the
+ * current frame's elapsed time is also checked so late work is pushed to the
+ * next frame. A task refused more than its configured limit is forced to run.
+ *
+ * @return true if the caller should perform the work now.
+ */
+bool frame_budget_allow(FrameTask task);
+
+/**
+ * @brief Multiplier applied to periodic task intervals (1 when relaxed).
+ */
+float frame_budget_interval_scale(FrameTask task);
+
+/** @brief Current load level (0 = relaxed, 3 = heavily over budget). */
+int frame_budget_load_level(void);
+
+/** @brief Smoothed CPU time per frame in milliseconds. */
+float frame_budget_average_ms(void);
+
+/** @brief Number of task requests refused during the last completed frame. */
+int frame_budget_deferred_last_frame(void);
+
+#endif /* FRAME_BUDGET_H */
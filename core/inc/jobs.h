@@ -0,0 +1,117 @@
+/**
+ * @file jobs.h
+ * @brief Native worker pool and job system shared by every subsystem.
+ *
+ * One pool of pthread workers is created at start-up. Each worker owns a
+ * deque: it pushes and pops its own jobs LIFO while idle workers steal FIFO
+ * from the others. The thread that called @ref jobs_init takes part too:
+ * waiting on a group runs queued jobs instead of blocking, so nested
+ * parallelism never oversubscribes the machine.
+ *
+ * Jobs are grouped with a @ref JobGroup counter. A group may carry a
+ * continuation that is queued once its last job finishes, which is how task
+ * dependencies are expressed.
+ *
+ * When the pool is not initialised (or has a single thread) every call runs
+ * inline on the caller, so code using the API stays correct in tools.
+ */
+
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief Upper bound on pool threads (including the calling thread). */
+#define JOBS_MAX_THREADS 32
+
+/**
+ * @brief Storage class for per-thread scratch buffers.
+ *
+ * Every pool worker, and any other thread, gets its own zero-initialised copy.
+ */
+#define JOBS_THREAD_LOCAL __thread
+
+/** @brief Work item callback. */
+typedef void (*JobFn)(void* user);
+
+/** @brief Range callback used by @ref jobs_parallel_for ([begin, end)). */
+typedef void (*JobRangeFn)(void* user, int begin, int end);
+
+/**
+ * @struct JobGroup
+ * @brief Completion counter for a set of jobs, with an optional continuation.
+ *
+ * Initialise with @ref jobs_group_init; the fields are managed by the pool.
+ */
+typedef struct JobGroup
+{
+    volatile int     pending;      /**< Jobs submitted but not finished. */
+    JobFn            thenFn;       /**< Continuation queued when pending drops to zero. */
+    void*            thenUser;     /**< Continuation argument. */
+    struct JobGroup* thenGroup;    /**< Group the continuation is accounted in (may be NULL). */
+} JobGroup;
+
+/**
+ * @struct JobsFrameStats
+ * @brief Core utilisation measured between two @ref jobs_frame_begin calls.
+ */
+typedef struct JobsFrameStats
+{
+    int      threadCount;               /**< Threads in the pool (including the caller). */
+    float    wallMs;                    /**< Frame duration. */
+    float    busyMs[JOBS_MAX_THREADS];  /**< Time each thread spent running jobs. */
+    uint32_t jobsRun;                   /**< Jobs completed during the frame. */
+    uint32_t steals;                    /**< Jobs taken from another thread's deque. */
+    float    utilization;               /**< Sum of busy time / (wall time * threads). */
+} JobsFrameStats;
+
+/**
+ * @brief Starts the pool.
+ *
+ * @param threadCount Total threads including the caller; <= 0 uses every hardware thread.
+ */
+void jobs_init(int threadCount);
+
+/** @brief Stops and joins the workers. Pending jobs are finished first. */
+void jobs_shutdown(void);
+
+/** @brief Number of threads taking part in jobs (1 when the pool is off). */
+int jobs_thread_count(void);
+
+/** @brief Number of hardware threads reported by the OS. */
+int jobs_hardware_threads(void);
+
+/** @brief Resets a group before use. */
+void jobs_group_init(JobGroup* group);
+
+/**
+ * @brief Registers a continuation to queue when @p group completes.
+ *
+ * Must be called before the first job is submitted to @p group. The
+ * continuation is counted in @p target (if any) immediately, so waiting on
+ * @p target also waits for it.
+ */
+void jobs_group_then(JobGroup* group, JobFn fn, void* user, JobGroup* target);
+
+/** @brief Queues a job in @p group (NULL for fire-and-forget). */
+void jobs_submit(JobGroup* group, JobFn fn, void* user);
+
+/** @brief Runs queued jobs on the calling thread until @p group completes. */
+void jobs_wait(JobGroup* group);
+
+/**
+ * @brief Splits [0, count) into chunks of about @p grain items and runs them in parallel.
+ *
+ * Chunk boundaries depend only on @p count and @p grain, never on the number
+ * of threads, so per-chunk results are reproducible. Blocks until done.
+ */
+void jobs_parallel_for(int count, int grain, JobRangeFn fn, void* user);
+
+/** @brief Closes the current utilisation window and opens the next one. */
+void jobs_frame_begin(void);
+
+/** @brief Statistics of the last completed utilisation window. */
+const JobsFrameStats* jobs_last_frame_stats(void);
+
+#endif /* JOBS_H */
@@ -0,0 +1,82 @@
+/**
+ * @file profiler.h
+ * @brief Lightweight per-frame timing scopes and counters with an on-screen readout.
+ *
+ * Sections are measured with raylib's high resolution clock and smoothed with
+ * an exponential moving average so the readout stays legible while knobs from
+ * @ref tunables.h are being adjusted.
+ *
+ * Only the thread that calls @ref profiler_frame_begin records; sections and
+ * counters hit on any other thread are ignored.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+
+/**
+ * @enum ProfilerSection
+ * @brief Timed regions of a frame.
+ */
+typedef enum ProfilerSection
+{
+    PROFILER_FRAME = 0,   /**< Whole frame (update + draw). */
+    PROFILER_SIMULATION,  /**< Time, season and entity updates. */
+    PROFILER_ENTITIES,    /**< entity_system_update alone. */
+    PROFILER_OBJECTS,     /**< Object animation/environment update. */
+    PROFILER_BUILDINGS,   /**< Incremental building detection. */
+    PROFILER_CHUNKS,      /**< Chunk cache rebuild + blit. */
+    PROFILER_DRAW,        /**< Whole world/UI draw. */
+    PROFILER_SECTION_COUNT
+} ProfilerSection;
+
+/**
+ * @enum ProfilerCounter
+ * @brief Events counted per frame.
+ */
+typedef enum ProfilerCounter
+{
+    PROFILER_COUNT_CHUNK_REBUILDS = 0, /**< Chunk render textures rebuilt. */
+    PROFILER_COUNT_PATH_QUERIES,       /**< pathfinding_find_path calls. */
+    PROFILER_COUNTER_COUNT
+} ProfilerCounter;
+
+/** @brief Starts a new frame: resets counters and opens the frame section. */
+void profiler_frame_begin(void);
+
+/** @brief Closes the frame section and folds the frame into the averages. */
+void profiler_frame_end(void);
+
+/** @brief Starts timing a section (sections may nest but not recurse). */
+void profiler_begin(ProfilerSection section);
+
+/** @brief Stops timing a section and accumulates its duration for this frame. */
+void profiler_end(ProfilerSection section);
+
+/** @brief Adds @p amount to a per-frame counter. */
+void profiler_count(ProfilerCounter counter, int amount);
+
+/** @brief Returns the smoothed duration of a section in milliseconds. */
+float profiler_average_ms(ProfilerSection section);
+
+/** @brief Returns the duration of a section during the last completed frame (ms). */
+float profiler_last_ms(ProfilerSection section);
+
+/** @brief Returns the smoothed per-frame value of a counter. */
+float profiler_average_count(ProfilerCounter counter);
+
+/** @brief Returns a short printable name for a section. */
+const char* profiler_section_name(ProfilerSection section);
+
+/**
+ * @brief Draws a compact readout of the smoothed timings and counters.
+ *
+ * @param x Screen X of the top-left corner.
+ * @param y Screen Y of the top-left corner.
+ * @param fontSize Text size in pixels.
+ * @return Height of the drawn block in pixels.
+ */
+int profiler_draw(int x, int y, int fontSize);
+
+#endif /* PROFILER_H */
@@ -0,0 +1,69 @@
+/**
+ * @file state_hash.h
+ * @brief Fast 64-bit fingerprints of the simulated world state.
+ *
+ * The hash is split into independent sections (tiles, objects, buildings,
+ * entities) so that a mismatch between two runs can be attributed to the
+ * subsystem that diverged first. Only simulation data is hashed: pointers,
+ * render caches and derived light/heat fields are ignored.
+ */
+
+#ifndef STATE_HASH_H
+#define STATE_HASH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "world.h"
+#include "entity.h"
+
+/**
+ * @enum StateHashSection
+ * @brief Subsystems fingerprinted independently by @ref state_hash_compute.
+ */
+typedef enum StateHashSection
+{
+    STATE_HASH_TILES = 0,
+    STATE_HASH_OBJECTS,
+    STATE_HASH_BUILDINGS,
+    STATE_HASH_ENTITIES,
+    STATE_HASH_SECTION_COUNT
+} StateHashSection;
+
+/**
+ * @struct StateHash
+ * @brief Per-section fingerprints plus a combined digest of the whole world.
+ */
+typedef struct StateHash
+{
+    uint64_t sections[STATE_HASH_SECTION_COUNT]; /**< One digest per @ref StateHashSection. */
+    uint64_t combined;                           /**< Digest of all sections, in enum order. */
+} StateHash;
+
+/**
+ * @brief Computes the fingerprint of the current world state.
+ *
+ * Map chunks are only rehashed when flagged through map_note_digest_change()
+ * since the previous call, so a tick costs the chunks it edited plus a pass
+ * over object records, buildings and active entities.
+ *
+ * @param map Map to hash (tiles, climate layers and objects); its per-chunk
+ *            digest is refreshed. May be NULL.
+ * @param sys Entity system to hash. May be NULL.
+ * @param[out] out Receives the section digests.
+ */
+void state_hash_compute(Map* map, const EntitySystem* sys, StateHash* out);
+
+/**
+ * @brief Returns the first section that differs between two fingerprints.
+ *
+ * @return Index of the diverging @ref StateHashSection, or -1 when both match.
+ */
+int state_hash_first_mismatch(const StateHash* a, const StateHash* b);
+
+/**
+ * @brief Returns a short printable name for a hash section.
+ */
+const char* state_hash_section_name(StateHashSection section);
+
+#endif /* STATE_HASH_H */
@@ -0,0 +1,94 @@
+/**
+ * @file tunables.h
+ * @brief Runtime registry of performance-related knobs.
+ *
+ * Budgets and radii that used to be compile-time constants (chunk rebuild
+ * budget, re-path intervals, search radii, streaming padding...) are stored
+ * here so they can be loaded from data/tunables.stv and edited live from the
+ * settings menu. Consumers read the current value each time they need it.
+ */
+
+#ifndef TUNABLES_H
+#define TUNABLES_H
+
+#include <stdbool.h>
+
+/** @brief Default location of the tunables definition file. */
+#define TUNABLES_DEFAULT_PATH "data/tunables.stv"
+
+/**
+ * @enum TunableId
+ * @brief Identifies every runtime knob exposed by the registry.
+ */
+typedef enum TunableId
+{
+    TUNABLE_CHUNK_REBUILD_BUDGET = 0,     /**< Chunk render textures rebuilt per frame. */
+    TUNABLE_CHUNK_PRELOAD_MARGIN,         /**< Ring of chunks prepared around the viewport. */
+    TUNABLE_CAMERA_PREFETCH_SECONDS,      /**< How far ahead camera motion is extrapolated for prefetching. */
+    TUNABLE_PATH_REPATH_INTERVAL,         /**< Seconds between re-paths after a successful search. */
+    TUNABLE_PATH_RETRY_INTERVAL,          /**< Seconds before retrying after a failed search. */
+    TUNABLE_PATH_MAX_EXTENT,              /**< Padding (tiles) added around start/goal for A* windows. */
+    TUNABLE_RESIDENT_REFRESH_INTERVAL,    /**< Seconds between structure resident refreshes. */
+    TUNABLE_HUNT_SEARCH_RADIUS,           /**< Hunt target search radius in tiles. */
+    TUNABLE_GATHER_SEARCH_RADIUS,         /**< Gather target search radius in tiles. */
+    TUNABLE_STREAM_ACTIVATION_PADDING,    /**< Tiles beyond the view where reservations wake up. */
+    TUNABLE_STREAM_DEACTIVATION_PADDING,  /**< Tiles beyond the view where entities hibernate. */
+    TUNABLE_FRAME_BUDGET_MS,              /**< CPU time per frame the governor tries to stay under. */
+    TUNABLE_COUNT
+} TunableId;
+
+/**
+ * @struct TunableDef
+ * @brief Static description of a knob (file key, label, range).
+ */
+typedef struct TunableDef
+{
+    const char* key;          /**< Key used in the .stv file. */
+    const char* labelKey;     /**< Localization key displayed in the settings menu. */
+    float       defaultValue; /**< Value used when the file does not override it. */
+    float       minValue;     /**< Lower clamp. */
+    float       maxValue;     /**< Upper clamp. */
+    float       step;         /**< Increment applied by the settings buttons. */
+    bool        integer;      /**< True when the value is rounded to whole numbers. */
+} TunableDef;
+
+/**
+ * @brief Restores every knob to its compiled default.
+ */
+void tunables_reset_defaults(void);
+
+/**
+ * @brief Loads overrides from an STV file (unknown keys are reported and ignored).
+ *
+ * @param path File to read. NULL uses @ref TUNABLES_DEFAULT_PATH.
+ * @return true if the file was read.
+ */
+bool tunables_load(const char* path);
+
+/**
+ * @brief Writes the current values to an STV file.
+ *
+ * The comment header of an existing file is kept; a new file gets a short
+ * default one.
+ *
+ * @param path File to write. NULL uses @ref TUNABLES_DEFAULT_PATH.
+ * @return true on success.
+ */
+bool tunables_save(const char* path);
+
+/** @brief Returns the static description of a knob, or NULL for invalid ids. */
+const TunableDef* tunable_def(TunableId id);
+
+/** @brief Returns the current value of a knob. */
+float tunable_get(TunableId id);
+
+/** @brief Returns the current value of a knob rounded to an integer. */
+int tunable_get_int(TunableId id);
+
+/** @brief Sets a knob, clamping it to its range. */
+void tunable_set(TunableId id, float value);
+
+/** @brief Moves a knob by a number of steps (negative to decrease). */
+void tunable_step(TunableId id, int steps);
+
+#endif /* TUNABLES_H */
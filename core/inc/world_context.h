@@ -0,0 +1,59 @@
+/**
+ * @file world_context.h
+ * @brief One simulated world: its map, entities and clock.
+ *
+ * A context owns the per-world instance data the application used to keep in
+ * file-level globals, and runs the generation and fixed-step sequence shared
+ * by the interactive loop and the headless tools. Immutable definitions (tile
+ * and object types, structure and biome definitions, tunables, entity type
+ * files) stay shared and are loaded once per process.
+ *
+ * The map carries its buildings, pantries, generator state and render cache;
+ * the entity system its doors, light schedule and path tracks. Nothing a
+ * context mutates is shared, so several contexts may be live at once and be
+ * stepped on different threads. Loading entity sprites needs the GL context,
+ * so @ref world_context_init and @ref world_context_shutdown stay on the
+ * thread that owns it.
+ */
+
+#ifndef WORLD_CONTEXT_H
+#define WORLD_CONTEXT_H
+
+#include <stdbool.h>
+
+#include "raylib.h"
+#include "building.h"
+#include "camera.h"
+#include "entity.h"
+#include "object.h"
+#include "world.h"
+#include "world_generation.h"
+#include "world_time.h"
+
+typedef struct WorldContext
+{
+    Map          map;
+    EntitySystem entities;
+    WorldTime    time;
+    unsigned int seed; /**< World generation seed. */
+    int          tick; /**< Simulation steps run since generation. */
+} WorldContext;
+
+/**
+ * @brief Generates the world for @p seed: terrain, buildings, clock and population.
+ *
+ * @return false when @p ctx is NULL.
+ */
+bool world_context_init(WorldContext* ctx, unsigned int seed);
+
+/**
+ * @brief Advances the clock, season effects, entities and objects by @p dt seconds.
+ *
+ * @p camera and its smoothed @p motion steer entity streaming; @p motion may be NULL for a still camera.
+ */
+void world_context_step(WorldContext* ctx, const Camera2D* camera, const CameraMotion* motion, float dt);
+
+/** @brief Releases the world's entities and map (with its object records and buildings). */
+void world_context_shutdown(WorldContext* ctx);
+
+#endif /* WORLD_CONTEXT_H */
@@ -0,0 +1,118 @@
+/**
+ * @file alias_table.c
+ * @brief Implements alias table construction (Vose's method) and sampling.
+ */
+
+#include "alias_table.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+void alias_table_free(AliasTable* table)
+{
+    if (!table)
+        return;
+    free(table->threshold);
+    free(table->alias);
+    memset(table, 0, sizeof(*table));
+}
+
+bool alias_table_build(AliasTable* table, const float* weights, int count)
+{
+    if (!table)
+        return false;
+    alias_table_free(table);
+    if (!weights || count <= 0)
+        return false;
+
+    double total    = 0.0;
+    int    positive = -1;
+    for (int i = 0; i < count; ++i)
+    {
+        if (weights[i] <= 0.0f)
+            continue;
+        total += weights[i];
+        positive = i;
+    }
+    if (total <= 0.0)
+        return false;
+
+    table->threshold = (float*)malloc((size_t)count * sizeof(float));
+    table->alias     = (int*)malloc((size_t)count * sizeof(int));
+    double* scaled   = (double*)malloc((size_t)count * sizeof(double));
+    int*    work     = (int*)malloc((size_t)count * sizeof(int));
+    if (!table->threshold || !table->alias || !scaled || !work)
+    {
+        free(scaled);
+        free(work);
+        alias_table_free(table);
+        return false;
+    }
+
+    // Scale so the average column holds exactly 1; split indices into columns
+    // below (filled from the front of work) and above (from the back) that mark.
+    int small = 0;
+    int large = count;
+    for (int i = 0; i < count; ++i)
+    {
+        scaled[i] = (weights[i] > 0.0f ? weights[i] : 0.0) * (double)count / total;
+        if (scaled[i] < 1.0)
+            work[small++] = i;
+        else
+            work[--large] = i;
+    }
+
+    // Top up each small column from a large one; the large one shrinks and may
+    // itself become small.
+    while (small > 0 && large < count)
+    {
+        int s = work[--small];
+        int l = work[large];
+
+        table->threshold[s] = (float)scaled[s];
+        table->alias[s]     = l;
+
+        scaled[l] -= 1.0 - scaled[s];
+        if (scaled[l] < 1.0)
+        {
+            large++;
+            work[small++] = l;
+        }
+    }
+
+    // Leftovers are full columns up to rounding error; a zero weight must
+    // still never be drawn, so it forwards to a positive outcome.
+    while (large < count)
+    {
+        int l               = work[large++];
+        table->threshold[l] = 1.0f;
+        table->alias[l]     = l;
+    }
+    while (small > 0)
+    {
+        int s               = work[--small];
+        table->threshold[s] = weights[s] > 0.0f ? 1.0f : 0.0f;
+        table->alias[s]     = weights[s] > 0.0f ? s : positive;
+    }
+
+    free(scaled);
+    free(work);
+    table->count       = count;
+    table->totalWeight = (float)total;
+    return true;
+}
+
+bool alias_table_ready(const AliasTable* table)
+{
+    return table && table->count > 0;
+}
+
+int alias_table_sample(const AliasTable* table, uint64_t bits)
+{
+    if (!alias_table_ready(table))
+        return -1;
+
+    int   column = (int)(((bits >> 32) * (uint64_t)table->count) >> 32);
+    float coin   = (float)(bits & 0xFFFFFFu) * (1.0f / 16777216.0f);
+    return coin < table->threshold[column] ? column : table->alias[column];
+}
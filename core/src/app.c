@@ -8,6 +8,7 @@
 #include <stdint.h>
 #include "raylib.h"
 
+#include "app.h"
 #include "input.h"
 #include "ui.h"
 #include "ui_theme.h"
@@ -21,20 +22,27 @@
 #include "world.h"
 #include "world_chunk.h"
 #include "debug.h"
+#include "door_controller.h"
 #include "entity.h"
 #include "world_time.h"
+#include "world_context.h"
 #include "music.h"
 #include "world_structures.h"
 #include "localization.h"
+#include "frame_budget.h"
+#include "jobs.h"
+#include "path_telemetry.h"
+#include "profiler.h"
+#include "tunables.h"
 // -----------------------------------------------------------------------------
 // Global world data
 // -----------------------------------------------------------------------------
-static Map          G_MAP        = {0};
-static Camera2D     G_CAMERA     = {0};
-static InputState   G_INPUT      = {0};
-static EntitySystem G_ENTITIES   = {0};
-static WorldTime    G_WORLD_TIME = {0};
-// ChunkGrid*        gChunks  = NULL;
+static WorldContext G_WORLD         = {0};
+static Camera2D     G_CAMERA        = {0};
+static CameraMotion G_CAMERA_MOTION = {0};
+static InputState   G_INPUT         = {0};
+static bool      G_SHOW_PROFILER       = false;
+static bool      G_SHOW_PATH_HEATMAP   = false;
 static bool      G_BUILDING_DIRTY      = false;
 static Rectangle G_BUILDING_DIRTY_BBOX = {0};
 
@@ -131,10 +139,12 @@ static void app_init(void)
 {
     const int      screenWidth  = 1280;
     const int      screenHeight = 720;
-    const uint64_t seed         = 0x12042023; // 0xA1B2C3D4u;
+    const uint64_t seed         = APP_WORLD_SEED; // 0xA1B2C3D4u;
 
     if (!localization_init(NULL))
         TraceLog(LOG_WARNING, "Localization system failed to initialize, falling back to keys.");
+    tunables_load(NULL);
+    frame_budget_init();
 
     // Prepare the rendering window and the frame pacing.
     // SetConfigFlags(FLAG_FULLSCREEN_MODE);
@@ -142,25 +152,18 @@ static void app_init(void)
     SetExitKey(KEY_NULL);
     SetTargetFPS(40);
 
+    // One worker pool for every parallel subsystem.
+    jobs_init(0);
+
     // Load static resources such as tiles and placeable objects.
     init_tile_types();
     init_objects();
+    worldgen_load_definitions();
 
     // Build the world and load entity definitions.
-    map_init(&G_MAP, seed);
-    world_time_init(&G_WORLD_TIME);
-    world_apply_season_effects(&G_MAP, &G_WORLD_TIME);
-    Rectangle fullRegion = {
-        .x      = 0.0f,
-        .y      = 0.0f,
-        .width  = (float)(G_MAP.width * TILE_SIZE),
-        .height = (float)(G_MAP.height * TILE_SIZE),
-    };
-    update_building_detection(&G_MAP, fullRegion);
+    world_context_init(&G_WORLD, seed);
     G_BUILDING_DIRTY      = false;
     G_BUILDING_DIRTY_BBOX = (Rectangle){0.0f, 0.0f, 0.0f, 0.0f};
-    if (!entity_system_init(&G_ENTITIES, &G_MAP, seed ^ 0x13572468u, "data/entities.stv"))
-        TraceLog(LOG_WARNING, "Entity definitions failed to load, using built-in defaults.");
 
     if (!music_system_init("data/music.stv", "gameplay"))
         TraceLog(LOG_WARNING, "Music system failed to initialize.");
@@ -168,8 +171,9 @@ static void app_init(void)
         TraceLog(LOG_WARNING, "UI theme failed to initialize.");
 
     // Set up world chunk streaming, the camera and initial input state.
-    gChunks  = chunkgrid_create(&G_MAP);
-    G_CAMERA = init_camera();
+    G_WORLD.map.chunks = chunkgrid_create(&G_WORLD.map);
+    G_CAMERA           = init_camera();
+    G_CAMERA_MOTION    = (CameraMotion){0};
     input_init(&G_INPUT);
 }
 
@@ -181,54 +185,60 @@ static void app_update(void)
     input_update(&G_INPUT);
 
     float dt = GetFrameTime();
-    ui_update(&G_INPUT, &G_ENTITIES, dt);
+    ui_update(&G_INPUT, &G_WORLD.entities, dt);
 
-    update_camera(&G_CAMERA, &G_INPUT.camera);
+    update_camera(&G_CAMERA, &G_CAMERA_MOTION, &G_INPUT.camera);
+
+    if (IsKeyPressed(KEY_F3))
+        G_SHOW_PROFILER = !G_SHOW_PROFILER;
+    if (IsKeyPressed(KEY_F7))
+        G_SHOW_PATH_HEATMAP = !G_SHOW_PATH_HEATMAP;
+    if (IsKeyPressed(KEY_F8))
+        path_telemetry_dump_csv(&G_WORLD.entities.pathTelemetry, NULL);
 
     bool paused = ui_is_paused();
     if (!paused)
     {
         if (IsKeyPressed(KEY_T))
-            world_time_cycle_timewarp(&G_WORLD_TIME);
+            world_time_cycle_timewarp(&G_WORLD.time);
 
         if (IsKeyPressed(KEY_F))
         {
             MouseState mouse;
-            input_update_mouse(&mouse, &G_CAMERA, &G_MAP);
+            input_update_mouse(&mouse, &G_CAMERA, &G_WORLD.map);
             if (mouse.insideMap)
             {
                 int     tx  = mouse.tileX;
                 int     ty  = mouse.tileY;
-                Object* obj = G_MAP.objects[ty][tx];
-                if (object_has_activation(obj) && object_toggle(obj))
-                    chunkgrid_redraw_cell(gChunks, &G_MAP, tx, ty);
+                Object* obj = map_object_record(&G_WORLD.map, tx, ty);
+                if (object_has_activation(obj) && object_toggle(&G_WORLD.map, obj))
+                    chunkgrid_redraw_cell(G_WORLD.map.chunks, &G_WORLD.map, tx, ty);
             }
         }
 
         if (IsKeyPressed(KEY_F6))
         {
             MouseState mouse;
-            input_update_mouse(&mouse, &G_CAMERA, &G_MAP);
+            input_update_mouse(&mouse, &G_CAMERA, &G_WORLD.map);
             if (mouse.insideMap)
             {
-                Building* b = building_get_at_tile(mouse.tileX, mouse.tileY);
-                building_debug_print(b, &G_ENTITIES);
+                Building* b = building_get_at_tile(&G_WORLD.map.buildings, mouse.tileX, mouse.tileY);
+                building_debug_print(&G_WORLD.map.buildings, b, &G_WORLD.entities);
             }
         }
     }
 
     music_system_update(dt);
 
-    if (paused)
+    if (paused && !ui_keeps_simulation_running())
         return;
 
-    world_time_update(&G_WORLD_TIME, dt);
-    world_apply_season_effects(&G_MAP, &G_WORLD_TIME);
-    entity_system_update(&G_ENTITIES, &G_MAP, &G_CAMERA, dt);
-    object_update_system(&G_MAP, dt);
+    profiler_begin(PROFILER_SIMULATION);
+    world_context_step(&G_WORLD, &G_CAMERA, &G_CAMERA_MOTION, dt);
+    profiler_end(PROFILER_SIMULATION);
 
     Rectangle dirtyWorld = {0.0f, 0.0f, 0.0f, 0.0f};
-    bool      changed    = editor_update(&G_MAP, &G_CAMERA, &G_INPUT, &G_ENTITIES, &dirtyWorld);
+    bool      changed    = !paused && editor_update(&G_WORLD.map, &G_CAMERA, &G_INPUT, &G_WORLD.entities, &dirtyWorld);
     if (changed)
     {
         if (G_BUILDING_DIRTY)
@@ -255,9 +265,11 @@ static void app_update(void)
     paddedView.width += TILE_SIZE * 2.0f;
     paddedView.height += TILE_SIZE * 2.0f;
 
-    if (G_BUILDING_DIRTY && rects_overlap(G_BUILDING_DIRTY_BBOX, paddedView))
+    if (G_BUILDING_DIRTY && rects_overlap(G_BUILDING_DIRTY_BBOX, paddedView) && frame_budget_allow(FRAME_TASK_BUILDING_DETECTION))
     {
-        update_building_detection(&G_MAP, paddedView);
+        profiler_begin(PROFILER_BUILDINGS);
+        update_building_detection(&G_WORLD.map, paddedView);
+        profiler_end(PROFILER_BUILDINGS);
         G_BUILDING_DIRTY      = false;
         G_BUILDING_DIRTY_BBOX = (Rectangle){0.0f, 0.0f, 0.0f, 0.0f};
     }
@@ -271,14 +283,16 @@ static void app_draw_world(void)
     BeginMode2D(G_CAMERA);
 
     // Draw static geometry (tiles + static objects)
-    chunkgrid_draw_visible(gChunks, &G_MAP, &G_CAMERA);
-    object_draw_environment(&G_MAP, &G_CAMERA);
-    object_draw_dynamic(&G_MAP, &G_CAMERA);
-    entity_system_draw(&G_ENTITIES);
+    profiler_begin(PROFILER_CHUNKS);
+    chunkgrid_draw_visible(G_WORLD.map.chunks, &G_WORLD.map, &G_CAMERA, &G_CAMERA_MOTION);
+    profiler_end(PROFILER_CHUNKS);
+    object_draw_environment(&G_WORLD.map, &G_CAMERA);
+    object_draw_dynamic(&G_WORLD.map, &G_CAMERA);
+    entity_system_draw(&G_WORLD.entities);
 
     // --- Mouse highlight ---
     MouseState mouse;
-    input_update_mouse(&mouse, &G_CAMERA, &G_MAP);
+    input_update_mouse(&mouse, &G_CAMERA, &G_WORLD.map);
 
     if (mouse.insideMap)
     {
@@ -309,10 +323,12 @@ static void app_draw_world(void)
     float viewMinY = worldView.y - TILE_SIZE;
     float viewMaxY = worldView.y + worldView.height + TILE_SIZE;
 
-    int totalBuildings = building_total_count();
+    // Under load only the names are kept; the detail lines come back once the frame is under budget.
+    bool labelDetails   = frame_budget_task_state(FRAME_TASK_LABEL_DETAILS) == FRAME_TASK_RUN;
+    int  totalBuildings = building_total_count(&G_WORLD.map.buildings);
     for (int i = 0; i < totalBuildings; i++)
     {
-        const Building* b = building_get(i);
+        const Building* b = building_get(&G_WORLD.map.buildings, i);
         if (!b)
             continue;
 
@@ -342,6 +358,8 @@ static void app_draw_world(void)
                 DrawRectangleRounded(labelRect, 0.2f, 4, ColorAlpha(BLACK, 0.6f));
             }
             DrawText(displayName, textX, textY, 12, WHITE);
+            if (!labelDetails)
+                continue;
 
             int            infoY = textY + 18;
             StructureKind  kind  = resolve_structure_kind(b);
@@ -377,7 +395,7 @@ static void app_draw_world(void)
 
             if (b->hasPantry)
             {
-                Pantry* pantry = pantry_get_for_building(b->id);
+                Pantry* pantry = pantry_get_for_building(&G_WORLD.map.buildings.pantries, b->id);
                 if (pantry)
                 {
                     int meat  = pantry->counts[PANTRY_ITEM_MEAT];
@@ -407,7 +425,7 @@ static void app_draw_world(void)
                     occLabel = localization_get("buildings.residents_fallback");
 
                 char occLine[160];
-                int  activeResidents = building_active_residents(b, &G_ENTITIES);
+                int  activeResidents = building_active_residents(b, &G_WORLD.entities);
                 snprintf(occLine,
                          sizeof(occLine),
                          localization_get("buildings.residents_line"),
@@ -443,7 +461,7 @@ static void app_draw_world(void)
 
     EndMode2D();
 
-    float darkness = world_time_get_darkness();
+    float darkness = world_time_get_darkness(&G_WORLD.time);
     if (darkness > 0.0f)
     {
         float alpha = fminf(1.0f, darkness * 0.75f);
@@ -452,12 +470,38 @@ static void app_draw_world(void)
 
     // Draw optional overlays such as biome debug view and the build inventory.
     static bool showBiomeDebug = false;
-    debug_biome_draw(&G_MAP, &G_CAMERA, &showBiomeDebug);
+    debug_biome_draw(&G_WORLD.map, &G_CAMERA, &showBiomeDebug);
+
+    if (G_SHOW_PATH_HEATMAP)
+        path_telemetry_draw_overlay(&G_WORLD.entities.pathTelemetry, &G_WORLD.map, &G_CAMERA);
 
-    world_time_draw_ui(&G_WORLD_TIME, &G_MAP, &G_CAMERA);
+    world_time_draw_ui(&G_WORLD.time, &G_WORLD.map, &G_CAMERA);
 
     // Optional: draw current tile/object selection and overlays
-    ui_draw(&G_INPUT, &G_ENTITIES);
+    ui_draw(&G_INPUT, &G_WORLD.entities);
+
+    if (G_SHOW_PROFILER)
+    {
+        int  height = profiler_draw(12, 12, 14);
+        char budgetLine[96];
+        snprintf(budgetLine,
+                 sizeof(budgetLine),
+                 "budget %.1f/%.1f ms  load %d  deferred %d",
+                 frame_budget_average_ms(),
+                 tunable_get(TUNABLE_FRAME_BUDGET_MS),
+                 frame_budget_load_level(),
+                 frame_budget_deferred_last_frame());
+        DrawText(budgetLine, 12, 12 + height, 14, ColorAlpha(WHITE, 0.85f));
+
+        const JobsFrameStats* jobs = jobs_last_frame_stats();
+        char                  jobsLine[96];
+        snprintf(jobsLine, sizeof(jobsLine), "jobs %d threads  %u jobs  %u steals  util %.0f%%", jobs->threadCount, jobs->jobsRun, jobs->steals, jobs->utilization * 100.0f);
+        DrawText(jobsLine, 12, 12 + height + 18, 14, ColorAlpha(WHITE, 0.85f));
+
+        char worldLine[96];
+        snprintf(worldLine, sizeof(worldLine), "objects %d records  doors %d held open", object_record_count(&G_WORLD.map), door_controller_open_count(&G_WORLD.entities.doors));
+        DrawText(worldLine, 12, 12 + height + 36, 14, ColorAlpha(WHITE, 0.85f));
+    }
 }
 
 /**
@@ -471,7 +515,7 @@ static void app_handle_chunk_eviction(void)
     // Every few seconds to avoid churn
     if (evictTimer > 10.0f)
     {
-        chunkgrid_evict_far(gChunks, &G_CAMERA, 5000.0f);
+        chunkgrid_evict_far(G_WORLD.map.chunks, &G_CAMERA, 5000.0f);
         evictTimer = 0.0f;
     }
 }
@@ -483,15 +527,16 @@ static void app_cleanup(void)
 {
     unload_tile_types();
     unload_object_textures();
-    entity_system_shutdown(&G_ENTITIES);
-    map_unload(&G_MAP);
-    chunkgrid_destroy(gChunks);
-    gChunks = NULL;
+    chunkgrid_destroy(G_WORLD.map.chunks);
+    G_WORLD.map.chunks = NULL;
+    world_context_shutdown(&G_WORLD);
 
     music_system_shutdown();
     ui_shutdown();
+    path_telemetry_shutdown();
 
     localization_shutdown();
+    jobs_shutdown();
 
     CloseWindow();
 }
@@ -506,6 +551,9 @@ void app_run(void)
     while (!WindowShouldClose())
     {
         // Advance the simulation and render the current frame.
+        profiler_frame_begin();
+        frame_budget_begin_frame();
+        jobs_frame_begin();
         app_update();
         if (ui_should_close_application())
             break;
@@ -513,10 +561,14 @@ void app_run(void)
         BeginDrawing();
         ClearBackground(BLANK);
 
+        profiler_begin(PROFILER_DRAW);
         app_draw_world();
+        profiler_end(PROFILER_DRAW);
         app_handle_chunk_eviction();
+        frame_budget_end_frame();
 
         EndDrawing();
+        profiler_frame_end();
     }
 
     app_cleanup();
@@ -6,6 +6,7 @@
 #include "camera.h"
 #include "map.h"
 #include "raymath.h"
+#include <math.h>
 
 Camera2D init_camera(void)
 {
@@ -28,11 +29,13 @@ Camera2D init_camera(void)
     return cam;
 }
 
-void update_camera(Camera2D* camera, const CameraInput* input)
+void update_camera(Camera2D* camera, CameraMotion* motion, const CameraInput* input)
 {
     const float moveSpeed = 500.0f;
     const float zoomSpeed = 0.1f;
     const float dt        = GetFrameTime();
+    const float zoomStart = camera->zoom;
+    Vector2     move      = {0.0f, 0.0f};
 
     // --- Keep camera centered relative to screen size ---
     camera->offset = (Vector2){GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f};
@@ -42,7 +45,7 @@ void update_camera(Camera2D* camera, const CameraInput* input)
     {
         // Normalize to keep a consistent speed even when moving diagonally.
         Vector2 dir    = Vector2Normalize(input->moveDir);
-        Vector2 move   = Vector2Scale(dir, moveSpeed * dt / camera->zoom);
+        move           = Vector2Scale(dir, moveSpeed * dt / camera->zoom);
         camera->target = Vector2Add(camera->target, move);
     }
 
@@ -69,4 +72,30 @@ void update_camera(Camera2D* camera, const CameraInput* input)
         if (camera->zoom > ZOOM_MAX)
             camera->zoom = ZOOM_MAX;
     }
+
+    // --- Motion estimate (before wrapping, so crossing the seam is not a jump) ---
+    if (motion && dt > 0.0f)
+    {
+        float blend = 1.0f - expf(-dt / CAMERA_MOTION_SMOOTHING);
+        motion->velocity.x += (move.x / dt - motion->velocity.x) * blend;
+        motion->velocity.y += (move.y / dt - motion->velocity.y) * blend;
+        motion->zoomRate += ((camera->zoom - zoomStart) / dt - motion->zoomRate) * blend;
+    }
+}
+
+Rectangle camera_view_rect(const Camera2D* camera)
+{
+    float invZoom = 1.0f / (camera->zoom > 0.0f ? camera->zoom : 1.0f);
+    return (Rectangle){camera->target.x - camera->offset.x * invZoom, camera->target.y - camera->offset.y * invZoom, GetScreenWidth() * invZoom, GetScreenHeight() * invZoom};
+}
+
+Camera2D camera_predict(const Camera2D* camera, const CameraMotion* motion, float seconds)
+{
+    Camera2D predicted = *camera;
+    if (!motion || seconds <= 0.0f)
+        return predicted;
+
+    predicted.target = Vector2Add(camera->target, Vector2Scale(motion->velocity, seconds));
+    predicted.zoom   = fminf(fmaxf(camera->zoom + motion->zoomRate * seconds, ZOOM_MIN), ZOOM_MAX);
+    return predicted;
 }
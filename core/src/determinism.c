@@ -0,0 +1,595 @@
+/**
+ * @file determinism.c
+ * @brief Implements the headless replay and cross-thread-count hash comparison.
+ */
+
+#include "determinism.h"
+
+#include <inttypes.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "raylib.h"
+
+#include "app.h"
+#include "camera.h"
+#include "entity.h"
+#include "jobs.h"
+#include "map.h"
+#include "object.h"
+#include "state_hash.h"
+#include "tile.h"
+#include "tunables.h"
+#include "world_context.h"
+
+
+// -----------------------------------------------------------------------------
+// Headless world instance (kept static: the map and entity pool are large)
+// -----------------------------------------------------------------------------
+static WorldContext G_WORLD = {0};
+
+#define DETERMINISM_MAX_RUNS 4
+
+// -----------------------------------------------------------------------------
+// Thread control
+// -----------------------------------------------------------------------------
+
+static int determinism_hardware_threads(void)
+{
+    return jobs_hardware_threads();
+}
+
+static void determinism_apply_thread_count(int threads)
+{
+    jobs_init(threads > 0 ? threads : 1);
+}
+
+// -----------------------------------------------------------------------------
+// Trace I/O
+// -----------------------------------------------------------------------------
+
+static void trace_write(FILE* out, int tick, const StateHash* hash)
+{
+    fprintf(out, "%d", tick);
+    for (int i = 0; i < STATE_HASH_SECTION_COUNT; ++i)
+        fprintf(out, " %016" PRIx64, hash->sections[i]);
+    fputc('\n', out);
+}
+
+static bool trace_read(FILE* in, int* tick, StateHash* hash)
+{
+    if (fscanf(in, "%d", tick) != 1)
+        return false;
+    for (int i = 0; i < STATE_HASH_SECTION_COUNT; ++i)
+    {
+        if (fscanf(in, " %" SCNx64, &hash->sections[i]) != 1)
+            return false;
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Headless replay
+// -----------------------------------------------------------------------------
+
+/** Opens a hidden window (textures still need a GL context) and loads definitions. */
+static void headless_open(void)
+{
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(320, 240, "Containment Tycoon (headless)");
+
+    init_tile_types();
+    init_objects();
+    worldgen_load_definitions();
+    tunables_load(NULL);
+}
+
+/**
+ * @brief Rehashes the whole map and compares it with the incremental digest.
+ *
+ * A writer that forgot map_note_digest_change() leaves a stale chunk behind,
+ * which would hide a divergence in that chunk from the trace comparison.
+ */
+static bool verify_incremental_hash(WorldContext* world, const StateHash* incremental)
+{
+    StateHash full;
+    map_note_digest_change(&world->map, 0, 0, world->map.width, world->map.height, MAP_DIGEST_ALL);
+    state_hash_compute(&world->map, &world->entities, &full);
+
+    int section = state_hash_first_mismatch(incremental, &full);
+    if (section < 0)
+        return true;
+
+    printf("❌ Incremental %s hash missed an edit (%016" PRIx64 " != %016" PRIx64 ")\n",
+           state_hash_section_name((StateHashSection)section),
+           incremental->sections[section],
+           full.sections[section]);
+    return false;
+}
+
+static void headless_close(void)
+{
+    unload_tile_types();
+    unload_object_textures();
+    jobs_shutdown();
+    CloseWindow();
+}
+
+int determinism_run_trace(int threads, int ticks, const char* outputPath)
+{
+    if (!outputPath || ticks < 0)
+        return 1;
+
+    FILE* out = fopen(outputPath, "w");
+    if (!out)
+    {
+        printf("❌ Unable to open hash trace '%s'\n", outputPath);
+        return 1;
+    }
+
+    determinism_apply_thread_count(threads);
+    headless_open();
+
+    // Same generation and stepping as app_init/app_update.
+    world_context_init(&G_WORLD, APP_WORLD_SEED);
+
+    Camera2D  camera = init_camera();
+    StateHash hash;
+    state_hash_compute(&G_WORLD.map, &G_WORLD.entities, &hash);
+    trace_write(out, 0, &hash);
+
+    for (int tick = 1; tick <= ticks; ++tick)
+    {
+        world_context_step(&G_WORLD, &camera, NULL, DETERMINISM_TICK_SECONDS);
+        state_hash_compute(&G_WORLD.map, &G_WORLD.entities, &hash);
+        trace_write(out, tick, &hash);
+    }
+
+    fclose(out);
+
+    bool fresh = verify_incremental_hash(&G_WORLD, &hash);
+    world_context_shutdown(&G_WORLD);
+    headless_close();
+    return fresh ? 0 : 1;
+}
+
+/** One generated world of the sweep and the hash it reached. */
+typedef struct SweepWorld
+{
+    WorldContext* world;
+    int           ticks;
+    StateHash     hash;
+} SweepWorld;
+
+/** Steps a generated world with a still camera and hashes it; also the parallel thread entry. */
+static void* sweep_step_world(void* user)
+{
+    SweepWorld* run    = (SweepWorld*)user;
+    Camera2D    camera = init_camera();
+    for (int tick = 1; tick <= run->ticks; ++tick)
+        world_context_step(run->world, &camera, NULL, DETERMINISM_TICK_SECONDS);
+    state_hash_compute(&run->world->map, &run->world->entities, &run->hash);
+    return NULL;
+}
+
+/** Generates and runs one seed, returning the hash after the last tick. */
+static void sweep_run_seed(unsigned int seed, int ticks, StateHash* hash)
+{
+    SweepWorld run = {0};
+    run.world      = &G_WORLD;
+    run.ticks      = ticks;
+    world_context_init(&G_WORLD, seed);
+    sweep_step_world(&run);
+    *hash = run.hash;
+    world_context_shutdown(&G_WORLD);
+}
+
+/**
+ * @brief Steps every seed's world at the same time, one thread each.
+ *
+ * Generation and teardown stay on this thread (entity sprites need the GL
+ * context); only the ticks run concurrently. Each world must reach the hash
+ * its serial run did.
+ */
+static bool sweep_run_parallel(const StateHash* serial, int count, int ticks)
+{
+    SweepWorld* runs    = (SweepWorld*)calloc((size_t)count, sizeof(SweepWorld));
+    pthread_t*  threads = (pthread_t*)calloc((size_t)count, sizeof(pthread_t));
+    bool*       started = (bool*)calloc((size_t)count, sizeof(bool));
+    if (!runs || !threads || !started)
+    {
+        printf("❌ Out of memory for %d parallel worlds\n", count);
+        free(runs);
+        free(threads);
+        free(started);
+        return false;
+    }
+
+    bool ok = true;
+    for (int i = 0; i < count && ok; ++i)
+    {
+        runs[i].world = (WorldContext*)calloc(1, sizeof(WorldContext));
+        runs[i].ticks = ticks;
+        if (!runs[i].world)
+        {
+            printf("❌ Out of memory for parallel world %d\n", i);
+            ok = false;
+            break;
+        }
+        world_context_init(runs[i].world, (unsigned int)APP_WORLD_SEED + (unsigned int)i);
+    }
+
+    for (int i = 0; i < count && ok; ++i)
+        started[i] = pthread_create(&threads[i], NULL, sweep_step_world, &runs[i]) == 0;
+    for (int i = 0; i < count && ok; ++i)
+    {
+        if (started[i])
+            pthread_join(threads[i], NULL);
+        else
+            sweep_step_world(&runs[i]); // no thread to spare: still checks the world in isolation
+    }
+
+    for (int i = 0; i < count && ok; ++i)
+    {
+        int section = state_hash_first_mismatch(&serial[i], &runs[i].hash);
+        if (section >= 0)
+        {
+            printf("❌ Seed 0x%08X stepped in parallel diverged in %s: worlds share mutable state\n",
+                   (unsigned int)APP_WORLD_SEED + (unsigned int)i,
+                   state_hash_section_name((StateHashSection)section));
+            ok = false;
+        }
+    }
+    if (ok)
+        printf("✅ %d worlds stepped in parallel matched their serial hashes.\n", count);
+
+    for (int i = 0; i < count; ++i)
+    {
+        if (!runs[i].world)
+            continue;
+        world_context_shutdown(runs[i].world);
+        free(runs[i].world);
+    }
+    free(runs);
+    free(threads);
+    free(started);
+    return ok;
+}
+
+int determinism_run_seed_sweep(int count, int ticks)
+{
+    if (count <= 0 || ticks < 0)
+        return 1;
+
+    StateHash* hashes = (StateHash*)calloc((size_t)count, sizeof(StateHash));
+    if (!hashes)
+        return 1;
+
+    determinism_apply_thread_count(determinism_hardware_threads());
+    headless_open();
+
+    for (int i = 0; i < count; ++i)
+    {
+        unsigned int seed = (unsigned int)APP_WORLD_SEED + (unsigned int)i;
+        sweep_run_seed(seed, ticks, &hashes[i]);
+
+        printf("🌱 seed 0x%08X after %d ticks:", seed, ticks);
+        for (int s = 0; s < STATE_HASH_SECTION_COUNT; ++s)
+            printf(" %016" PRIx64, hashes[i].sections[s]);
+        printf("\n");
+        fflush(stdout);
+    }
+
+    // Replaying the first seed must not see anything the later worlds left behind.
+    bool ok = true;
+    if (count > 1)
+    {
+        StateHash again;
+        sweep_run_seed((unsigned int)APP_WORLD_SEED, ticks, &again);
+        int section = state_hash_first_mismatch(&hashes[0], &again);
+        if (section >= 0)
+        {
+            printf("❌ Replaying seed 0x%08X diverged in %s: world state leaked between contexts\n",
+                   (unsigned int)APP_WORLD_SEED,
+                   state_hash_section_name((StateHashSection)section));
+            ok = false;
+        }
+        else
+            printf("✅ Seed 0x%08X replayed identically after %d other world(s).\n", (unsigned int)APP_WORLD_SEED, count - 1);
+
+        // The same worlds live side by side must not see each other either.
+        ok &= sweep_run_parallel(hashes, count, ticks);
+    }
+
+    free(hashes);
+    headless_close();
+    return ok ? 0 : 1;
+}
+
+// -----------------------------------------------------------------------------
+// Hibernation round trip
+// -----------------------------------------------------------------------------
+
+/** Picks a streamed cannibal child: it can grow up and may have an elder form. */
+static int hibernate_pick_record(const EntitySystem* sys)
+{
+    for (int i = 0; i < sys->reservationCount; ++i)
+    {
+        const EntityReservation* res = &sys->reservations[i];
+        if (res->used && res->typeId == ENTITY_TYPE_CANNIBAL_CHILD)
+            return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Promotes @p e to a different form.
+ *
+ * Uses the elder promotion when the definitions pair the type with an elder
+ * form, otherwise grows the child up the way the cannibal behaviour does.
+ */
+static bool hibernate_promote(EntitySystem* sys, Entity* e)
+{
+    const EntityType* original = e->type;
+    entity_promote_to_elder(e);
+    if (e->type != original)
+        return true;
+
+    const EntityType* adult = entity_find_type(sys, ENTITY_TYPE_CANNIBAL);
+    if (!adult)
+        return false;
+    e->type = adult;
+    e->hp   = adult->maxHP;
+    entity_set_behavior(e, adult->behavior);
+    if (e->behavior && e->behavior->onDespawn)
+        e->behavior->onDespawn(sys, e);
+    if (e->behavior && e->behavior->onSpawn)
+        e->behavior->onSpawn(sys, e);
+    return true;
+}
+
+/** Moves the stream focus and runs one entity update. */
+static void hibernate_step_at(WorldContext* world, Vector2 focus)
+{
+    Camera2D camera = init_camera();
+    camera.target   = focus;
+    entity_system_update(&world->entities, &world->map, &world->time, &camera, NULL, DETERMINISM_TICK_SECONDS);
+}
+
+int determinism_run_hibernate_check(void)
+{
+    determinism_apply_thread_count(1);
+    headless_open();
+    world_context_init(&G_WORLD, APP_WORLD_SEED);
+
+    EntitySystem* sys    = &G_WORLD.entities;
+    Camera2D      camera = init_camera();
+    for (int tick = 1; tick <= 60; ++tick)
+        world_context_step(&G_WORLD, &camera, NULL, DETERMINISM_TICK_SECONDS);
+
+    // Bring a promotable record into view so it is resident.
+    int     index = hibernate_pick_record(sys);
+    Entity* e     = NULL;
+    if (index >= 0)
+    {
+        const EntityReservation* res = &sys->reservations[index];
+        if (!res->active)
+            hibernate_step_at(&G_WORLD, res->position);
+        e = res->active ? entity_acquire(sys, res->entityId) : NULL;
+    }
+
+    bool ok = e && hibernate_promote(sys, e);
+    if (!ok)
+        printf("❌ No streamed cannibal child to promote and hibernate\n");
+
+    if (ok)
+    {
+        // Give the promoted resident state no freshly spawned entity would have.
+        e->ageDays += 3.25f;
+        e->hunger   = 37.5f;
+
+        const Entity before = *e;
+        const float  far    = (float)(MAP_WIDTH * TILE_SIZE);
+        Vector2      away   = {before.position.x < far * 0.5f ? far : 0.0f, before.position.y < far * 0.5f ? far : 0.0f};
+
+        hibernate_step_at(&G_WORLD, away);
+        const EntityReservation* res = &sys->reservations[index];
+        if (res->active)
+        {
+            printf("❌ Resident %u did not hibernate\n", before.id);
+            ok = false;
+        }
+        else if (res->typeId != before.type->id || res->isElder != before.isElder || res->ageDays != before.ageDays ||
+                 res->hunger != before.hunger || res->sex != before.sex ||
+                 memcmp(res->brain, before.brain, sizeof(res->brain)) != 0)
+        {
+            printf("❌ Hibernation record lost the promoted state of resident %u\n", before.id);
+            ok = false;
+        }
+
+        hibernate_step_at(&G_WORLD, before.position);
+        const Entity* woken = res->active ? entity_get(sys, res->entityId) : NULL;
+        if (ok && !woken)
+        {
+            printf("❌ Hibernated resident did not wake\n");
+            ok = false;
+        }
+        else if (ok && (woken->type != before.type || woken->behavior != before.behavior || woken->isElder != before.isElder ||
+                        fabsf(woken->ageDays - before.ageDays) > 0.01f || fabsf(woken->hunger - before.hunger) > 1.0f))
+        {
+            printf("❌ Woken resident came back as type %d (elder %d, age %.2f, hunger %.1f), expected type %d (age %.2f, hunger %.1f)\n",
+                   woken->type ? (int)woken->type->id : -1,
+                   (int)woken->isElder,
+                   woken->ageDays,
+                   woken->hunger,
+                   (int)before.type->id,
+                   before.ageDays,
+                   before.hunger);
+            ok = false;
+        }
+
+        if (ok)
+            printf("✅ Promoted resident (type %d, elder %d) hibernated and woke with its state.\n", (int)before.type->id, (int)before.isElder);
+    }
+
+    world_context_shutdown(&G_WORLD);
+    headless_close();
+    return ok ? 0 : 1;
+}
+
+// -----------------------------------------------------------------------------
+// Cross-run comparison
+// -----------------------------------------------------------------------------
+
+static int build_thread_list(int* out, int capacity)
+{
+    const int candidates[DETERMINISM_MAX_RUNS] = {1, 2, 4, determinism_hardware_threads()};
+    int       count                            = 0;
+    for (int i = 0; i < DETERMINISM_MAX_RUNS && count < capacity; ++i)
+    {
+        int  threads   = candidates[i] > 0 ? candidates[i] : 1;
+        bool duplicate = false;
+        for (int j = 0; j < count; ++j)
+            duplicate |= (out[j] == threads);
+        if (!duplicate)
+            out[count++] = threads;
+    }
+    return count;
+}
+
+/**
+ * @brief Compares a trace against the reference and prints the first divergence.
+ *
+ * @return true when both traces are identical.
+ */
+static bool compare_traces(const char* referencePath, const char* candidatePath, int threads, int ticks)
+{
+    FILE* ref  = fopen(referencePath, "r");
+    FILE* cand = fopen(candidatePath, "r");
+    if (!ref || !cand)
+    {
+        printf("❌ [%d threads] missing trace output\n", threads);
+        if (ref)
+            fclose(ref);
+        if (cand)
+            fclose(cand);
+        return false;
+    }
+
+    bool identical = true;
+    for (int expected = 0; expected <= ticks; ++expected)
+    {
+        int       tickA = -1, tickB = -1;
+        StateHash a, b;
+        bool      okA = trace_read(ref, &tickA, &a);
+        bool      okB = trace_read(cand, &tickB, &b);
+        if (!okA || !okB || tickA != expected || tickB != expected)
+        {
+            printf("❌ [%d threads] trace ended early at tick %d\n", threads, expected);
+            identical = false;
+            break;
+        }
+
+        int section = state_hash_first_mismatch(&a, &b);
+        if (section >= 0)
+        {
+            printf("❌ [%d threads] diverged at tick %d in %s (%016" PRIx64 " != %016" PRIx64 ")\n",
+                   threads,
+                   expected,
+                   state_hash_section_name((StateHashSection)section),
+                   a.sections[section],
+                   b.sections[section]);
+            identical = false;
+            break;
+        }
+    }
+
+    if (identical)
+        printf("✅ [%d threads] identical over %d ticks\n", threads, ticks);
+
+    fclose(ref);
+    fclose(cand);
+    return identical;
+}
+
+int determinism_run_check(const char* executable, int ticks)
+{
+    if (!executable || ticks < 0)
+        return 1;
+
+    int threadCounts[DETERMINISM_MAX_RUNS];
+    int runCount = build_thread_list(threadCounts, DETERMINISM_MAX_RUNS);
+
+    char paths[DETERMINISM_MAX_RUNS][64];
+    bool ok = true;
+    for (int i = 0; i < runCount; ++i)
+    {
+        snprintf(paths[i], sizeof(paths[i]), "determinism_t%d.hash", threadCounts[i]);
+
+        char command[1024];
+        snprintf(command, sizeof(command), "\"%s\" --hash-trace %d %d %s", executable, threadCounts[i], ticks, paths[i]);
+        printf("▶️  Replaying seed 0x%08X with %d thread(s)...\n", (unsigned int)APP_WORLD_SEED, threadCounts[i]);
+        fflush(stdout);
+        if (system(command) != 0)
+        {
+            printf("❌ [%d threads] replay failed\n", threadCounts[i]);
+            ok = false;
+        }
+    }
+
+    if (ok)
+    {
+        for (int i = 1; i < runCount; ++i)
+            ok &= compare_traces(paths[0], paths[i], threadCounts[i], ticks);
+    }
+
+    for (int i = 0; i < runCount; ++i)
+        remove(paths[i]);
+
+    printf(ok ? "✅ Simulation is deterministic across thread counts.\n" : "❌ Determinism check failed.\n");
+    return ok ? 0 : 1;
+}
+
+bool determinism_handle_command_line(int argc, char** argv, int* exitCode)
+{
+    if (argc < 2 || !argv || !exitCode)
+        return false;
+
+    if (strcmp(argv[1], "--determinism-check") == 0)
+    {
+        int ticks = (argc > 2) ? atoi(argv[2]) : DETERMINISM_DEFAULT_TICKS;
+        *exitCode = determinism_run_check(argv[0], ticks);
+        return true;
+    }
+
+    if (strcmp(argv[1], "--hash-trace") == 0)
+    {
+        if (argc < 5)
+        {
+            printf("Usage: %s --hash-trace <threads> <ticks> <output-file>\n", argv[0]);
+            *exitCode = 1;
+            return true;
+        }
+        *exitCode = determinism_run_trace(atoi(argv[2]), atoi(argv[3]), argv[4]);
+        return true;
+    }
+
+    if (strcmp(argv[1], "--seed-sweep") == 0)
+    {
+        int count = (argc > 2) ? atoi(argv[2]) : DETERMINISM_SWEEP_DEFAULT_SEEDS;
+        int ticks = (argc > 3) ? atoi(argv[3]) : DETERMINISM_DEFAULT_TICKS;
+        *exitCode = determinism_run_seed_sweep(count, ticks);
+        return true;
+    }
+
+    if (strcmp(argv[1], "--hibernate-check") == 0)
+    {
+        *exitCode = determinism_run_hibernate_check();
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file frame_budget.c
+ * @brief Implements the frame-time governor and its deferrable task table.
+ */
+
+#include "frame_budget.h"
+
+#include "raylib.h"
+
+#include "tunables.h"
+
+/** Weight of the newest frame in the smoothed CPU time. */
+#define FRAME_BUDGET_SMOOTHING 0.15f
+/** Ratio margin required before dropping back to a lighter load level. */
+#define FRAME_BUDGET_HYSTERESIS 0.1f
+#define FRAME_BUDGET_LEVEL_COUNT 4
+
+typedef struct FrameTaskDef
+{
+    const char*   name;
+    FramePriority priority;
+    int           maxDeferrals; /**< Refusals in a row before the task is forced through. */
+} FrameTaskDef;
+
+typedef struct FrameTaskSlot
+{
+    int      deferrals;
+    unsigned thinCounter;
+} FrameTaskSlot;
+
+typedef struct FrameBudgetState
+{
+    bool          enabled;
+    double        frameStart;
+    float         averageMs;
+    int           level;
+    int           deferredThisFrame;
+    int           deferredLastFrame;
+    FrameTaskSlot tasks[FRAME_TASK_COUNT];
+} FrameBudgetState;
+
+// -----------------------------------------------------------------------------
+// Tables (keep in sync with FrameTask)
+// -----------------------------------------------------------------------------
+static const FrameTaskDef G_TASK_DEFS[FRAME_TASK_COUNT] = {
+    [FRAME_TASK_CHUNK_PREWARM]      = {"chunk_prewarm", FRAME_PRIORITY_LOW, 30},
+    [FRAME_TASK_BUILDING_DETECTION] = {"building_detection", FRAME_PRIORITY_NORMAL, 20},
+    [FRAME_TASK_RESIDENT_REFRESH]   = {"resident_refresh", FRAME_PRIORITY_NORMAL, 120},
+    [FRAME_TASK_REPATH]             = {"repath", FRAME_PRIORITY_NORMAL, 0},
+    [FRAME_TASK_LABEL_DETAILS]      = {"label_details", FRAME_PRIORITY_LOW, 0},
+};
+
+/** Load ratio (average / budget) needed to enter each level. */
+static const float G_LEVEL_ENTER[FRAME_BUDGET_LEVEL_COUNT] = {0.0f, 0.85f, 1.0f, 1.2f};
+
+static const FrameTaskState G_LEVEL_STATES[FRAME_BUDGET_LEVEL_COUNT][FRAME_PRIORITY_COUNT] = {
+    {FRAME_TASK_RUN, FRAME_TASK_RUN, FRAME_TASK_RUN},
+    {FRAME_TASK_RUN, FRAME_TASK_RUN, FRAME_TASK_THIN},
+    {FRAME_TASK_RUN, FRAME_TASK_THIN, FRAME_TASK_DEFER},
+    {FRAME_TASK_THIN, FRAME_TASK_DEFER, FRAME_TASK_DEFER},
+};
+
+static FrameBudgetState G_BUDGET = {0};
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+
+static float budget_ms(void)
+{
+    return tunable_get(TUNABLE_FRAME_BUDGET_MS);
+}
+
+static float elapsed_ms(void)
+{
+    return (float)((GetTime() - G_BUDGET.frameStart) * 1000.0);
+}
+
+static void update_level(void)
+{
+    float ratio = G_BUDGET.averageMs / budget_ms();
+    while (G_BUDGET.level < FRAME_BUDGET_LEVEL_COUNT - 1 && ratio >= G_LEVEL_ENTER[G_BUDGET.level + 1])
+        G_BUDGET.level++;
+    while (G_BUDGET.level > 0 && ratio < G_LEVEL_ENTER[G_BUDGET.level] - FRAME_BUDGET_HYSTERESIS)
+        G_BUDGET.level--;
+}
+
+// -----------------------------------------------------------------------------
+// Public API
+// -----------------------------------------------------------------------------
+
+void frame_budget_init(void)
+{
+    G_BUDGET         = (FrameBudgetState){0};
+    G_BUDGET.enabled = true;
+}
+
+void frame_budget_begin_frame(void)
+{
+    if (!G_BUDGET.enabled)
+        return;
+    G_BUDGET.frameStart        = GetTime();
+    G_BUDGET.deferredLastFrame = G_BUDGET.deferredThisFrame;
+    G_BUDGET.deferredThisFrame = 0;
+    update_level();
+}
+
+void frame_budget_end_frame(void)
+{
+    if (!G_BUDGET.enabled)
+        return;
+    G_BUDGET.averageMs += (elapsed_ms() - G_BUDGET.averageMs) * FRAME_BUDGET_SMOOTHING;
+}
+
+FrameTaskState frame_budget_task_state(FrameTask task)
+{
+    if (!G_BUDGET.enabled || task < 0 || task >= FRAME_TASK_COUNT)
+        return FRAME_TASK_RUN;
+    return G_LEVEL_STATES[G_BUDGET.level][G_TASK_DEFS[task].priority];
+}
+
+bool frame_budget_allow(FrameTask task)
+{
+    if (!G_BUDGET.enabled || task < 0 || task >= FRAME_TASK_COUNT)
+        return true;
+
+    const FrameTaskDef* def   = &G_TASK_DEFS[task];
+    FrameTaskSlot*      slot  = &G_BUDGET.tasks[task];
+    FrameTaskState      state = frame_budget_task_state(task);
+
+    // Work requested after the frame already overran waits for the next one.
+    if (state == FRAME_TASK_RUN && def->priority != FRAME_PRIORITY_HIGH && elapsed_ms() > budget_ms())
+        state = FRAME_TASK_DEFER;
+
+    bool run = true;
+    if (state == FRAME_TASK_THIN)
+        run = (slot->thinCounter++ & 1u) == 0u;
+    else if (state == FRAME_TASK_DEFER)
+        run = false;
+
+    if (!run && slot->deferrals >= def->maxDeferrals)
+        run = true;
+
+    if (run)
+        slot->deferrals = 0;
+    else
+    {
+        slot->deferrals++;
+        G_BUDGET.deferredThisFrame++;
+    }
+    return run;
+}
+
+float frame_budget_interval_scale(FrameTask task)
+{
+    switch (frame_budget_task_state(task))
+    {
+        case FRAME_TASK_THIN:
+            return 2.0f;
+        case FRAME_TASK_DEFER:
+            return 4.0f;
+        default:
+            return 1.0f;
+    }
+}
+
+int frame_budget_load_level(void)
+{
+    return G_BUDGET.level;
+}
+
+float frame_budget_average_ms(void)
+{
+    return G_BUDGET.averageMs;
+}
+
+int frame_budget_deferred_last_frame(void)
+{
+    return G_BUDGET.deferredLastFrame;
+}
@@ -0,0 +1,454 @@
+/**
+ * @file jobs.c
+ * @brief Implements the pthread worker pool with work-stealing deques.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "jobs.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/** Jobs per deque; a full deque makes the submitter run the job inline. */
+#define JOBS_DEQUE_CAPACITY 1024u
+#define JOBS_DEQUE_MASK (JOBS_DEQUE_CAPACITY - 1u)
+/** Upper bound on the chunks created by one parallel-for. */
+#define JOBS_MAX_RANGE_CHUNKS 256
+/** Failed find attempts before an idle worker goes to sleep. */
+#define JOBS_IDLE_SPINS 64
+
+typedef struct Job
+{
+    JobFn     fn;
+    void*     user;
+    JobGroup* group;
+} Job;
+
+typedef struct JobDeque
+{
+    pthread_mutex_t lock;
+    Job             items[JOBS_DEQUE_CAPACITY];
+    unsigned        top;    /**< Steal end (oldest job). */
+    unsigned        bottom; /**< Owner end (newest job). */
+} JobDeque;
+
+typedef struct JobWorker
+{
+    pthread_t thread;
+    int       index;
+    JobDeque  deque;
+    uint64_t  busyNs;  /**< Updated atomically by the owner. */
+    uint32_t  jobsRun; /**< Updated atomically by the owner. */
+    uint32_t  steals;  /**< Updated atomically by the owner. */
+} JobWorker;
+
+typedef struct JobsState
+{
+    bool            running;
+    volatile int    stopping;
+    int             threadCount;
+    JobWorker       workers[JOBS_MAX_THREADS];
+    pthread_key_t   slotKey;
+    pthread_mutex_t sleepLock;
+    pthread_cond_t  wake;
+    volatile int    queued; /**< Jobs sitting in deques. */
+
+    uint64_t       frameStartNs;
+    uint64_t       lastBusyNs[JOBS_MAX_THREADS];
+    uint32_t       lastJobsRun[JOBS_MAX_THREADS];
+    uint32_t       lastSteals[JOBS_MAX_THREADS];
+    JobsFrameStats lastFrame;
+} JobsState;
+
+typedef struct RangeChunk
+{
+    JobRangeFn fn;
+    void*      user;
+    int        begin;
+    int        end;
+} RangeChunk;
+
+static JobsState G_JOBS = {0};
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int current_slot(void)
+{
+    if (!G_JOBS.running)
+        return 0;
+    void* value = pthread_getspecific(G_JOBS.slotKey);
+    // Unknown threads share the caller's deque; every deque access is locked.
+    return value ? (int)((intptr_t)value - 1) : 0;
+}
+
+static bool deque_push(JobDeque* dq, const Job* job)
+{
+    bool ok = false;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->bottom - dq->top < JOBS_DEQUE_CAPACITY)
+    {
+        dq->items[dq->bottom & JOBS_DEQUE_MASK] = *job;
+        dq->bottom++;
+        ok = true;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return ok;
+}
+
+static bool deque_pop(JobDeque* dq, Job* out)
+{
+    bool ok = false;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->bottom != dq->top)
+    {
+        dq->bottom--;
+        *out = dq->items[dq->bottom & JOBS_DEQUE_MASK];
+        ok   = true;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return ok;
+}
+
+static bool deque_steal(JobDeque* dq, Job* out)
+{
+    bool ok = false;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->bottom != dq->top)
+    {
+        *out = dq->items[dq->top & JOBS_DEQUE_MASK];
+        dq->top++;
+        ok = true;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return ok;
+}
+
+static bool find_job(int slot, Job* out)
+{
+    JobWorker* self = &G_JOBS.workers[slot];
+    if (deque_pop(&self->deque, out))
+    {
+        __atomic_sub_fetch(&G_JOBS.queued, 1, __ATOMIC_ACQ_REL);
+        return true;
+    }
+
+    for (int i = 1; i < G_JOBS.threadCount; ++i)
+    {
+        int victim = (slot + i) % G_JOBS.threadCount;
+        if (deque_steal(&G_JOBS.workers[victim].deque, out))
+        {
+            __atomic_sub_fetch(&G_JOBS.queued, 1, __ATOMIC_ACQ_REL);
+            __atomic_add_fetch(&self->steals, 1u, __ATOMIC_RELAXED);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void wake_workers(void)
+{
+    pthread_mutex_lock(&G_JOBS.sleepLock);
+    pthread_cond_signal(&G_JOBS.wake);
+    pthread_mutex_unlock(&G_JOBS.sleepLock);
+}
+
+static void run_job(const Job* job);
+
+/** Queues a job whose group has already been counted. */
+static void enqueue(const Job* job)
+{
+    if (!G_JOBS.running || G_JOBS.threadCount <= 1)
+    {
+        run_job(job);
+        return;
+    }
+
+    int slot = current_slot();
+    if (!deque_push(&G_JOBS.workers[slot].deque, job))
+    {
+        run_job(job);
+        return;
+    }
+    __atomic_add_fetch(&G_JOBS.queued, 1, __ATOMIC_ACQ_REL);
+    wake_workers();
+}
+
+static void complete_group(JobGroup* group)
+{
+    if (!group)
+        return;
+
+    // Once pending hits zero jobs_wait may return and the group (often on the
+    // waiter's stack) is gone, so the continuation is copied out beforehand.
+    Job next = {group->thenFn, group->thenUser, group->thenGroup};
+    if (__atomic_sub_fetch(&group->pending, 1, __ATOMIC_ACQ_REL) != 0)
+        return;
+    if (next.fn)
+        enqueue(&next);
+}
+
+static void run_job(const Job* job)
+{
+    int        slot  = current_slot();
+    JobWorker* self  = &G_JOBS.workers[slot];
+    uint64_t   start = now_ns();
+
+    job->fn(job->user);
+
+    __atomic_add_fetch(&self->busyNs, now_ns() - start, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&self->jobsRun, 1u, __ATOMIC_RELAXED);
+    complete_group(job->group);
+}
+
+static void* worker_main(void* arg)
+{
+    JobWorker* self = (JobWorker*)arg;
+    pthread_setspecific(G_JOBS.slotKey, (void*)(intptr_t)(self->index + 1));
+
+    int idle = 0;
+    while (!__atomic_load_n(&G_JOBS.stopping, __ATOMIC_ACQUIRE))
+    {
+        Job job;
+        if (find_job(self->index, &job))
+        {
+            run_job(&job);
+            idle = 0;
+            continue;
+        }
+
+        if (++idle < JOBS_IDLE_SPINS)
+        {
+            sched_yield();
+            continue;
+        }
+
+        pthread_mutex_lock(&G_JOBS.sleepLock);
+        while (!__atomic_load_n(&G_JOBS.stopping, __ATOMIC_ACQUIRE) && __atomic_load_n(&G_JOBS.queued, __ATOMIC_ACQUIRE) == 0)
+            pthread_cond_wait(&G_JOBS.wake, &G_JOBS.sleepLock);
+        pthread_mutex_unlock(&G_JOBS.sleepLock);
+        idle = 0;
+    }
+    return NULL;
+}
+
+static void run_range_chunk(void* user)
+{
+    const RangeChunk* chunk = (const RangeChunk*)user;
+    chunk->fn(chunk->user, chunk->begin, chunk->end);
+}
+
+// -----------------------------------------------------------------------------
+// Public API
+// -----------------------------------------------------------------------------
+
+int jobs_hardware_threads(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+void jobs_init(int threadCount)
+{
+    if (G_JOBS.running)
+        jobs_shutdown();
+
+    if (threadCount <= 0)
+        threadCount = jobs_hardware_threads();
+    if (threadCount > JOBS_MAX_THREADS)
+        threadCount = JOBS_MAX_THREADS;
+
+    memset(&G_JOBS, 0, sizeof(G_JOBS));
+    G_JOBS.threadCount = threadCount;
+    pthread_key_create(&G_JOBS.slotKey, NULL);
+    pthread_mutex_init(&G_JOBS.sleepLock, NULL);
+    pthread_cond_init(&G_JOBS.wake, NULL);
+    for (int i = 0; i < threadCount; ++i)
+    {
+        G_JOBS.workers[i].index = i;
+        pthread_mutex_init(&G_JOBS.workers[i].deque.lock, NULL);
+    }
+
+    // Slot 0 is the calling thread.
+    pthread_setspecific(G_JOBS.slotKey, (void*)(intptr_t)1);
+    G_JOBS.running = true;
+
+    for (int i = 1; i < threadCount; ++i)
+    {
+        if (pthread_create(&G_JOBS.workers[i].thread, NULL, worker_main, &G_JOBS.workers[i]) != 0)
+        {
+            printf("⚠️ Job system: could only start %d of %d threads\n", i, threadCount);
+            G_JOBS.threadCount = i;
+            break;
+        }
+    }
+
+    G_JOBS.frameStartNs          = now_ns();
+    G_JOBS.lastFrame.threadCount = G_JOBS.threadCount;
+}
+
+void jobs_shutdown(void)
+{
+    if (!G_JOBS.running)
+        return;
+
+    // Drain whatever is still queued before stopping the workers.
+    Job job;
+    while (find_job(0, &job))
+        run_job(&job);
+
+    __atomic_store_n(&G_JOBS.stopping, 1, __ATOMIC_RELEASE);
+    pthread_mutex_lock(&G_JOBS.sleepLock);
+    pthread_cond_broadcast(&G_JOBS.wake);
+    pthread_mutex_unlock(&G_JOBS.sleepLock);
+
+    for (int i = 1; i < G_JOBS.threadCount; ++i)
+        pthread_join(G_JOBS.workers[i].thread, NULL);
+
+    for (int i = 0; i < G_JOBS.threadCount; ++i)
+        pthread_mutex_destroy(&G_JOBS.workers[i].deque.lock);
+    pthread_cond_destroy(&G_JOBS.wake);
+    pthread_mutex_destroy(&G_JOBS.sleepLock);
+    pthread_key_delete(G_JOBS.slotKey);
+    G_JOBS.running     = false;
+    G_JOBS.threadCount = 0;
+}
+
+int jobs_thread_count(void)
+{
+    return G_JOBS.running ? G_JOBS.threadCount : 1;
+}
+
+void jobs_group_init(JobGroup* group)
+{
+    if (!group)
+        return;
+    group->pending   = 0;
+    group->thenFn    = NULL;
+    group->thenUser  = NULL;
+    group->thenGroup = NULL;
+}
+
+void jobs_group_then(JobGroup* group, JobFn fn, void* user, JobGroup* target)
+{
+    if (!group || !fn)
+        return;
+    group->thenFn    = fn;
+    group->thenUser  = user;
+    group->thenGroup = target;
+    if (target)
+        __atomic_add_fetch(&target->pending, 1, __ATOMIC_ACQ_REL);
+}
+
+void jobs_submit(JobGroup* group, JobFn fn, void* user)
+{
+    if (!fn)
+        return;
+    if (group)
+        __atomic_add_fetch(&group->pending, 1, __ATOMIC_ACQ_REL);
+    Job job = {fn, user, group};
+    enqueue(&job);
+}
+
+void jobs_wait(JobGroup* group)
+{
+    if (!group)
+        return;
+
+    int slot = current_slot();
+    while (__atomic_load_n(&group->pending, __ATOMIC_ACQUIRE) > 0)
+    {
+        Job job;
+        if (G_JOBS.running && find_job(slot, &job))
+            run_job(&job);
+        else
+            sched_yield();
+    }
+}
+
+void jobs_parallel_for(int count, int grain, JobRangeFn fn, void* user)
+{
+    if (!fn || count <= 0)
+        return;
+    if (grain < 1)
+        grain = 1;
+
+    int chunkCount = (count + grain - 1) / grain;
+    if (chunkCount > JOBS_MAX_RANGE_CHUNKS)
+        chunkCount = JOBS_MAX_RANGE_CHUNKS;
+
+    if (!G_JOBS.running || G_JOBS.threadCount <= 1 || chunkCount <= 1)
+    {
+        fn(user, 0, count);
+        return;
+    }
+
+    RangeChunk chunks[JOBS_MAX_RANGE_CHUNKS];
+    JobGroup   group;
+    jobs_group_init(&group);
+
+    int chunkSize = (count + chunkCount - 1) / chunkCount;
+    int used      = 0;
+    for (int begin = 0; begin < count; begin += chunkSize)
+    {
+        int end        = begin + chunkSize < count ? begin + chunkSize : count;
+        chunks[used++] = (RangeChunk){fn, user, begin, end};
+    }
+
+    // Queue all but the first chunk, then run the first one here.
+    for (int i = 1; i < used; ++i)
+        jobs_submit(&group, run_range_chunk, &chunks[i]);
+    run_range_chunk(&chunks[0]);
+    jobs_wait(&group);
+}
+
+void jobs_frame_begin(void)
+{
+    uint64_t now     = now_ns();
+    uint64_t wallNs  = now - G_JOBS.frameStartNs;
+    int      threads = jobs_thread_count();
+
+    JobsFrameStats stats = {0};
+    stats.threadCount    = threads;
+    stats.wallMs         = (float)((double)wallNs / 1e6);
+
+    double busyTotal = 0.0;
+    for (int i = 0; i < threads; ++i)
+    {
+        uint64_t busy = __atomic_load_n(&G_JOBS.workers[i].busyNs, __ATOMIC_RELAXED);
+        uint32_t runs = __atomic_load_n(&G_JOBS.workers[i].jobsRun, __ATOMIC_RELAXED);
+        uint32_t taken = __atomic_load_n(&G_JOBS.workers[i].steals, __ATOMIC_RELAXED);
+
+        stats.busyMs[i] = (float)((double)(busy - G_JOBS.lastBusyNs[i]) / 1e6);
+        stats.jobsRun += runs - G_JOBS.lastJobsRun[i];
+        stats.steals += taken - G_JOBS.lastSteals[i];
+        busyTotal += stats.busyMs[i];
+
+        G_JOBS.lastBusyNs[i]  = busy;
+        G_JOBS.lastJobsRun[i] = runs;
+        G_JOBS.lastSteals[i]  = taken;
+    }
+    if (stats.wallMs > 0.0f && threads > 0)
+        stats.utilization = (float)(busyTotal / ((double)stats.wallMs * threads));
+
+    G_JOBS.lastFrame    = stats;
+    G_JOBS.frameStartNs = now;
+}
+
+const JobsFrameStats* jobs_last_frame_stats(void)
+{
+    return &G_JOBS.lastFrame;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file profiler.c
+ * @brief Implements frame section timing, counters and the profiler readout.
+ */
+
+#include "profiler.h"
+
+#include <stdio.h>
+#include "raylib.h"
+
+#include "jobs.h"
+#include "ui_theme.h"
+
+/** Weight of the newest frame in the moving averages. */
+#define PROFILER_SMOOTHING 0.1f
+
+typedef struct ProfilerState
+{
+    double start[PROFILER_SECTION_COUNT];
+    float  frameMs[PROFILER_SECTION_COUNT];
+    float  lastMs[PROFILER_SECTION_COUNT];
+    float  averageMs[PROFILER_SECTION_COUNT];
+    int    frameCounts[PROFILER_COUNTER_COUNT];
+    float  averageCounts[PROFILER_COUNTER_COUNT];
+    bool   primed;
+} ProfilerState;
+
+static ProfilerState G_PROFILER = {0};
+
+// Only the thread running the frame loop records, so worlds stepped on other
+// threads (headless tools, pool workers) never write to the readout.
+static JOBS_THREAD_LOCAL bool G_FRAME_THREAD = false;
+
+static const char* G_COUNTER_NAMES[PROFILER_COUNTER_COUNT] = {
+    "chunk rebuilds",
+    "path queries",
+};
+
+void profiler_frame_begin(void)
+{
+    G_FRAME_THREAD = true;
+    for (int i = 0; i < PROFILER_SECTION_COUNT; ++i)
+        G_PROFILER.frameMs[i] = 0.0f;
+    for (int i = 0; i < PROFILER_COUNTER_COUNT; ++i)
+        G_PROFILER.frameCounts[i] = 0;
+    profiler_begin(PROFILER_FRAME);
+}
+
+void profiler_frame_end(void)
+{
+    if (!G_FRAME_THREAD)
+        return;
+    profiler_end(PROFILER_FRAME);
+
+    float alpha = G_PROFILER.primed ? PROFILER_SMOOTHING : 1.0f;
+    for (int i = 0; i < PROFILER_SECTION_COUNT; ++i)
+    {
+        G_PROFILER.lastMs[i] = G_PROFILER.frameMs[i];
+        G_PROFILER.averageMs[i] += (G_PROFILER.frameMs[i] - G_PROFILER.averageMs[i]) * alpha;
+    }
+    for (int i = 0; i < PROFILER_COUNTER_COUNT; ++i)
+        G_PROFILER.averageCounts[i] += ((float)G_PROFILER.frameCounts[i] - G_PROFILER.averageCounts[i]) * alpha;
+    G_PROFILER.primed = true;
+}
+
+void profiler_begin(ProfilerSection section)
+{
+    if (!G_FRAME_THREAD || section < 0 || section >= PROFILER_SECTION_COUNT)
+        return;
+    G_PROFILER.start[section] = GetTime();
+}
+
+void profiler_end(ProfilerSection section)
+{
+    if (!G_FRAME_THREAD || section < 0 || section >= PROFILER_SECTION_COUNT)
+        return;
+    G_PROFILER.frameMs[section] += (float)((GetTime() - G_PROFILER.start[section]) * 1000.0);
+}
+
+void profiler_count(ProfilerCounter counter, int amount)
+{
+    if (!G_FRAME_THREAD || counter < 0 || counter >= PROFILER_COUNTER_COUNT)
+        return;
+    G_PROFILER.frameCounts[counter] += amount;
+}
+
+float profiler_average_ms(ProfilerSection section)
+{
+    if (section < 0 || section >= PROFILER_SECTION_COUNT)
+        return 0.0f;
+    return G_PROFILER.averageMs[section];
+}
+
+float profiler_last_ms(ProfilerSection section)
+{
+    if (section < 0 || section >= PROFILER_SECTION_COUNT)
+        return 0.0f;
+    return G_PROFILER.lastMs[section];
+}
+
+float profiler_average_count(ProfilerCounter counter)
+{
+    if (counter < 0 || counter >= PROFILER_COUNTER_COUNT)
+        return 0.0f;
+    return G_PROFILER.averageCounts[counter];
+}
+
+const char* profiler_section_name(ProfilerSection section)
+{
+    switch (section)
+    {
+        case PROFILER_FRAME:
+            return "frame";
+        case PROFILER_SIMULATION:
+            return "simulation";
+        case PROFILER_ENTITIES:
+            return "entities";
+        case PROFILER_OBJECTS:
+            return "objects";
+        case PROFILER_BUILDINGS:
+            return "buildings";
+        case PROFILER_CHUNKS:
+            return "chunks";
+        case PROFILER_DRAW:
+            return "draw";
+        default:
+            return "unknown";
+    }
+}
+
+int profiler_draw(int x, int y, int fontSize)
+{
+    const UiTheme* ui        = ui_theme_get();
+    Color          primary   = ui ? ui->textPrimary : WHITE;
+    Color          secondary = ui ? ui->textSecondary : ColorAlpha(WHITE, 0.85f);
+    int            lineStep  = fontSize + 4;
+    int            cursorY   = y;
+
+    char line[128];
+    snprintf(line, sizeof(line), "%s %.2f ms (%d FPS)", profiler_section_name(PROFILER_FRAME), G_PROFILER.averageMs[PROFILER_FRAME], GetFPS());
+    DrawText(line, x, cursorY, fontSize, primary);
+    cursorY += lineStep;
+
+    for (int i = PROFILER_FRAME + 1; i < PROFILER_SECTION_COUNT; ++i)
+    {
+        snprintf(line, sizeof(line), "  %-10s %6.2f ms", profiler_section_name((ProfilerSection)i), G_PROFILER.averageMs[i]);
+        DrawText(line, x, cursorY, fontSize, secondary);
+        cursorY += lineStep;
+    }
+
+    for (int i = 0; i < PROFILER_COUNTER_COUNT; ++i)
+    {
+        snprintf(line, sizeof(line), "  %s/frame %.1f", G_COUNTER_NAMES[i], G_PROFILER.averageCounts[i]);
+        DrawText(line, x, cursorY, fontSize, secondary);
+        cursorY += lineStep;
+    }
+
+    return cursorY - y;
+}
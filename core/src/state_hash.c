@@ -0,0 +1,286 @@
+/**
+ * @file state_hash.c
+ * @brief Implements sectioned world-state fingerprints used by determinism checks.
+ */
+
+#include "state_hash.h"
+
+#include <string.h>
+
+#include "building.h"
+#include "map.h"
+#include "object.h"
+
+// -----------------------------------------------------------------------------
+// Hash primitives (word-at-a-time mixing, murmur3-style finalizer)
+// -----------------------------------------------------------------------------
+
+#define STATE_HASH_SEED 0x9E3779B97F4A7C15ull
+
+static inline uint64_t rotl64(uint64_t v, int r)
+{
+    return (v << r) | (v >> (64 - r));
+}
+
+static inline uint64_t hash_mix(uint64_t h, uint64_t v)
+{
+    v *= 0x87C37B91114253D5ull;
+    v = rotl64(v, 31);
+    v *= 0x4CF5AD432745937Full;
+    h ^= v;
+    h = rotl64(h, 27);
+    return h * 5u + 0x52DCE729u;
+}
+
+static inline uint64_t hash_finalize(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+static inline uint64_t hash_float(uint64_t h, float f)
+{
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return hash_mix(h, bits);
+}
+
+static uint64_t hash_bytes(uint64_t h, const uint8_t* data, size_t size)
+{
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        h = hash_mix(h, word);
+    }
+
+    uint64_t tail = 0;
+    for (size_t shift = 0; i < size; ++i, shift += 8)
+        tail |= (uint64_t)data[i] << shift;
+    return hash_mix(h, tail ^ ((uint64_t)size << 56));
+}
+
+// -----------------------------------------------------------------------------
+// Sections
+// -----------------------------------------------------------------------------
+
+static uint64_t hash_tile_chunk(const Map* map, int x0, int y0, int x1, int y1)
+{
+    uint64_t h = STATE_HASH_SEED;
+    for (int y = y0; y < y1; ++y)
+    {
+        // Tiles are stored as enums; pack four per word to keep the pass short.
+        int x = x0;
+        for (; x + 4 <= x1; x += 4)
+        {
+            uint64_t packed = ((uint64_t)(uint16_t)map->tiles[y][x]) | ((uint64_t)(uint16_t)map->tiles[y][x + 1] << 16) | ((uint64_t)(uint16_t)map->tiles[y][x + 2] << 32) |
+                              ((uint64_t)(uint16_t)map->tiles[y][x + 3] << 48);
+            h = hash_mix(h, packed);
+        }
+        for (; x < x1; ++x)
+            h = hash_mix(h, (uint16_t)map->tiles[y][x]);
+
+        // Live climate layers evolve with the simulation; the base layers follow from the seed.
+        h = hash_bytes(h, &map->climate.temperature[y][x0], (size_t)(x1 - x0));
+        h = hash_bytes(h, &map->climate.humidity[y][x0], (size_t)(x1 - x0));
+    }
+    return h;
+}
+
+static uint64_t hash_object_chunk(const Map* map, int x0, int y0, int x1, int y1)
+{
+    uint64_t h     = STATE_HASH_SEED;
+    uint64_t count = 0;
+    for (int y = y0; y < y1; ++y)
+    {
+        for (int x = x0; x < x1; ++x)
+        {
+            const ObjectCell* cell = &map->objectCells[y][x];
+            if (cell->type == OBJ_NONE)
+                continue;
+
+            h = hash_mix(h, ((uint64_t)(uint32_t)(y * map->width + x) << 32) | ((uint32_t)cell->type << 8) | cell->variant);
+            count++;
+        }
+    }
+    return hash_mix(h, count);
+}
+
+/** Rehashes the chunks flagged through map_note_digest_change() since the last call. */
+static void refresh_digest(Map* map)
+{
+    MapDigest* digest = &map->digest;
+    for (int cy = 0; cy < MAP_CHUNKS_Y; ++cy)
+    {
+        for (int cx = 0; cx < MAP_CHUNKS_X; ++cx)
+        {
+            uint8_t dirty = digest->dirty[cy][cx];
+            if (!dirty)
+                continue;
+
+            int x0 = cx * CHUNK_W;
+            int y0 = cy * CHUNK_H;
+            int x1 = x0 + CHUNK_W < map->width ? x0 + CHUNK_W : map->width;
+            int y1 = y0 + CHUNK_H < map->height ? y0 + CHUNK_H : map->height;
+            if (dirty & MAP_DIGEST_TILES)
+                digest->tiles[cy][cx] = hash_tile_chunk(map, x0, y0, x1, y1);
+            if (dirty & MAP_DIGEST_OBJECTS)
+                digest->objects[cy][cx] = hash_object_chunk(map, x0, y0, x1, y1);
+            digest->dirty[cy][cx] = 0;
+        }
+    }
+}
+
+static uint64_t hash_tiles(const Map* map)
+{
+    uint64_t h = hash_mix(STATE_HASH_SEED, ((uint64_t)map->width << 32) | (uint32_t)map->height);
+    for (int cy = 0; cy < MAP_CHUNKS_Y; ++cy)
+        for (int cx = 0; cx < MAP_CHUNKS_X; ++cx)
+            h = hash_mix(h, map->digest.tiles[cy][cx]);
+    return hash_finalize(h);
+}
+
+static uint64_t hash_objects(const Map* map)
+{
+    uint64_t h = STATE_HASH_SEED;
+    for (int cy = 0; cy < MAP_CHUNKS_Y; ++cy)
+        for (int cx = 0; cx < MAP_CHUNKS_X; ++cx)
+            h = hash_mix(h, map->digest.objects[cy][cx]);
+
+    // Records change state (activation, animation) without touching their cell,
+    // so they are walked directly; only activatable objects own one. Handles
+    // depend on the pool's free-list history, so records are summed rather than
+    // chained in handle order.
+    uint64_t records  = 0;
+    uint64_t count    = 0;
+    int      capacity = object_record_capacity(map);
+    for (int handle = 1; handle <= capacity; ++handle)
+    {
+        const Object* obj = object_from_handle(map, (uint16_t)handle);
+        if (!obj)
+            continue;
+
+        int      tile = (int)obj->position.y * map->width + (int)obj->position.x;
+        uint64_t r    = hash_mix(STATE_HASH_SEED, ((uint64_t)(uint32_t)tile << 32) | (uint32_t)obj->type->id);
+        r             = hash_mix(r, ((uint64_t)(uint32_t)obj->hp << 32) | ((uint64_t)obj->isActive << 16) | (uint16_t)obj->variantFrame);
+        r             = hash_mix(r, ((uint64_t)(uint32_t)obj->animation.currentFrame << 32) | (uint32_t)obj->animation.targetFrame);
+        r             = hash_mix(r, ((uint64_t)obj->animation.playing << 1) | (uint64_t)obj->animation.forward);
+        records += hash_finalize(r);
+        count++;
+    }
+    h = hash_mix(h, records);
+    return hash_finalize(hash_mix(h, count));
+}
+
+static uint64_t hash_buildings(const Map* map)
+{
+    int      total = building_total_count(&map->buildings);
+    uint64_t h     = hash_mix(STATE_HASH_SEED, (uint64_t)(uint32_t)total);
+    for (int i = 0; i < total; ++i)
+    {
+        const Building* b = building_get(&map->buildings, i);
+        if (!b)
+            continue;
+
+        h = hash_mix(h, ((uint64_t)(uint32_t)b->id << 32) | (uint32_t)b->area);
+        h = hash_float(h, b->bounds.x);
+        h = hash_float(h, b->bounds.y);
+        h = hash_float(h, b->bounds.width);
+        h = hash_float(h, b->bounds.height);
+        h = hash_mix(h, ((uint64_t)(uint32_t)b->structureKind << 32) | (uint32_t)b->objectCount);
+        h = hash_mix(h, ((uint64_t)(uint32_t)b->speciesId << 32) | (uint32_t)b->villageId);
+        h = hash_mix(h, ((uint64_t)(uint32_t)b->occupantCurrent << 32) | (uint32_t)b->occupantActive);
+        h = hash_mix(h, (uint64_t)(uint32_t)b->residentCount);
+        for (int r = 0; r < b->residentCount && b->residents; ++r)
+            h = hash_mix(h, b->residents[r]);
+    }
+    return hash_finalize(h);
+}
+
+static uint64_t hash_entities(const EntitySystem* sys)
+{
+    uint64_t h = hash_mix(STATE_HASH_SEED, ((uint64_t)(uint32_t)sys->activeCount << 32) | sys->rngState);
+    for (int i = 0; i <= sys->highestIndex && i < MAX_ENTITIES; ++i)
+    {
+        const Entity* e = &sys->entities[i];
+        if (!e->active)
+            continue;
+
+        int typeId = e->type ? (int)e->type->id : -1;
+        h          = hash_mix(h, ((uint64_t)e->id << 32) | (uint32_t)typeId);
+        h          = hash_float(h, e->position.x);
+        h          = hash_float(h, e->position.y);
+        h          = hash_float(h, e->velocity.x);
+        h          = hash_float(h, e->velocity.y);
+        h          = hash_mix(h, (uint64_t)(uint32_t)e->hp);
+        h          = hash_float(h, e->hunger);
+        h          = hash_bytes(h, e->brain, ENTITY_BRAIN_BYTES);
+    }
+
+    for (int i = 0; i < sys->reservationCount && i < ENTITY_MAX_RESERVATIONS; ++i)
+    {
+        const EntityReservation* r = &sys->reservations[i];
+        if (!r->used)
+            continue;
+        h = hash_mix(h, ((uint64_t)(uint32_t)i << 32) | ((uint64_t)r->active << 16) | r->entityId);
+    }
+    return hash_finalize(h);
+}
+
+// -----------------------------------------------------------------------------
+// Public API
+// -----------------------------------------------------------------------------
+
+void state_hash_compute(Map* map, const EntitySystem* sys, StateHash* out)
+{
+    if (!out)
+        return;
+
+    if (map)
+        refresh_digest(map);
+
+    out->sections[STATE_HASH_TILES]     = map ? hash_tiles(map) : 0;
+    out->sections[STATE_HASH_OBJECTS]   = map ? hash_objects(map) : 0;
+    out->sections[STATE_HASH_BUILDINGS] = hash_buildings(map);
+    out->sections[STATE_HASH_ENTITIES]  = sys ? hash_entities(sys) : 0;
+
+    uint64_t h = STATE_HASH_SEED;
+    for (int i = 0; i < STATE_HASH_SECTION_COUNT; ++i)
+        h = hash_mix(h, out->sections[i]);
+    out->combined = hash_finalize(h);
+}
+
+int state_hash_first_mismatch(const StateHash* a, const StateHash* b)
+{
+    if (!a || !b)
+        return -1;
+
+    for (int i = 0; i < STATE_HASH_SECTION_COUNT; ++i)
+    {
+        if (a->sections[i] != b->sections[i])
+            return i;
+    }
+    return -1;
+}
+
+const char* state_hash_section_name(StateHashSection section)
+{
+    switch (section)
+    {
+        case STATE_HASH_TILES:
+            return "tiles";
+        case STATE_HASH_OBJECTS:
+            return "objects";
+        case STATE_HASH_BUILDINGS:
+            return "buildings";
+        case STATE_HASH_ENTITIES:
+            return "entities";
+        default:
+            return "unknown";
+    }
+}
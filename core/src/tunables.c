@@ -0,0 +1,236 @@
+/**
+ * @file tunables.c
+ * @brief Implements the runtime performance knob registry and its STV I/O.
+ */
+
+#include "tunables.h"
+
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// -----------------------------------------------------------------------------
+// Definitions (keep in sync with TunableId)
+// -----------------------------------------------------------------------------
+static const TunableDef G_TUNABLE_DEFS[TUNABLE_COUNT] = {
+    [TUNABLE_CHUNK_REBUILD_BUDGET]        = {"chunk_rebuild_budget", "tunable.chunk_rebuild_budget", 6.0f, 1.0f, 32.0f, 1.0f, true},
+    [TUNABLE_CHUNK_PRELOAD_MARGIN]        = {"chunk_preload_margin", "tunable.chunk_preload_margin", 2.0f, 0.0f, 6.0f, 1.0f, true},
+    [TUNABLE_CAMERA_PREFETCH_SECONDS]     = {"camera_prefetch_seconds", "tunable.camera_prefetch_seconds", 1.0f, 0.0f, 3.0f, 0.25f, false},
+    [TUNABLE_PATH_REPATH_INTERVAL]        = {"path_repath_interval", "tunable.path_repath_interval", 0.6f, 0.1f, 3.0f, 0.1f, false},
+    [TUNABLE_PATH_RETRY_INTERVAL]         = {"path_retry_interval", "tunable.path_retry_interval", 0.3f, 0.05f, 2.0f, 0.05f, false},
+    [TUNABLE_PATH_MAX_EXTENT]             = {"path_max_extent", "tunable.path_max_extent", 30.0f, 6.0f, 30.0f, 2.0f, true},
+    [TUNABLE_RESIDENT_REFRESH_INTERVAL]   = {"resident_refresh_interval", "tunable.resident_refresh_interval", 5.0f, 0.5f, 30.0f, 0.5f, false},
+    [TUNABLE_HUNT_SEARCH_RADIUS]          = {"hunt_search_radius", "tunable.hunt_search_radius", 12.0f, 2.0f, 32.0f, 1.0f, true},
+    [TUNABLE_GATHER_SEARCH_RADIUS]        = {"gather_search_radius", "tunable.gather_search_radius", 8.0f, 2.0f, 32.0f, 1.0f, true},
+    [TUNABLE_STREAM_ACTIVATION_PADDING]   = {"stream_activation_padding", "tunable.stream_activation_padding", 8.0f, 0.0f, 64.0f, 1.0f, false},
+    [TUNABLE_STREAM_DEACTIVATION_PADDING] = {"stream_deactivation_padding", "tunable.stream_deactivation_padding", 12.0f, 0.0f, 96.0f, 1.0f, false},
+    [TUNABLE_FRAME_BUDGET_MS]             = {"frame_budget_ms", "tunable.frame_budget_ms", 16.0f, 4.0f, 40.0f, 0.5f, false},
+};
+
+/** Upper bound on the comment header carried over by tunables_save(). */
+#define TUNABLES_HEADER_MAX 4096
+
+static float G_TUNABLE_VALUES[TUNABLE_COUNT];
+static bool  G_TUNABLES_READY = false;
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+
+static void trim(char* s)
+{
+    if (!s)
+        return;
+    char* start = s;
+    while (*start && isspace((unsigned char)*start))
+        start++;
+    if (start != s)
+        memmove(s, start, strlen(start) + 1);
+    size_t n = strlen(s);
+    while (n > 0 && isspace((unsigned char)s[n - 1]))
+        s[--n] = '\0';
+}
+
+static float clamp_value(const TunableDef* def, float value)
+{
+    if (!isfinite(value))
+        value = def->defaultValue;
+    if (def->integer)
+        value = roundf(value);
+    if (value < def->minValue)
+        value = def->minValue;
+    if (value > def->maxValue)
+        value = def->maxValue;
+    return value;
+}
+
+static void ensure_ready(void)
+{
+    if (!G_TUNABLES_READY)
+        tunables_reset_defaults();
+}
+
+static int find_by_key(const char* key)
+{
+    for (int i = 0; i < TUNABLE_COUNT; ++i)
+    {
+        if (strcmp(G_TUNABLE_DEFS[i].key, key) == 0)
+            return i;
+    }
+    return -1;
+}
+
+/**
+ * Copies the leading comment block of an existing file (comments and blank
+ * lines up to the first section or value) so a save keeps its documentation.
+ */
+static size_t read_header(const char* path, char* out, size_t capacity)
+{
+    FILE* f = fopen(path, "r");
+    if (!f)
+        return 0;
+
+    size_t length = 0;
+    char   line[256];
+    while (fgets(line, sizeof(line), f))
+    {
+        char first = line[strspn(line, " \t")];
+        if (first != '#' && first != '\n' && first != '\r' && first != '\0')
+            break;
+        size_t n = strlen(line);
+        if (length + n >= capacity)
+            break;
+        memcpy(out + length, line, n);
+        length += n;
+    }
+    out[length] = '\0';
+
+    fclose(f);
+    return length;
+}
+
+// -----------------------------------------------------------------------------
+// Public API
+// -----------------------------------------------------------------------------
+
+void tunables_reset_defaults(void)
+{
+    for (int i = 0; i < TUNABLE_COUNT; ++i)
+        G_TUNABLE_VALUES[i] = G_TUNABLE_DEFS[i].defaultValue;
+    G_TUNABLES_READY = true;
+}
+
+bool tunables_load(const char* path)
+{
+    ensure_ready();
+    if (!path)
+        path = TUNABLES_DEFAULT_PATH;
+
+    FILE* f = fopen(path, "r");
+    if (!f)
+    {
+        printf("⚠️ Tunables file not found (%s), using defaults\n", path);
+        return false;
+    }
+
+    char line[256];
+    while (fgets(line, sizeof(line), f))
+    {
+        trim(line);
+        if (line[0] == '#' || line[0] == '[' || line[0] == '\0')
+            continue;
+
+        char key[64], value[64];
+        if (sscanf(line, "%63[^=]=%63[^\n]", key, value) != 2)
+            continue;
+        trim(key);
+        trim(value);
+
+        int index = find_by_key(key);
+        if (index < 0)
+        {
+            printf("⚠️ Unknown tunable '%s' in %s\n", key, path);
+            continue;
+        }
+        G_TUNABLE_VALUES[index] = clamp_value(&G_TUNABLE_DEFS[index], (float)atof(value));
+    }
+
+    fclose(f);
+    return true;
+}
+
+bool tunables_save(const char* path)
+{
+    ensure_ready();
+    if (!path)
+        path = TUNABLES_DEFAULT_PATH;
+
+    char header[TUNABLES_HEADER_MAX];
+    bool keepHeader = read_header(path, header, sizeof(header)) > 0;
+
+    FILE* f = fopen(path, "w");
+    if (!f)
+    {
+        printf("❌ Cannot write tunables file: %s\n", path);
+        return false;
+    }
+
+    if (keepHeader)
+        fputs(header, f);
+    else
+    {
+        fprintf(f, "# =========================================================\n");
+        fprintf(f, "# RUNTIME TUNABLES (.stv) - saved from the settings menu\n");
+        fprintf(f, "# =========================================================\n\n");
+    }
+    fprintf(f, "[PERFORMANCE]\n");
+    for (int i = 0; i < TUNABLE_COUNT; ++i)
+    {
+        const TunableDef* def = &G_TUNABLE_DEFS[i];
+        if (def->integer)
+            fprintf(f, "%-27s = %d\n", def->key, (int)G_TUNABLE_VALUES[i]);
+        else
+            fprintf(f, "%-27s = %.2f\n", def->key, G_TUNABLE_VALUES[i]);
+    }
+
+    fclose(f);
+    return true;
+}
+
+const TunableDef* tunable_def(TunableId id)
+{
+    if (id < 0 || id >= TUNABLE_COUNT)
+        return NULL;
+    return &G_TUNABLE_DEFS[id];
+}
+
+float tunable_get(TunableId id)
+{
+    if (id < 0 || id >= TUNABLE_COUNT)
+        return 0.0f;
+    ensure_ready();
+    return G_TUNABLE_VALUES[id];
+}
+
+int tunable_get_int(TunableId id)
+{
+    return (int)lroundf(tunable_get(id));
+}
+
+void tunable_set(TunableId id, float value)
+{
+    if (id < 0 || id >= TUNABLE_COUNT)
+        return;
+    ensure_ready();
+    G_TUNABLE_VALUES[id] = clamp_value(&G_TUNABLE_DEFS[id], value);
+}
+
+void tunable_step(TunableId id, int steps)
+{
+    const TunableDef* def = tunable_def(id);
+    if (!def)
+        return;
+    tunable_set(id, tunable_get(id) + def->step * (float)steps);
+}
@@ -0,0 +1,64 @@
+/**
+ * @file world_context.c
+ * @brief Implements world generation, fixed stepping and teardown for a WorldContext.
+
+ */
+
+#include "world_context.h"
+
+#include "app.h"
+#include "building.h"
+#include "map.h"
+#include "object.h"
+#include "profiler.h"
+
+bool world_context_init(WorldContext* ctx, unsigned int seed)
+{
+    if (!ctx)
+        return false;
+
+    ctx->seed = seed;
+    ctx->tick = 0;
+
+    world_time_init(&ctx->time);
+    map_init(&ctx->map, seed);
+    world_apply_season_effects(&ctx->map, &ctx->time);
+
+    Rectangle fullRegion = {
+        .x      = 0.0f,
+        .y      = 0.0f,
+        .width  = (float)(ctx->map.width * TILE_SIZE),
+        .height = (float)(ctx->map.height * TILE_SIZE),
+    };
+    update_building_detection(&ctx->map, fullRegion);
+
+    if (!entity_system_init(&ctx->entities, &ctx->map, seed ^ APP_ENTITY_SEED_SALT, "data/entities.stv"))
+        TraceLog(LOG_WARNING, "Entity definitions failed to load, using built-in defaults.");
+
+    return true;
+}
+
+void world_context_step(WorldContext* ctx, const Camera2D* camera, const CameraMotion* motion, float dt)
+{
+    if (!ctx)
+        return;
+
+    world_time_update(&ctx->time, dt);
+    world_apply_season_effects(&ctx->map, &ctx->time);
+    profiler_begin(PROFILER_ENTITIES);
+    entity_system_update(&ctx->entities, &ctx->map, &ctx->time, camera, motion, dt);
+    profiler_end(PROFILER_ENTITIES);
+    profiler_begin(PROFILER_OBJECTS);
+    object_update_system(&ctx->map, dt);
+    profiler_end(PROFILER_OBJECTS);
+    ctx->tick++;
+}
+
+void world_context_shutdown(WorldContext* ctx)
+{
+    if (!ctx)
+        return;
+
+    entity_system_shutdown(&ctx->entities);
+    map_unload(&ctx->map);
+}
@@ -4,9 +4,15 @@
  */
 
 #include "app.h"
+#include "determinism.h"
 
-int main(void)
+int main(int argc, char** argv)
 {
+    // Headless tooling (determinism checks) bypasses the interactive loop.
+    int exitCode = 0;
+    if (determinism_handle_command_line(argc, argv, &exitCode))
+        return exitCode;
+
     // Run the high-level application loop defined in the core module.
     app_run();
 
@@ -24,14 +24,14 @@ typedef enum EntityCompetence
 } EntityCompetence;
 
 /**
- * @brief Returns the current global darkness factor (0.0 = day, 1.0 = deep night).
+ * @brief Returns the darkness factor of the system's world (0.0 = day, 1.0 = deep night).
  */
-float behavior_darkness_factor(void);
+float behavior_darkness_factor(const EntitySystem* sys);
 
 /**
  * @brief Convenience helper returning true when darkness exceeds the threshold.
  */
-bool behavior_is_night(float threshold);
+bool behavior_is_night(const EntitySystem* sys, float threshold);
 
 /**
  * @brief Checks if the given entity type owns the requested competence bitmask.
@@ -79,6 +79,14 @@ void behavior_handle_entity_death(EntitySystem* sys, Map* map, Entity* victim, E
  */
 void behavior_try_reproduce(Entity* entity, EntityList* entities);
 
+/**
+ * @brief Searches the registry for the type newborns of @p parentType should get.
+ *
+ * Used when the type relationships are built; reproduction reads the result
+ * from EntityType::offspringTypeIndex.
+ */
+const EntityType* behavior_resolve_offspring_type(const EntitySystem* sys, const EntityType* parentType);
+
 /**
  * @brief Daytime hunting routine used by carnivorous entities.
  */
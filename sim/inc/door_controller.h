@@ -0,0 +1,68 @@
+/**
+ * @file door_controller.h
+ * @brief Opens doors on behalf of entities and closes them again once clear.
+ *
+ * Entities bumping into a closed door ask the controller to open it. The
+ * door's state flips immediately (walkability is read live from the object),
+ * while the chunk redraw is queued and applied once per frame however many
+ * entities pushed the same door. Every door opened this way is tracked with a
+ * close deadline; when it expires the doorway is checked for entities and the
+ * door either closes or gets a new deadline.
+ *
+ * Doors toggled by the player are not tracked and keep their state. Each
+ * world's entity system owns its controller (EntitySystem::doors).
+ */
+
+#ifndef DOOR_CONTROLLER_H
+#define DOOR_CONTROLLER_H
+
+#include <stdbool.h>
+
+#include "world.h"
+
+struct EntitySystem;
+
+/** @brief Maximum number of doors tracked at once; extra doors simply stay open. */
+#define DOOR_CONTROLLER_MAX_DOORS 128
+/** @brief Seconds a door stays open after the last entity asked for it. */
+#define DOOR_CONTROLLER_CLOSE_DELAY 2.0f
+/** @brief Seconds before re-checking a door whose doorway was occupied. */
+#define DOOR_CONTROLLER_RECHECK_DELAY 0.5f
+
+typedef struct TrackedDoor
+{
+    int   x;
+    int   y;
+    float closeAt;     /**< Controller time at which the door may close. */
+    bool  needsRedraw; /**< State changed since the last flush. */
+} TrackedDoor;
+
+/** @brief Doors one world's entities opened, with their close deadlines. */
+typedef struct DoorController
+{
+    TrackedDoor doors[DOOR_CONTROLLER_MAX_DOORS];
+    int         count;
+    float       clock; /**< Seconds accumulated by door_controller_update(). */
+} DoorController;
+
+/** @brief Forgets every tracked door (doors keep their current state). */
+void door_controller_reset(DoorController* doors);
+
+/**
+ * @brief Opens the door on a tile, or pushes back its close deadline.
+ *
+ * @return true if the tile holds a door that is open when this returns.
+ */
+bool door_controller_request_open(DoorController* doors, Map* map, int tileX, int tileY);
+
+/**
+ * @brief Closes expired doors whose doorway is clear and flushes queued redraws.
+ *
+ * Called once per simulation step after entities moved.
+ */
+void door_controller_update(DoorController* doors, const struct EntitySystem* sys, Map* map, float dt);
+
+/** @brief Number of doors currently held open by the controller. */
+int door_controller_open_count(const DoorController* doors);
+
+#endif /* DOOR_CONTROLLER_H */
@@ -15,7 +15,14 @@
 #include <stdint.h>
 
 #include "raylib.h"
+#include "door_controller.h"
+#include "light_schedule.h"
+#include "path_telemetry.h"
+#include "pathfinding.h"
 #include "world.h"
+#include "world_time.h"
+
+struct CameraMotion;
 
 // -----------------------------------------------------------------------------
 // CONSTANTS
@@ -49,6 +56,9 @@
 /** Maximum path length (including null terminator) for sprite textures. */
 #define ENTITY_TEXTURE_PATH_MAX 128
 
+/** Maximum animation frames per sprite strip (source rects are precomputed). */
+#define ENTITY_SPRITE_MAX_FRAMES 32
+
 /** Number of bytes reserved as an inline behaviour blackboard per entity. */
 #define ENTITY_BRAIN_BYTES 64
 
@@ -58,6 +68,9 @@
 /** Maximum number of persistent entity reservations used for streaming. */
 #define ENTITY_MAX_RESERVATIONS 1024
 
+/** Behaviour buckets updated as batches; the last one collects any overflow. */
+#define ENTITY_MAX_BEHAVIOR_BUCKETS 8
+
 // -----------------------------------------------------------------------------
 // ENUMS & FLAGS
 // -----------------------------------------------------------------------------
@@ -77,6 +90,32 @@ typedef void (*EntityBehaviourSpawnFn)(struct EntitySystem*, struct Entity*);
 typedef void (*EntityBehaviourUpdateFn)(struct EntitySystem*, struct Entity*, const Map*, float dt);
 typedef void (*EntityBehaviourDespawnFn)(struct EntitySystem*, struct Entity*);
 
+/**
+ * @brief Trait and category facts derived once per type (see EntityType::relationTags).
+ */
+typedef enum EntityTypeTag
+{
+    ENTITY_TAG_TRAIT_CANNIBAL    = 1u << 0,
+    ENTITY_TAG_TRAIT_UNDEAD      = 1u << 1,
+    ENTITY_TAG_TRAIT_DEMON       = 1u << 2,
+    ENTITY_TAG_CATEGORY_HUMANOID = 1u << 3,
+    ENTITY_TAG_CATEGORY_UNDEAD   = 1u << 4,
+    ENTITY_TAG_CATEGORY_DEMON    = 1u << 5,
+    ENTITY_TAG_ELDER_VARIANT     = 1u << 6,
+} EntityTypeTag;
+
+/**
+ * @brief What a per-entity random draw is for; separates the streams of one tick.
+ */
+typedef enum EntityRngPurpose
+{
+    ENTITY_RNG_WANDER = 1,       /**< Direction, speed and duration of a wander leg. */
+    ENTITY_RNG_RETURN_HOME,      /**< Pause while heading back into the home range. */
+    ENTITY_RNG_PROMOTION,        /**< Adult form picked for a grown child. */
+    ENTITY_RNG_REPRODUCTION,     /**< Birth roll and newborn scatter. */
+    ENTITY_RNG_RESIDENT_SCATTER, /**< Placement of residents scheduled for a building. */
+} EntityRngPurpose;
+
 typedef enum EntitySex
 {
     ENTITY_SEX_UNDEFINED = 0,
@@ -105,6 +144,7 @@ typedef struct EntitySprite
     int       frameCount;                           /**< Total number of frames in the strip. */
     float     frameDuration;                        /**< Duration of one frame (seconds). */
     Vector2   origin;                               /**< Pivot for rendering (pixels). */
+    Rectangle frameRects[ENTITY_SPRITE_MAX_FRAMES]; /**< Source rect of each frame (derived at load). */
 } EntitySprite;
 
 typedef struct EntityType
@@ -137,6 +177,11 @@ typedef struct EntityType
     char                  gatherTargets[ENTITY_MAX_TARGET_TAGS][ENTITY_TARGET_TAG_MAX];
     float                 ageElderAfterDays; /**< Days before becoming an elder. */
     float                 ageDieAfterDays;   /**< Days before dying of old age. */
+
+    // Relationships resolved once all types are registered (entity_system_init).
+    uint32_t relationTags;       /**< EntityTypeTag bits. */
+    int      elderTypeIndex;     /**< Elder variant in EntitySystem::types (-1 if none). */
+    int      offspringTypeIndex; /**< Type given to newborns (-1 if none). */
 } EntityType;
 
 typedef struct Entity
@@ -175,6 +220,8 @@ typedef struct Entity
     int                   speciesId;                 /**< Cached species identifier. */
     float                 ageDays;                   /**< Accumulated age in simulation days. */
     bool                  isElder;                   /**< True once promoted to elder form. */
+    int                   behaviorBucket;            /**< Index in EntitySystem::behaviorBuckets (-1 if inactive). */
+    int                   bucketSlot;                /**< Position inside that bucket's id list. */
 } Entity;
 
 typedef struct EntitySpawnRule
@@ -188,34 +235,64 @@ typedef struct EntitySpawnRule
     int               groupMax; /**< Maximum number of entities per spawn. */
 } EntitySpawnRule;
 
+/**
+ * @brief Persistent record of a streamed entity.
+ *
+ * A record is either hibernated (archived state below is authoritative) or
+ * resident (@ref active: the live Entity @ref entityId is authoritative and
+ * the record is left untouched). State only moves at the two transitions:
+ * restored into the entity on activation, archived back on hibernation. A
+ * resident that dies releases its record.
+ */
 typedef struct EntityReservation
 {
-    bool           used;               /**< Slot is populated with reservation data. */
-    bool           active;             /**< Reservation currently has a live entity instance. */
-    EntitiesTypeID typeId;             /**< Entity type identifier. */
-    uint16_t       entityId;           /**< Runtime id when active, ENTITY_ID_INVALID otherwise. */
-    Vector2        position;           /**< Persisted world position (pixels). */
-    Vector2        velocity;           /**< Persisted velocity vector. */
-    float          orientation;        /**< Persisted facing angle. */
-    int            hp;                 /**< Persisted hit points. */
-    Vector2        home;               /**< Home position anchor. */
-    StructureKind  homeStructure;      /**< Optional affiliated structure. */
-    int            buildingId;         /**< Owning building id or -1 if free roaming. */
-    float          activationRadius;   /**< Distance from focus required to instantiate. */
-    float          deactivationRadius; /**< Distance from focus required to despawn. */
-    int            villageId;          /**< Associated village identifier. */
-    int            speciesId;          /**< Cached species identifier for the reservation. */
+    bool           used;          /**< Slot holds a record. */
+    bool           active;        /**< Resident: a live entity carries the state. */
+    int16_t        hp;            /**< Archived hit points (0 = type default). */
+    uint16_t       entityId;      /**< Runtime id when resident, ENTITY_ID_INVALID otherwise. */
+    EntitiesTypeID typeId;        /**< Entity type identifier (current form once archived). */
+    StructureKind  homeStructure; /**< Optional affiliated structure. */
+    Vector2        position;      /**< Archived world position (pixels). */
+    Vector2        velocity;      /**< Archived velocity vector. */
+    float          orientation;   /**< Archived facing angle. */
+    Vector2        home;          /**< Home position anchor. */
+    int            buildingId;    /**< Owning building id or -1 if free roaming. */
+    int            villageId;     /**< Associated village identifier. */
+    int            speciesId;     /**< Cached species identifier. */
+    EntitySex      sex;           /**< Archived runtime sex. */
+    float          ageDays;       /**< Archived age in simulation days. */
+    bool           isElder;       /**< Archived elder promotion flag. */
+    float          hunger;        /**< Archived hunger value. */
+    bool           hasBrain;      /**< Fields from @ref sex on were archived by a hibernation. */
+    uint8_t        brain[ENTITY_BRAIN_BYTES]; /**< Archived behaviour state. */
 } EntityReservation;
 
+/**
+ * @brief Dense list of the active entities sharing one behaviour.
+ *
+ * The update walks bucket by bucket, so the same handlers run back to back
+ * instead of interleaving in slot order.
+ */
+typedef struct EntityBehaviorBucket
+{
+    const EntityBehavior* behavior; /**< Shared behaviour (NULL for plain entities, which always use bucket 0). */
+    bool                  mixed;    /**< Overflow bucket: each entity uses its own behaviour. */
+    int                   count;
+    uint16_t              ids[MAX_ENTITIES];
+} EntityBehaviorBucket;
+
 typedef struct EntitySystem
 {
     Entity       entities[MAX_ENTITIES];
     int          activeCount;  /**< Number of active entities in the pool. */
     int          highestIndex; /**< Highest slot index currently in use. */
-    unsigned int rngState;     /**< RNG state (XorShift). */
+    unsigned int rngState;     /**< Sequential RNG state (XorShift), used while seeding. */
+    uint64_t     rngSeed;      /**< World seed of the per-entity counter streams. */
+    uint32_t     tick;         /**< Updates run so far; part of every per-entity stream key. */
 
     EntityType types[ENTITY_MAX_TYPES];
     int        typeCount;
+    uint8_t    typeSlotById[ENTITY_TYPE_COUNT]; /**< 1 + index in types per EntitiesTypeID (0 if unknown). */
 
     EntitySpawnRule spawnRules[ENTITY_MAX_SPAWN_RULES];
     int             spawnRuleCount;
@@ -227,6 +304,19 @@ typedef struct EntitySystem
     char              speciesLabels[ENTITY_MAX_SPECIES][ENTITY_SPECIES_NAME_MAX]; /**< Registered species labels. */
     int               speciesCount;                                               /**< Number of registered species labels. */
     float             residentRefreshTimer;                                       /**< Accumulator for structure resident refresh logic. */
+
+    EntityBehaviorBucket behaviorBuckets[ENTITY_MAX_BEHAVIOR_BUCKETS]; /**< Active entities grouped by behaviour. */
+    int                  behaviorBucketCount;
+    uint16_t             updateBatch[MAX_ENTITIES]; /**< Snapshot of the bucket being updated. */
+    uint8_t              updated[MAX_ENTITIES];     /**< Entities already stepped this update. */
+
+    DoorController doors;         /**< Doors opened by this world's entities. */
+    LightSchedule  lights;        /**< Dusk/dawn switching of this world's building lights. */
+    PathTrackPool  pathTracks;    /**< Incremental searches held by this world's entities. */
+    PathTelemetry  pathTelemetry; /**< Queries issued by this world's entities. */
+
+    const WorldTime* time;      /**< Clock of the owning world (set by entity_system_update()). */
+    BuildingSystem*  buildings; /**< Buildings of the world's map (linked by entity_system_init()). */
 } EntitySystem;
 
 // -----------------------------------------------------------------------------
@@ -237,12 +327,12 @@ typedef struct EntitySystem
  * @brief Initializes the entity system and loads type definitions.
  *
  * @param sys Entity system to initialize.
- * @param map Map used for initial spawn context.
+ * @param map Map used for initial spawn context; its buildings become EntitySystem::buildings.
  * @param seed Seed used for deterministic RNG.
  * @param definitionsPath Path to the entity definition STV file.
  * @return true if initialization succeeded.
  */
-bool entity_system_init(EntitySystem* sys, const Map* map, unsigned int seed, const char* definitionsPath);
+bool entity_system_init(EntitySystem* sys, Map* map, unsigned int seed, const char* definitionsPath);
 
 /**
  * @brief Releases resources associated with the entity system.
@@ -254,10 +344,12 @@ void entity_system_shutdown(EntitySystem* sys);
  *
  * @param sys Entity system to update.
  * @param map Current map used for collision and spawning context.
+ * @param time Clock of the same world (day length, step length, darkness).
  * @param camera Active camera used to determine streaming focus.
+ * @param motion Smoothed motion of @p camera (see camera_predict); NULL for a still camera.
  * @param dt Delta time in seconds.
  */
-void entity_system_update(EntitySystem* sys, const Map* map, const Camera2D* camera, float dt);
+void entity_system_update(EntitySystem* sys, const Map* map, const WorldTime* time, const Camera2D* camera, const struct CameraMotion* motion, float dt);
 
 /**
  * @brief Renders all active entities.
@@ -284,6 +376,13 @@ uint16_t entity_spawn(EntitySystem* sys, EntitiesTypeID typeId, Vector2 position
  */
 void entity_despawn(EntitySystem* sys, uint16_t id);
 
+/**
+ * @brief Switches an active entity to another behaviour (e.g. after a type change).
+ *
+ * Keeps the behaviour buckets in sync; callers still run the new onSpawn.
+ */
+void entity_set_behavior(Entity* e, const EntityBehavior* behavior);
+
 /**
  * @brief Provides mutable access to an entity by id.
  *
@@ -328,6 +427,15 @@ unsigned int entity_random(EntitySystem* sys);
 float        entity_randomf(EntitySystem* sys, float min, float max);
 int          entity_randomi(EntitySystem* sys, int min, int max);
 
+/**
+ * @brief Key of the counter RNG stream for (world seed, @p stream, current tick, @p purpose).
+ *
+ * @p stream is usually an entity id (a building id for building-level draws).
+ * Draw with the counter_rng.h helpers, numbering draws from 0; the values do
+ * not depend on the order in which entities are updated.
+ */
+uint64_t entity_rng_key(const EntitySystem* sys, uint32_t stream, EntityRngPurpose purpose);
+
 /**
  * @brief Queries whether an entity type declares a specific trait.
  */
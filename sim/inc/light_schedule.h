@@ -0,0 +1,68 @@
+/**
+ * @file light_schedule.h
+ * @brief Switches village and building lights on at dusk and off at dawn.
+ *
+ * After every building detection pass the scheduler records the activatable
+ * light sources inside each building (and on its walls). A building's lights
+ * are managed when its residents, or those of any building in the same
+ * village, have the "light at night" competence. When darkness crosses the
+ * night threshold the managed lights are switched a few per step, so a dusk
+ * transition costs one pass over the lights instead of every resident
+ * scanning its surroundings each tick. Each world's entity system owns its
+ * schedule (EntitySystem::lights).
+ */
+
+#ifndef LIGHT_SCHEDULE_H
+#define LIGHT_SCHEDULE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "world.h"
+
+struct EntitySystem;
+
+/** @brief Darkness above which lights should be on (matches resident behaviours). */
+#define LIGHT_SCHEDULE_NIGHT_THRESHOLD 0.55f
+/** @brief Lights switched per simulation step while a transition is running. */
+#define LIGHT_SCHEDULE_LIGHTS_PER_STEP 4
+
+typedef struct ScheduledLight
+{
+    int  x;
+    int  y;
+    int  buildingIndex; /**< Owner in the building list of the recorded generation. */
+    int  villageId;     /**< Owner's village (-1 if none). */
+    bool managed;       /**< Switched by the schedule for the running transition. */
+} ScheduledLight;
+
+/** @brief Lights recorded for one world and the progress of its running transition. */
+typedef struct LightSchedule
+{
+    ScheduledLight* lights;
+    int             count;
+    int             capacity;
+    bool            collected;
+    unsigned int    generation; /**< Building detection generation the lights were recorded on. */
+    bool            night;
+    int             cursor;     /**< Next light of the running transition. */
+    // Tiles already recorded by the running collect pass: a tile is seen when its
+    // stamp equals the pass stamp, so nothing has to be cleared between passes.
+    uint16_t        seen[MAP_HEIGHT][MAP_WIDTH];
+    uint16_t        seenStamp;
+} LightSchedule;
+
+/** @brief Drops (and frees) the recorded lights; they are collected again on the next update. */
+void light_schedule_reset(LightSchedule* schedule);
+
+/**
+ * @brief Refreshes ownership after building detection and advances transitions.
+ *
+ * Called once per simulation step.
+ */
+void light_schedule_update(LightSchedule* schedule, const struct EntitySystem* sys, Map* map);
+
+/** @brief Number of lights currently under schedule control. */
+int light_schedule_light_count(const LightSchedule* schedule);
+
+#endif /* LIGHT_SCHEDULE_H */
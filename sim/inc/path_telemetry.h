@@ -0,0 +1,128 @@
+/**
+ * @file path_telemetry.h
+ * @brief Per-query pathfinding telemetry, rolling aggregates and a heatmap overlay.
+ *
+ * Every call to pathfinding_find_path() produces a @ref PathQueryRecord. The
+ * most recent records are kept in a ring buffer (dumped as CSV on demand),
+ * aggregates are accumulated per requesting entity type, and two per-tile
+ * counters track how often A* expands a tile and where failing queries start
+ * or end. Each world's entity system keeps its own telemetry
+ * (EntitySystem::pathTelemetry) and passes it with the query options. The
+ * overlay turns those counters into a cached texture.
+ */
+
+#ifndef PATH_TELEMETRY_H
+#define PATH_TELEMETRY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "raylib.h"
+#include "world.h"
+
+/** @brief Number of recent queries kept for the CSV dump. */
+#define PATH_TELEMETRY_HISTORY 2048
+/** @brief Default CSV output file. */
+#define PATH_TELEMETRY_DEFAULT_CSV "path_telemetry.csv"
+
+/**
+ * @enum PathQueryResult
+ * @brief Outcome of a single pathfinding query.
+ */
+typedef enum PathQueryResult
+{
+    PATH_RESULT_FOUND = 0,        /**< A path was found by the search. */
+    PATH_RESULT_TRIVIAL,          /**< Start and goal share a tile. */
+    PATH_RESULT_BLOCKED_ENDPOINT, /**< Start or goal tile is not walkable. */
+    PATH_RESULT_WINDOW_TOO_LARGE, /**< The search window could not fit the node budget. */
+    PATH_RESULT_EXHAUSTED,        /**< Open list emptied without reaching the goal. */
+    PATH_RESULT_COUNT
+} PathQueryResult;
+
+/**
+ * @struct PathQueryRecord
+ * @brief Data captured for one pathfinding call.
+ */
+typedef struct PathQueryRecord
+{
+    EntitiesTypeID  requesterType; /**< Entity type that asked (ENTITY_TYPE_INVALID if unknown). */
+    int             startX;        /**< Start tile X. */
+    int             startY;        /**< Start tile Y. */
+    int             goalX;         /**< Goal tile X. */
+    int             goalY;         /**< Goal tile Y. */
+    int             windowWidth;   /**< Search window width in tiles (0 if no search). */
+    int             windowHeight;  /**< Search window height in tiles (0 if no search). */
+    int             expanded;      /**< Nodes popped from the open list. */
+    PathQueryResult result;        /**< Outcome. */
+    float           durationMs;    /**< Wall time spent in the call. */
+} PathQueryRecord;
+
+/**
+ * @struct PathTelemetryStats
+ * @brief Aggregates for one requester bucket (or for all queries).
+ */
+typedef struct PathTelemetryStats
+{
+    int   queries;                        /**< Total queries recorded. */
+    int   results[PATH_RESULT_COUNT];     /**< Queries per outcome. */
+    long  expandedTotal;                  /**< Sum of expanded nodes. */
+    int   expandedMax;                    /**< Largest single expansion count. */
+    float durationTotalMs;                /**< Sum of query durations. */
+    float durationMaxMs;                  /**< Slowest single query. */
+    float rollingExpanded;                /**< Moving average of expanded nodes per query. */
+    float rollingDurationMs;              /**< Moving average of duration per query. */
+} PathTelemetryStats;
+
+/** @brief Query history, aggregates and per-tile heatmaps of one world. */
+typedef struct PathTelemetry
+{
+    PathQueryRecord    history[PATH_TELEMETRY_HISTORY];
+    int                historyHead;  /**< Next slot to write. */
+    int                historyCount; /**< Valid records (<= PATH_TELEMETRY_HISTORY). */
+    PathTelemetryStats totals;
+    PathTelemetryStats perType[ENTITY_TYPE_COUNT + 1]; /**< [0] = unknown requester. */
+    uint16_t           expansions[MAP_HEIGHT][MAP_WIDTH];
+    uint16_t           failures[MAP_HEIGHT][MAP_WIDTH];
+    uint16_t           expansionPeak;
+    uint16_t           failurePeak;
+    bool               overlayDirty;
+} PathTelemetry;
+
+/** @brief Clears all records, aggregates and heatmaps. */
+void path_telemetry_reset(PathTelemetry* telemetry);
+
+/** @brief Counts one node expansion at a tile (called from the A* loop; NULL is ignored). */
+void path_telemetry_note_expansion(PathTelemetry* telemetry, int tileX, int tileY);
+
+/** @brief Stores a completed query in the history and aggregates (NULL is ignored). */
+void path_telemetry_record(PathTelemetry* telemetry, const PathQueryRecord* record);
+
+/** @brief Aggregates over every requester. */
+const PathTelemetryStats* path_telemetry_totals(const PathTelemetry* telemetry);
+
+/** @brief Aggregates for one requester type (ENTITY_TYPE_INVALID for unknown callers). */
+const PathTelemetryStats* path_telemetry_stats_for(const PathTelemetry* telemetry, EntitiesTypeID requester);
+
+/** @brief Returns a printable name for a query result. */
+const char* path_telemetry_result_name(PathQueryResult result);
+
+/**
+ * @brief Writes the query history to a CSV file and prints per-requester aggregates.
+ *
+ * @param path Output file. NULL uses @ref PATH_TELEMETRY_DEFAULT_CSV.
+ * @return true on success.
+ */
+bool path_telemetry_dump_csv(const PathTelemetry* telemetry, const char* path);
+
+/**
+ * @brief Draws the expansion/failure heatmap over the world.
+ *
+ * The texture is rebuilt at most a couple of times per second and only when
+ * new queries were recorded.
+ */
+void path_telemetry_draw_overlay(PathTelemetry* telemetry, const Map* map, const Camera2D* camera);
+
+/** @brief Releases the overlay texture. */
+void path_telemetry_shutdown(void);
+
+#endif /* PATH_TELEMETRY_H */
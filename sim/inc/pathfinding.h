@@ -2,6 +2,7 @@
 #define PATHFINDING_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "raylib.h"
 #include "world.h"
@@ -11,6 +12,11 @@ extern "C" {
 #endif
 
 #define PATHFINDING_MAX_LENGTH 256
+/* Concurrent incremental searches (see pathfinding_track_begin). */
+#define PATHFINDING_MAX_TRACKS 64
+
+struct PathTelemetry;
+struct PathTrack;
 
 typedef struct PathfindingPath
 {
@@ -20,9 +26,11 @@ typedef struct PathfindingPath
 
 typedef struct PathfindingOptions
 {
-    bool  allowDiagonal;
-    bool  canOpenDoors;
-    float agentRadius;
+    bool                  allowDiagonal;
+    bool                  canOpenDoors;
+    float                 agentRadius;
+    EntitiesTypeID        requesterType; /* Entity type issuing the query (telemetry only). */
+    struct PathTelemetry* telemetry;     /* Where the query is recorded; NULL records nothing. */
 } PathfindingOptions;
 
 bool pathfinding_find_path(const Map* map,
@@ -31,6 +39,39 @@ bool pathfinding_find_path(const Map* map,
                            const PathfindingOptions* options,
                            PathfindingPath* outPath);
 
+/* Handle of an incremental search; PATH_TRACK_INVALID when none is held. */
+typedef uint16_t PathTrackHandle;
+#define PATH_TRACK_INVALID ((PathTrackHandle)0)
+
+/* Incremental searches of one world (EntitySystem::pathTracks); slots are allocated on first use. */
+typedef struct PathTrackPool
+{
+    struct PathTrack* tracks[PATHFINDING_MAX_TRACKS];
+} PathTrackPool;
+
+/* Releases every track of the pool (world reset). Handles held by entities become invalid. */
+void pathfinding_track_reset(PathTrackPool* pool);
+
+/*
+ * Starts an incremental search for an agent chasing a moving goal. The search
+ * tree survives between updates: a goal that moved inside the explored area
+ * costs no expansion, otherwise the search resumes from its open list. The
+ * tree is rebuilt when walkability changes inside its window (door toggles are
+ * ignored for agents that open doors) or when the agent strays from its root.
+ * Returns PATH_TRACK_INVALID when all tracks are in use.
+ */
+PathTrackHandle pathfinding_track_begin(PathTrackPool* pool, const PathfindingOptions* options);
+
+/* Same contract as pathfinding_find_path, for the agent and goal positions of this tick. */
+bool pathfinding_track_update(PathTrackPool* pool,
+                              PathTrackHandle handle,
+                              const Map* map,
+                              Vector2 start,
+                              Vector2 goal,
+                              PathfindingPath* outPath);
+
+void pathfinding_track_end(PathTrackPool* pool, PathTrackHandle handle);
+
 #ifdef __cplusplus
 }
 #endif
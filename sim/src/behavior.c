@@ -6,11 +6,14 @@
 #include <stdlib.h>
 
 #include "map.h"
+#include "door_controller.h"
 #include "object.h"
 #include "tile.h"
 #include "world_time.h"
 #include "building.h"
+#include "counter_rng.h"
 #include "pantry.h"
+#include "tunables.h"
 
 // -----------------------------------------------------------------------------
 // Behaviour tuning constants
@@ -25,11 +28,9 @@
 #define REPRODUCTION_DISTANCE (TILE_SIZE * 2.0f)
 #define REPRODUCTION_COOLDOWN_SECONDS 65.0f
 #define REPRODUCTION_ANIMATION_SECONDS 5.0f
-#define HUNT_SEARCH_RADIUS_TILES 12
 #define HUNT_ENRAGED_BONUS_TILES 4
-#define GATHER_SEARCH_RADIUS_TILES 8
 
-static bool behavior_object_is_gatherable(const Object* obj);
+static bool behavior_object_is_gatherable(const ObjectType* type);
 
 static void behavior_reward_nutrition(Entity* entity, float amount)
 {
@@ -41,6 +42,13 @@ static void behavior_reward_nutrition(Entity* entity, float amount)
     entity->isHungry = (entity->hunger <= HUNGER_ALERT_THRESHOLD);
 }
 
+static PantryRegistry* behavior_pantries(const Entity* entity)
+{
+    if (!entity->system || !entity->system->buildings)
+        return NULL;
+    return &entity->system->buildings->pantries;
+}
+
 static bool behavior_deposit_food(Entity* entity, PantryItemType item, int quantity)
 {
     if (!entity || quantity <= 0)
@@ -50,9 +58,10 @@ static bool behavior_deposit_food(Entity* entity, PantryItemType item, int quant
     if (!home || !home->hasPantry)
         return false;
 
-    Pantry* pantry = pantry_get_for_building(home->id);
+    PantryRegistry* pantries = behavior_pantries(entity);
+    Pantry*         pantry   = pantry_get_for_building(pantries, home->id);
     if (!pantry)
-        pantry = pantry_create_or_get(home->id, home->pantryCapacity);
+        pantry = pantry_create_or_get(pantries, home->id, home->pantryCapacity);
     if (!pantry)
         return false;
 
@@ -68,9 +77,10 @@ static bool behavior_withdraw_food(Entity* entity, PantryItemType item, int quan
     if (!home || !home->hasPantry)
         return false;
 
-    Pantry* pantry = pantry_get_for_building(home->id);
+    PantryRegistry* pantries = behavior_pantries(entity);
+    Pantry*         pantry   = pantry_get_for_building(pantries, home->id);
     if (!pantry)
-        pantry = pantry_create_or_get(home->id, home->pantryCapacity);
+        pantry = pantry_create_or_get(pantries, home->id, home->pantryCapacity);
     if (!pantry)
         return false;
 
@@ -97,9 +107,9 @@ static void behavior_normalize_token(const char* src, char* dst, size_t cap)
     dst[len] = '\0';
 }
 
-static bool behavior_object_matches_descriptor(const Object* obj, const char* descriptor)
+static bool behavior_object_matches_descriptor(const ObjectType* type, const char* descriptor)
 {
-    if (!obj || !obj->type || !descriptor || descriptor[0] == '\0')
+    if (!type || !descriptor || descriptor[0] == '\0')
         return false;
 
     char needle[ENTITY_TARGET_TAG_MAX];
@@ -107,8 +117,7 @@ static bool behavior_object_matches_descriptor(const Object* obj, const char* de
     if (needle[0] == '\0')
         return false;
 
-    char              buffer[ENTITY_TARGET_TAG_MAX];
-    const ObjectType* type = obj->type;
+    char buffer[ENTITY_TARGET_TAG_MAX];
     if (type->category)
     {
         behavior_normalize_token(type->category, buffer, sizeof(buffer));
@@ -130,7 +139,7 @@ static bool behavior_object_matches_descriptor(const Object* obj, const char* de
     return false;
 }
 
-static bool behavior_can_gather_object(const Entity* entity, const Object* obj)
+static bool behavior_can_gather_object(const Entity* entity, const ObjectType* obj)
 {
     if (!obj)
         return false;
@@ -167,7 +176,7 @@ static bool behavior_entity_matches_target(const Entity* candidate, const char*
     return false;
 }
 
-static Building* behavior_select_home_building(const Entity* a, const Entity* b)
+static Building* behavior_select_home_building(EntitySystem* sys, const Entity* a, const Entity* b)
 {
     Building* homeA = entity_get_home(a);
     if (homeA)
@@ -190,7 +199,7 @@ static Building* behavior_select_home_building(const Entity* a, const Entity* b)
     }
 
     if (species)
-        return building_get_for_species(species, village);
+        return building_get_for_species(sys->buildings, species, village);
     return NULL;
 }
 
@@ -218,14 +227,14 @@ static bool behavior_object_is_light(const Object* obj)
     return obj->type->lightLevel > 0 || obj->type->lightRadius > 0;
 }
 
-float behavior_darkness_factor(void)
+float behavior_darkness_factor(const EntitySystem* sys)
 {
-    return world_time_get_darkness();
+    return world_time_get_darkness(sys ? sys->time : NULL);
 }
 
-bool behavior_is_night(float threshold)
+bool behavior_is_night(const EntitySystem* sys, float threshold)
 {
-    return behavior_darkness_factor() >= threshold;
+    return behavior_darkness_factor(sys) >= threshold;
 }
 
 bool behavior_type_has_competence(const EntityType* type, EntityCompetence competence)
@@ -280,7 +289,7 @@ bool behavior_force_open_doors(Entity* entity, Map* map, Vector2 desiredPosition
             if (tx < 0 || tx >= map->width)
                 continue;
 
-            Object* obj = map->objects[ty][tx];
+            Object* obj = map_object_record(map, tx, ty);
             if (!obj || !obj->type || !obj->type->isDoor)
                 continue;
 
@@ -290,7 +299,7 @@ bool behavior_force_open_doors(Entity* entity, Map* map, Vector2 desiredPosition
             if (!behavior_entity_can_interact_with_tile(entity, tx, ty))
                 continue;
 
-            if (map_toggle_door(map, tx, ty, true))
+            if (door_controller_request_open(&entity->system->doors, map, tx, ty))
                 openedDoor = true;
         }
     }
@@ -325,7 +334,7 @@ bool behavior_sync_nearby_lights(Entity* entity, Map* map, bool shouldBeActive,
             if (tx < 0 || tx >= map->width)
                 continue;
 
-            Object* obj = map->objects[ty][tx];
+            Object* obj = map_object_record(map, tx, ty);
             if (!behavior_object_is_light(obj))
                 continue;
 
@@ -337,7 +346,7 @@ bool behavior_sync_nearby_lights(Entity* entity, Map* map, bool shouldBeActive,
 
             if (obj->isActive != shouldBeActive)
             {
-                if (object_set_active(obj, shouldBeActive))
+                if (object_set_active(map, obj, shouldBeActive))
                     changed = true;
             }
         }
@@ -346,9 +355,9 @@ bool behavior_sync_nearby_lights(Entity* entity, Map* map, bool shouldBeActive,
     return changed;
 }
 
-static float behavior_last_step_seconds(void)
+static float behavior_last_step_seconds(const EntitySystem* sys)
 {
-    float dt = world_time_get_last_step_seconds();
+    float dt = world_time_get_last_step_seconds(sys ? sys->time : NULL);
     if (dt <= 0.0f)
         dt = 1.0f / 60.0f;
     return dt;
@@ -377,7 +386,7 @@ static void behavior_species_label(const EntityType* type, char* out, size_t cap
         *cut = '\0';
 }
 
-static const EntityType* behavior_pick_offspring_type(const EntitySystem* sys, const EntityType* parentType)
+const EntityType* behavior_resolve_offspring_type(const EntitySystem* sys, const EntityType* parentType)
 {
     if (!sys || !parentType)
         return NULL;
@@ -414,6 +423,13 @@ static const EntityType* behavior_pick_offspring_type(const EntitySystem* sys, c
     return parentType;
 }
 
+static const EntityType* behavior_pick_offspring_type(const EntitySystem* sys, const EntityType* parentType)
+{
+    if (!sys || !parentType)
+        return NULL;
+    return entity_system_type_at(sys, parentType->offspringTypeIndex);
+}
+
 static bool behavior_can_mate(const Entity* e)
 {
     if (!e || !e->active || !e->type)
@@ -464,7 +480,7 @@ static bool behavior_spawn_bone_pile(Map* map, Vector2 position)
                 if (tx < 0 || ty < 0 || tx >= map->width || ty >= map->height)
                     continue;
 
-                if (map->objects[ty][tx] != NULL)
+                if (map_has_object(map, tx, ty))
                     continue;
 
                 map_place_object(map, OBJ_BONE_PILE, tx, ty);
@@ -509,12 +525,12 @@ void behavior_hunger_update(EntitySystem* sys, Entity* entity, Map* map)
     if (!entity || !entity->active || !entity->type)
         return;
 
-    const float dt    = behavior_last_step_seconds();
+    const float dt    = behavior_last_step_seconds(sys);
     float       decay = HUNGER_DECAY_UNDEAD_PER_SECOND;
 
     if (!entity->isUndead)
     {
-        float secondsPerDay = world_time_get_seconds_per_day();
+        float secondsPerDay = world_time_get_seconds_per_day(sys ? sys->time : NULL);
         if (secondsPerDay <= 0.0f)
             secondsPerDay = 600.0f;
         float maxHunger = entity->maxHunger > 0.0f ? entity->maxHunger : 100.0f;
@@ -557,7 +573,7 @@ void behavior_try_reproduce(Entity* entity, EntityList* entities)
     if (!entity->type || !entity->type->canReproduce)
         return;
 
-    if (!behavior_is_night(0.55f))
+    if (!behavior_is_night(entity->system, 0.55f))
         return;
 
     EntitySystem* sys = behavior_get_system(entity, entities);
@@ -623,7 +639,8 @@ void behavior_try_reproduce(Entity* entity, EntityList* entities)
 
     if (entity->id < partner->id)
     {
-        float roll = entity_randomf(sys, 0.0f, 1.0f);
+        uint64_t key  = entity_rng_key(sys, entity->id, ENTITY_RNG_REPRODUCTION);
+        float    roll = counter_rng_unit(key, 0);
         if (roll <= 0.25f)
         {
             const EntityType* offspringType = behavior_pick_offspring_type(sys, type);
@@ -634,8 +651,8 @@ void behavior_try_reproduce(Entity* entity, EntityList* entities)
                     (entity->position.y + partner->position.y) * 0.5f,
                 };
                 float jitter = TILE_SIZE * 0.35f;
-                spawnPos.x += entity_randomf(sys, -jitter, jitter);
-                spawnPos.y += entity_randomf(sys, -jitter, jitter);
+                spawnPos.x += counter_rng_range(key, 1, -jitter, jitter);
+                spawnPos.y += counter_rng_range(key, 2, -jitter, jitter);
 
                 uint16_t childId = entity_spawn(sys, offspringType->id, spawnPos);
                 if (childId != ENTITY_ID_INVALID)
@@ -646,11 +663,11 @@ void behavior_try_reproduce(Entity* entity, EntityList* entities)
                         child->home    = spawnPos;
                         child->hunger  = child->maxHunger * 0.75f;
                         child->sex     = (child->type && child->type->sex != ENTITY_SEX_UNDEFINED) ? child->type->sex : ENTITY_SEX_UNDEFINED;
-                        Building* home = behavior_select_home_building(entity, partner);
+                        Building* home = behavior_select_home_building(sys, entity, partner);
                         if (home)
                         {
                             building_add_resident(home, child);
-                            building_on_reservation_spawn(home->id);
+                            building_on_reservation_spawn(sys->buildings, home->id);
                         }
                         else
                         {
@@ -696,7 +713,7 @@ void behavior_hunt(Entity* entity, EntityList* entities, Map* map)
     if (!entity->type || !entity->type->canHunt)
         return;
 
-    if (behavior_is_night(0.55f))
+    if (behavior_is_night(entity->system, 0.55f))
         return;
 
     if (entity->affectionTimer > 0.0f)
@@ -728,7 +745,7 @@ void behavior_hunt(Entity* entity, EntityList* entities, Map* map)
     if (entity->behaviorTimer > 0.0f && entity->behaviorTargetId != ENTITY_ID_INVALID)
         return;
 
-    int   radiusTiles = HUNT_SEARCH_RADIUS_TILES + (entity->enraged ? HUNT_ENRAGED_BONUS_TILES : 0);
+    int   radiusTiles = tunable_get_int(TUNABLE_HUNT_SEARCH_RADIUS) + (entity->enraged ? HUNT_ENRAGED_BONUS_TILES : 0);
     float radius      = radiusTiles * (float)TILE_SIZE;
     float radiusSq    = radius * radius;
 
@@ -763,11 +780,10 @@ void behavior_hunt(Entity* entity, EntityList* entities, Map* map)
     }
 }
 
-static bool behavior_object_is_gatherable(const Object* obj)
+static bool behavior_object_is_gatherable(const ObjectType* type)
 {
-    if (!obj || !obj->type)
+    if (!type)
         return false;
-    const ObjectType* type = obj->type;
     if (type->category && strcmp(type->category, "resource") == 0)
         return true;
     if (type->name && (strstr(type->name, "bush") || strstr(type->name, "plant")))
@@ -783,7 +799,7 @@ void behavior_gather(Entity* entity, Map* map)
     if (!entity->type || !entity->type->canGather)
         return;
 
-    if (behavior_is_night(0.55f))
+    if (behavior_is_night(entity->system, 0.55f))
     {
         entity->gatherActive = 0;
         return;
@@ -810,7 +826,7 @@ void behavior_gather(Entity* entity, Map* map)
             int targetY = (int)floorf(entity->gatherTarget.y / TILE_SIZE);
             if (targetX >= 0 && targetX < map->width && targetY >= 0 && targetY < map->height)
             {
-                Object* obj = map->objects[targetY][targetX];
+                const ObjectType* obj = map_object_type_at(map, targetX, targetY);
                 if (behavior_can_gather_object(entity, obj))
                 {
                     bool stored = behavior_deposit_food(entity, PANTRY_ITEM_PLANT, 1);
@@ -832,7 +848,7 @@ void behavior_gather(Entity* entity, Map* map)
 
     int centerX = (int)floorf(entity->position.x / TILE_SIZE);
     int centerY = (int)floorf(entity->position.y / TILE_SIZE);
-    int radius  = GATHER_SEARCH_RADIUS_TILES;
+    int radius  = tunable_get_int(TUNABLE_GATHER_SEARCH_RADIUS);
 
     float   bestDist = (float)(radius * TILE_SIZE) * (float)(radius * TILE_SIZE);
     Vector2 target   = {0.0f, 0.0f};
@@ -850,7 +866,7 @@ void behavior_gather(Entity* entity, Map* map)
             if (tx < 0 || tx >= map->width)
                 continue;
 
-            Object* obj = map->objects[ty][tx];
+            const ObjectType* obj = map_object_type_at(map, tx, ty);
             if (!behavior_can_gather_object(entity, obj))
                 continue;
 
@@ -5,9 +5,12 @@
 
 #include "behavior.h"
 #include "building.h"
+#include "counter_rng.h"
 #include "map.h"
 #include "pathfinding.h"
 #include "tile.h"
+#include "frame_budget.h"
+#include "tunables.h"
 #include "world_time.h"
 
 #ifndef PI
@@ -18,19 +21,29 @@
 
 typedef struct CannibalBrain
 {
-    float   wanderTimer;
-    float   attackCooldown;
-    float   repathTimer;
-    float   juvenileAgeDays;
-    int     lastHP;
-    int     targetId;
-    Vector2 pathGoal;
-    Vector2 waypoint;
-    uint8_t waypointValid;
+    float           wanderTimer;
+    float           attackCooldown;
+    float           repathTimer;
+    float           juvenileAgeDays;
+    int             lastHP;
+    int             targetId;
+    Vector2         pathGoal;
+    Vector2         waypoint;
+    uint8_t         waypointValid;
+    PathTrackHandle pathTrack; /* Incremental search while chasing a target. */
 } CannibalBrain;
 
 static void cannibal_on_spawn(EntitySystem* sys, Entity* e);
 
+static void cannibal_release_track(EntitySystem* sys, CannibalBrain* brain)
+{
+    if (brain->pathTrack != PATH_TRACK_INVALID)
+    {
+        pathfinding_track_end(&sys->pathTracks, brain->pathTrack);
+        brain->pathTrack = PATH_TRACK_INVALID;
+    }
+}
+
 static bool cannibal_is_child(const Entity* e)
 {
     return e && e->type && e->type->id == ENTITY_TYPE_CANNIBAL_CHILD;
@@ -54,12 +67,12 @@ static bool cannibal_is_adult(const Entity* e)
     return id == ENTITY_TYPE_CANNIBAL || id == ENTITY_TYPE_CANNIBAL_WOMAN;
 }
 
-static float cannibal_sim_days_step(void)
+static float cannibal_sim_days_step(const EntitySystem* sys)
 {
-    float secondsPerDay = world_time_get_seconds_per_day();
+    float secondsPerDay = world_time_get_seconds_per_day(sys->time);
     if (secondsPerDay <= 0.0f)
         return 0.0f;
-    return world_time_get_last_step_seconds() / secondsPerDay;
+    return world_time_get_last_step_seconds(sys->time) / secondsPerDay;
 }
 
 static void cannibal_promote_child(EntitySystem* sys, Entity* e)
@@ -67,16 +80,17 @@ static void cannibal_promote_child(EntitySystem* sys, Entity* e)
     if (!sys || !e || !cannibal_is_child(e))
         return;
 
-    float roll = entity_randomf(sys, 0.0f, 1.0f);
+    float roll = counter_rng_unit(entity_rng_key(sys, e->id, ENTITY_RNG_PROMOTION), 0);
     EntitiesTypeID newTypeId = (roll < 0.5f) ? ENTITY_TYPE_CANNIBAL : ENTITY_TYPE_CANNIBAL_WOMAN;
     const EntityType* newType = entity_find_type(sys, newTypeId);
     if (!newType)
         return;
 
-    e->type     = newType;
-    e->behavior = newType->behavior;
-    e->hp       = newType->maxHP;
+    e->type = newType;
+    e->hp   = newType->maxHP;
+    entity_set_behavior(e, newType->behavior);
 
+    cannibal_release_track(sys, (CannibalBrain*)e->brain);
     cannibal_on_spawn(sys, e);
 
     CannibalBrain* brain = (CannibalBrain*)e->brain;
@@ -88,9 +102,8 @@ static bool cannibal_is_friendly(const Entity* other)
 {
     if (!other || !other->type)
         return false;
-    bool hasCannibalTrait = entity_type_has_trait(other->type, "cannibal");
-    bool humanoidCategory = entity_type_is_category(other->type, "humanoid");
-    return hasCannibalTrait && humanoidCategory;
+    const uint32_t friendly = ENTITY_TAG_TRAIT_CANNIBAL | ENTITY_TAG_CATEGORY_HUMANOID;
+    return (other->type->relationTags & friendly) == friendly;
 }
 
 static bool cannibal_is_valid_target(const Entity* self, const Entity* other)
@@ -134,13 +147,14 @@ static void cannibal_pick_direction(EntitySystem* sys, Entity* e, CannibalBrain*
     if (!sys || !e || !e->type || !brain)
         return;
 
-    float angle = entity_randomf(sys, 0.0f, 2.0f * PI);
-    float speed = e->type->maxSpeed * entity_randomf(sys, 0.65f, 1.1f);
+    uint64_t key   = entity_rng_key(sys, e->id, ENTITY_RNG_WANDER);
+    float    angle = counter_rng_range(key, 0, 0.0f, 2.0f * PI);
+    float    speed = e->type->maxSpeed * counter_rng_range(key, 1, 0.65f, 1.1f);
 
     e->velocity.x      = cosf(angle) * speed;
     e->velocity.y      = sinf(angle) * speed;
     e->orientation     = angle;
-    brain->wanderTimer = entity_randomf(sys, 0.6f, 2.2f);
+    brain->wanderTimer = counter_rng_range(key, 2, 0.6f, 2.2f);
 }
 
 static void cannibal_on_spawn(EntitySystem* sys, Entity* e)
@@ -186,7 +200,7 @@ static void cannibal_on_update(EntitySystem* sys, Entity* e, const Map* map, flo
         return;
     }
 
-    float simDayStep = cannibal_sim_days_step();
+    float simDayStep = cannibal_sim_days_step(sys);
 
     if (cannibal_is_child(e))
     {
@@ -207,15 +221,14 @@ static void cannibal_on_update(EntitySystem* sys, Entity* e, const Map* map, flo
 
     bool       wasHit         = (brain->lastHP > e->hp);
     Entity*    target         = NULL;
-    const bool isNight        = behavior_is_night(0.55f);
+    const bool isNight        = behavior_is_night(sys, 0.55f);
     const bool canShelter     = behavior_entity_has_competence(e, ENTITY_COMPETENCE_SEEK_SHELTER_AT_NIGHT);
     bool       seekingShelter = false;
+    bool       chasingTarget  = false;
     Vector2    desiredGoal    = e->position;
     bool       haveGoal       = false;
 
-    if (behavior_entity_has_competence(e, ENTITY_COMPETENCE_LIGHT_AT_NIGHT))
-        behavior_sync_nearby_lights(e, mutableMap, isNight, 1);
-
+    // Village lights follow the dusk/dawn schedule (see light_schedule.h).
     behavior_hunt(e, (EntityList*)sys, mutableMap);
     behavior_gather(e, mutableMap);
 
@@ -269,8 +282,9 @@ static void cannibal_on_update(EntitySystem* sys, Entity* e, const Map* map, flo
     {
         if (target)
         {
-            desiredGoal = target->position;
-            haveGoal    = true;
+            desiredGoal   = target->position;
+            haveGoal      = true;
+            chasingTarget = true;
         }
         else if (e->gatherActive)
         {
@@ -284,6 +298,10 @@ static void cannibal_on_update(EntitySystem* sys, Entity* e, const Map* map, flo
         }
     }
 
+    // The incremental search only pays off while following a moving target.
+    if (!chasingTarget)
+        cannibal_release_track(sys, brain);
+
     if (haveGoal)
     {
         float goalDistSq = (desiredGoal.x - e->position.x) * (desiredGoal.x - e->position.x) + (desiredGoal.y - e->position.y) * (desiredGoal.y - e->position.y);
@@ -306,10 +324,17 @@ static void cannibal_on_update(EntitySystem* sys, Entity* e, const Map* map, flo
                     .allowDiagonal = true,
                     .canOpenDoors  = behavior_entity_has_competence(e, ENTITY_COMPETENCE_OPEN_DOORS),
                     .agentRadius   = e->type->radius,
+                    .requesterType = e->type->id,
+                    .telemetry     = &sys->pathTelemetry,
                 };
 
+                if (chasingTarget && brain->pathTrack == PATH_TRACK_INVALID)
+                    brain->pathTrack = pathfinding_track_begin(&sys->pathTracks, &options);
+
                 PathfindingPath path;
-                if (pathfinding_find_path(map, e->position, desiredGoal, &options, &path) && path.count > 0)
+                bool            found = (brain->pathTrack != PATH_TRACK_INVALID) ? pathfinding_track_update(&sys->pathTracks, brain->pathTrack, map, e->position, desiredGoal, &path)
+                                                                                  : pathfinding_find_path(map, e->position, desiredGoal, &options, &path);
+                if (found && path.count > 0)
                 {
                     Vector2 nextPoint = path.points[0];
                     if (path.count >= 2)
@@ -318,12 +343,12 @@ static void cannibal_on_update(EntitySystem* sys, Entity* e, const Map* map, flo
                     brain->waypoint      = nextPoint;
                     brain->pathGoal      = desiredGoal;
                     brain->waypointValid = 1;
-                    brain->repathTimer   = 0.6f;
+                    brain->repathTimer   = tunable_get(TUNABLE_PATH_REPATH_INTERVAL) * frame_budget_interval_scale(FRAME_TASK_REPATH);
                 }
                 else
                 {
                     brain->waypointValid = 0;
-                    brain->repathTimer   = 0.3f;
+                    brain->repathTimer   = tunable_get(TUNABLE_PATH_RETRY_INTERVAL) * frame_budget_interval_scale(FRAME_TASK_REPATH);
                 }
             }
 
@@ -372,7 +397,7 @@ static void cannibal_on_update(EntitySystem* sys, Entity* e, const Map* map, flo
             e->velocity.y  = toHome.y * inv * (e->type->maxSpeed * 0.9f);
             e->orientation = atan2f(e->velocity.y, e->velocity.x);
         }
-        brain->wanderTimer = entity_randomf(sys, 0.2f, 0.8f);
+        brain->wanderTimer = counter_rng_range(entity_rng_key(sys, e->id, ENTITY_RNG_RETURN_HOME), 0, 0.2f, 0.8f);
     }
     else if (brain->wanderTimer <= 0.0f)
     {
@@ -459,10 +484,16 @@ static void cannibal_on_update(EntitySystem* sys, Entity* e, const Map* map, flo
     brain->lastHP = e->hp;
 }
 
+static void cannibal_on_despawn(EntitySystem* sys, Entity* e)
+{
+    if (e)
+        cannibal_release_track(sys, (CannibalBrain*)e->brain);
+}
+
 static const EntityBehavior G_CANNIBAL_BEHAVIOR = {
     .onSpawn   = cannibal_on_spawn,
     .onUpdate  = cannibal_on_update,
-    .onDespawn = NULL,
+    .onDespawn = cannibal_on_despawn,
     .brainSize = sizeof(CannibalBrain),
 };
 
@@ -0,0 +1,141 @@
+/**
+ * @file door_controller.c
+ * @brief Implements the tracked door set, close deadlines and batched redraws.
+ */
+
+#include "door_controller.h"
+
+#include <math.h>
+
+#include "entity.h"
+#include "map.h"
+#include "object.h"
+#include "world_chunk.h"
+
+static int door_find(const DoorController* doors, int x, int y)
+{
+    for (int i = 0; i < doors->count; ++i)
+        if (doors->doors[i].x == x && doors->doors[i].y == y)
+            return i;
+    return -1;
+}
+
+/** True when an entity's footprint overlaps the doorway tile. */
+static bool entity_in_doorway(const Entity* e, int x, int y)
+{
+    float radius = e->type ? e->type->radius : 0.0f;
+    int   minX   = (int)floorf((e->position.x - radius) / TILE_SIZE);
+    int   maxX   = (int)floorf((e->position.x + radius) / TILE_SIZE);
+    int   minY   = (int)floorf((e->position.y - radius) / TILE_SIZE);
+    int   maxY   = (int)floorf((e->position.y + radius) / TILE_SIZE);
+    return x >= minX && x <= maxX && y >= minY && y <= maxY;
+}
+
+void door_controller_reset(DoorController* doors)
+{
+    if (!doors)
+        return;
+    doors->count = 0;
+    doors->clock = 0.0f;
+}
+
+bool door_controller_request_open(DoorController* doors, Map* map, int tileX, int tileY)
+{
+    if (!doors || !map || tileX < 0 || tileY < 0 || tileX >= map->width || tileY >= map->height)
+        return false;
+
+    Object* obj = map_object_record(map, tileX, tileY);
+    if (!obj || !obj->type || !obj->type->isDoor || !object_has_activation(obj))
+        return false;
+
+    int index = door_find(doors, tileX, tileY);
+    if (index >= 0)
+    {
+        // Already ours: several entities pushing the same door cost nothing more.
+        doors->doors[index].closeAt = doors->clock + DOOR_CONTROLLER_CLOSE_DELAY;
+        if (!obj->isActive && object_set_active(map, obj, true))
+            doors->doors[index].needsRedraw = true;
+        return obj->isActive;
+    }
+
+    if (obj->isActive)
+        return true; // opened by someone else (e.g. the player); leave it alone
+
+    if (!object_set_active(map, obj, true))
+        return false;
+
+    if (doors->count < DOOR_CONTROLLER_MAX_DOORS)
+        doors->doors[doors->count++] = (TrackedDoor){tileX, tileY, doors->clock + DOOR_CONTROLLER_CLOSE_DELAY, true};
+    else
+        chunkgrid_redraw_cell(map->chunks, map, tileX, tileY); // untracked: stays open
+    return true;
+}
+
+void door_controller_update(DoorController* doors, const EntitySystem* sys, Map* map, float dt)
+{
+    if (!doors || !map)
+        return;
+
+    if (dt > 0.0f)
+        doors->clock += dt;
+
+    // Gather expired doors, then look for entities standing in them in one pass.
+    int  due[DOOR_CONTROLLER_MAX_DOORS];
+    bool occupied[DOOR_CONTROLLER_MAX_DOORS];
+    int  dueCount = 0;
+    for (int i = 0; i < doors->count; ++i)
+    {
+        if (doors->doors[i].closeAt <= doors->clock)
+        {
+            occupied[dueCount] = false;
+            due[dueCount++]    = i;
+        }
+    }
+
+    if (dueCount > 0 && sys)
+    {
+        for (int e = 0; e <= sys->highestIndex; ++e)
+        {
+            const Entity* ent = &sys->entities[e];
+            if (!ent->active)
+                continue;
+            for (int d = 0; d < dueCount; ++d)
+                if (!occupied[d] && entity_in_doorway(ent, doors->doors[due[d]].x, doors->doors[due[d]].y))
+                    occupied[d] = true;
+        }
+    }
+
+    for (int d = 0; d < dueCount; ++d)
+    {
+        TrackedDoor* door = &doors->doors[due[d]];
+        if (occupied[d])
+        {
+            door->closeAt = doors->clock + DOOR_CONTROLLER_RECHECK_DELAY;
+            continue;
+        }
+
+        Object* obj = map_object_record(map, door->x, door->y);
+        if (obj && object_set_active(map, obj, false))
+            door->needsRedraw = true;
+        door->closeAt = -1.0f; // released below
+    }
+
+    // Flush redraws once per door and drop released doors.
+    int kept = 0;
+    for (int i = 0; i < doors->count; ++i)
+    {
+        TrackedDoor door = doors->doors[i];
+        if (door.needsRedraw)
+            chunkgrid_redraw_cell(map->chunks, map, door.x, door.y);
+        if (door.closeAt < 0.0f)
+            continue;
+        door.needsRedraw     = false;
+        doors->doors[kept++] = door;
+    }
+    doors->count = kept;
+}
+
+int door_controller_open_count(const DoorController* doors)
+{
+    return doors ? doors->count : 0;
+}
@@ -13,12 +13,21 @@
 #include "world.h"
 #include "building.h"
 #include "object.h"
+#include "map.h"
 #include "entities_loader.h"
 #include "zombie.h"
 #include "cannibal.h"
 #include "tile.h"
 #include "behavior.h"
 #include "world_time.h"
+#include "frame_budget.h"
+#include "tunables.h"
+#include "camera.h"
+#include "jobs.h"
+#include "counter_rng.h"
+#include "door_controller.h"
+#include "pathfinding.h"
+#include "light_schedule.h"
 
 #ifndef PI
 #define PI 3.14159265358979323846f
@@ -58,12 +67,18 @@ int entity_randomi(EntitySystem* sys, int min, int max)
     return min + (int)(entity_random(sys) % (span ? span : 1));
 }
 
-static float entity_sim_days_step(void)
+uint64_t entity_rng_key(const EntitySystem* sys, uint32_t stream, EntityRngPurpose purpose)
 {
-    float secondsPerDay = world_time_get_seconds_per_day();
+    uint64_t tickKey = counter_rng_key(sys ? sys->rngSeed : 0, sys ? sys->tick : 0);
+    return counter_rng_key(tickKey, ((uint64_t)purpose << 32) | stream);
+}
+
+static float entity_sim_days_step(const EntitySystem* sys)
+{
+    float secondsPerDay = world_time_get_seconds_per_day(sys->time);
     if (secondsPerDay <= 0.0f)
         return 0.0f;
-    float stepSeconds = world_time_get_last_step_seconds();
+    float stepSeconds = world_time_get_last_step_seconds(sys->time);
     if (stepSeconds <= 0.0f)
         stepSeconds = 1.0f / 60.0f;
     return stepSeconds / secondsPerDay;
@@ -74,15 +89,13 @@ static void entity_reservation_reset(EntityReservation* res)
     if (!res)
         return;
     memset(res, 0, sizeof(*res));
-    res->entityId        = ENTITY_ID_INVALID;
-    res->buildingId      = -1;
-    res->homeStructure   = STRUCT_COUNT;
-    res->activationRadius   = 0.0f;
-    res->deactivationRadius = 0.0f;
-    res->villageId       = -1;
-    res->speciesId       = 0;
-    res->used            = false;
-    res->active          = false;
+    res->entityId      = ENTITY_ID_INVALID;
+    res->buildingId    = -1;
+    res->homeStructure = STRUCT_COUNT;
+    res->villageId     = -1;
+    res->speciesId     = 0;
+    res->used          = false;
+    res->active        = false;
 }
 
 static void entity_reservations_reset(EntitySystem* sys)
@@ -98,10 +111,18 @@ static EntityReservation* entity_reservation_acquire(EntitySystem* sys)
 {
     if (!sys)
         return NULL;
-    if (sys->reservationCount >= ENTITY_MAX_RESERVATIONS)
-        return NULL;
+    // Reuse records released by dead residents before growing the table.
+    EntityReservation* res = NULL;
+    for (int i = 0; i < sys->reservationCount && !res; ++i)
+        if (!sys->reservations[i].used)
+            res = &sys->reservations[i];
 
-    EntityReservation* res = &sys->reservations[sys->reservationCount++];
+    if (!res)
+    {
+        if (sys->reservationCount >= ENTITY_MAX_RESERVATIONS)
+            return NULL;
+        res = &sys->reservations[sys->reservationCount++];
+    }
     entity_reservation_reset(res);
     res->used = true;
     return res;
@@ -114,22 +135,34 @@ static inline float entity_distance_sq(Vector2 a, Vector2 b)
     return dx * dx + dy * dy;
 }
 
-static void entity_reservation_capture(EntityReservation* res, const Entity* ent)
+static void entity_remove(EntitySystem* sys, uint16_t id, EntityReservation* hibernateInto);
+
+/** Archives a resident's state into its record when it hibernates. */
+static void entity_reservation_archive(EntityReservation* res, const Entity* ent)
 {
     if (!res || !ent)
         return;
     res->position       = ent->position;
     res->velocity       = ent->velocity;
     res->orientation    = ent->orientation;
-    res->hp             = ent->hp;
+    res->hp             = (int16_t)(ent->hp > INT16_MAX ? INT16_MAX : ent->hp);
     res->home           = ent->home;
     res->homeStructure  = ent->homeStructure;
     res->buildingId     = ent->homeBuildingId;
     res->villageId      = ent->villageId;
     res->speciesId      = ent->speciesId;
+    if (ent->type)
+        res->typeId = ent->type->id; /* Current form: promotions survive hibernation. */
+    res->sex            = ent->sex;
+    res->ageDays        = ent->ageDays;
+    res->isElder        = ent->isElder;
+    res->hunger         = ent->hunger;
+    memcpy(res->brain, ent->brain, sizeof(res->brain));
+    res->hasBrain       = true;
 }
 
-static void entity_reservation_apply(EntityReservation* res, Entity* ent)
+/** Materialises the archived state on the freshly spawned resident. */
+static void entity_reservation_restore(const EntityReservation* res, Entity* ent)
 {
     if (!res || !ent)
         return;
@@ -144,6 +177,13 @@ static void entity_reservation_apply(EntityReservation* res, Entity* ent)
     ent->villageId      = res->villageId;
     if (res->speciesId != 0)
         ent->speciesId = res->speciesId;
+    if (!res->hasBrain)
+        return; /* Never hibernated: keep the freshly spawned defaults. */
+    ent->sex            = res->sex;
+    ent->ageDays        = res->ageDays;
+    ent->isElder        = res->isElder;
+    ent->hunger         = res->hunger;
+    memcpy(ent->brain, res->brain, sizeof(ent->brain));
 }
 
 static bool entity_reservation_schedule(EntitySystem* sys,
@@ -153,9 +193,7 @@ static bool entity_reservation_schedule(EntitySystem* sys,
                                         StructureKind structure,
                                         int buildingId,
                                         int villageId,
-                                        int speciesId,
-                                        float activationRadius,
-                                        float deactivationRadius)
+                                        int speciesId)
 {
     if (!sys || typeId <= ENTITY_TYPE_INVALID)
         return false;
@@ -164,18 +202,16 @@ static bool entity_reservation_schedule(EntitySystem* sys,
     if (!res)
         return false;
 
-    res->typeId             = typeId;
-    res->position           = position;
-    res->home               = home;
-    res->homeStructure      = structure;
-    res->buildingId         = buildingId;
-    res->villageId          = villageId;
-    res->speciesId          = speciesId;
-    res->activationRadius   = activationRadius;
-    res->deactivationRadius = deactivationRadius;
-    res->velocity           = (Vector2){0.0f, 0.0f};
-    res->orientation        = 0.0f;
-    res->hp                 = 0;
+    res->typeId        = typeId;
+    res->position      = position;
+    res->home          = home;
+    res->homeStructure = structure;
+    res->buildingId    = buildingId;
+    res->villageId     = villageId;
+    res->speciesId     = speciesId;
+    res->velocity      = (Vector2){0.0f, 0.0f};
+    res->orientation   = 0.0f;
+    res->hp            = 0;
     return true;
 }
 
@@ -185,8 +221,10 @@ static void entity_system_reset(EntitySystem* sys)
         return;
     memset(sys, 0, sizeof(*sys));
     sys->highestIndex = -1;
-    sys->streamActivationPadding   = TILE_SIZE * 8.0f;
-    sys->streamDeactivationPadding = TILE_SIZE * 12.0f;
+    // Bucket 0 is reserved for entities without a behaviour (zeroed: no handler, not mixed).
+    sys->behaviorBucketCount = 1;
+    sys->streamActivationPadding   = TILE_SIZE * tunable_get(TUNABLE_STREAM_ACTIVATION_PADDING);
+    sys->streamDeactivationPadding = TILE_SIZE * tunable_get(TUNABLE_STREAM_DEACTIVATION_PADDING);
     sys->speciesCount              = 0;
     sys->residentRefreshTimer      = 0.0f;
     entity_reservations_reset(sys);
@@ -218,6 +256,69 @@ static void entity_clear_slot(EntitySystem* sys, int index)
     e->speciesId              = 0;
     e->ageDays                = 0.0f;
     e->isElder                = false;
+    e->behaviorBucket         = -1;
+    e->bucketSlot             = -1;
+}
+
+// -----------------------------------------------------------------------------
+// Behaviour buckets
+// -----------------------------------------------------------------------------
+
+static int entity_bucket_for(EntitySystem* sys, const EntityBehavior* behavior)
+{
+    for (int b = 0; b < sys->behaviorBucketCount; ++b)
+        if (!sys->behaviorBuckets[b].mixed && sys->behaviorBuckets[b].behavior == behavior)
+            return b;
+
+    if (sys->behaviorBucketCount < ENTITY_MAX_BEHAVIOR_BUCKETS)
+    {
+        EntityBehaviorBucket* bucket = &sys->behaviorBuckets[sys->behaviorBucketCount];
+        bucket->behavior             = behavior;
+        bucket->mixed                = sys->behaviorBucketCount == ENTITY_MAX_BEHAVIOR_BUCKETS - 1;
+        bucket->count                = 0;
+        return sys->behaviorBucketCount++;
+    }
+    return ENTITY_MAX_BEHAVIOR_BUCKETS - 1; // overflow: handlers resolved per entity
+}
+
+static void entity_bucket_add(EntitySystem* sys, Entity* e)
+{
+    int                   b      = entity_bucket_for(sys, e->behavior);
+    EntityBehaviorBucket* bucket = &sys->behaviorBuckets[b];
+    e->behaviorBucket            = b;
+    e->bucketSlot                = bucket->count;
+    bucket->ids[bucket->count++] = e->id;
+}
+
+static void entity_bucket_remove(EntitySystem* sys, Entity* e)
+{
+    if (e->behaviorBucket < 0)
+        return;
+
+    EntityBehaviorBucket* bucket = &sys->behaviorBuckets[e->behaviorBucket];
+    uint16_t              moved  = bucket->ids[--bucket->count];
+
+    bucket->ids[e->bucketSlot]      = moved;
+    sys->entities[moved].bucketSlot = e->bucketSlot;
+    e->behaviorBucket               = -1;
+    e->bucketSlot                   = -1;
+}
+
+void entity_set_behavior(Entity* e, const EntityBehavior* behavior)
+{
+    if (!e)
+        return;
+
+    e->behavior = behavior;
+    if (!e->active || !e->system || e->behaviorBucket < 0)
+        return;
+
+    const EntityBehaviorBucket* current = &e->system->behaviorBuckets[e->behaviorBucket];
+    if (current->mixed || current->behavior != behavior)
+    {
+        entity_bucket_remove(e->system, e);
+        entity_bucket_add(e->system, e);
+    }
 }
 
 static void entity_unload_sprite(EntitySprite* sprite)
@@ -251,6 +352,14 @@ static void entity_load_sprite(EntitySprite* sprite)
         sprite->frameHeight = tex.height;
     if (sprite->frameCount <= 0)
         sprite->frameCount = 1;
+    if (sprite->frameCount > ENTITY_SPRITE_MAX_FRAMES)
+    {
+        printf("⚠️  Entity texture '%s' has %d frames, only the first %d are used.\n", sprite->texturePath, sprite->frameCount, ENTITY_SPRITE_MAX_FRAMES);
+        sprite->frameCount = ENTITY_SPRITE_MAX_FRAMES;
+    }
+
+    for (int f = 0; f < sprite->frameCount; ++f)
+        sprite->frameRects[f] = (Rectangle){(float)(sprite->frameWidth * f), 0.0f, (float)sprite->frameWidth, (float)sprite->frameHeight};
 }
 
 static BiomeKind infer_biome_from_tile(TileTypeID tile)
@@ -411,8 +520,7 @@ bool entity_position_is_walkable(const Map* map, Vector2 position, float radius)
             if (!tt || !tt->walkable)
                 return false;
 
-            Object* obj = map->objects[y][x];
-            if (obj && !object_is_walkable(obj))
+            if (!map_object_walkable_at(map, x, y))
                 return false;
         }
     }
@@ -424,6 +532,77 @@ bool entity_position_is_walkable(const Map* map, Vector2 position, float radius)
 // Behaviour helpers
 // -----------------------------------------------------------------------------
 
+static bool entity_type_is_elder_variant(const EntityType* type)
+{
+    if (!type)
+        return false;
+    if (entity_type_has_trait(type, "elder"))
+        return true;
+    if (type->identifier[0] != '\0' && strstr(type->identifier, "elder"))
+        return true;
+    if (type->displayName[0] != '\0' && strstr(type->displayName, "Elder"))
+        return true;
+    return false;
+}
+
+static int entity_find_elder_variant(const EntitySystem* sys, const EntityType* baseType)
+{
+    int speciesId = baseType->speciesId;
+    int fallback  = -1;
+
+    for (int i = 0; i < sys->typeCount; ++i)
+    {
+        const EntityType* candidate = &sys->types[i];
+        if (candidate == baseType)
+            continue;
+        if (speciesId > 0 && candidate->speciesId != speciesId)
+            continue;
+        if (!(candidate->relationTags & ENTITY_TAG_ELDER_VARIANT))
+            continue;
+        if (fallback < 0)
+            fallback = i;
+        if (baseType->speciesId > 0 && candidate->speciesId == baseType->speciesId)
+            return i;
+    }
+
+    return fallback;
+}
+
+static uint32_t entity_type_relation_tags(const EntityType* type)
+{
+    uint32_t tags = 0;
+    if (entity_type_has_trait(type, "cannibal"))
+        tags |= ENTITY_TAG_TRAIT_CANNIBAL;
+    if (entity_type_has_trait(type, "undead"))
+        tags |= ENTITY_TAG_TRAIT_UNDEAD;
+    if (entity_type_has_trait(type, "demon") || entity_type_has_trait(type, "démon"))
+        tags |= ENTITY_TAG_TRAIT_DEMON;
+    if (entity_type_is_category(type, "humanoid"))
+        tags |= ENTITY_TAG_CATEGORY_HUMANOID;
+    if (entity_type_is_category(type, "undead"))
+        tags |= ENTITY_TAG_CATEGORY_UNDEAD;
+    if (entity_type_is_category(type, "demon") || entity_type_is_category(type, "démon"))
+        tags |= ENTITY_TAG_CATEGORY_DEMON;
+    if (entity_type_is_elder_variant(type))
+        tags |= ENTITY_TAG_ELDER_VARIANT;
+    return tags;
+}
+
+/** Resolves the trait tags, elder variants and offspring types of every registered type. */
+static void entity_build_type_relations(EntitySystem* sys)
+{
+    for (int i = 0; i < sys->typeCount; ++i)
+        sys->types[i].relationTags = entity_type_relation_tags(&sys->types[i]);
+
+    for (int i = 0; i < sys->typeCount; ++i)
+    {
+        EntityType*       type      = &sys->types[i];
+        const EntityType* offspring = behavior_resolve_offspring_type(sys, type);
+        type->elderTypeIndex        = entity_find_elder_variant(sys, type);
+        type->offspringTypeIndex    = offspring ? (int)(offspring - sys->types) : -1;
+    }
+}
+
 static void entity_assign_builtin_behaviours(EntitySystem* sys)
 {
     if (!sys)
@@ -435,13 +614,13 @@ static void entity_assign_builtin_behaviours(EntitySystem* sys)
         if (!type)
             continue;
 
-        if (entity_type_has_trait(type, "cannibal"))
+        if (type->relationTags & ENTITY_TAG_TRAIT_CANNIBAL)
         {
             type->behavior = entity_cannibal_behavior();
             continue;
         }
 
-        if (entity_type_has_trait(type, "undead"))
+        if (type->relationTags & ENTITY_TAG_TRAIT_UNDEAD)
         {
             type->behavior = entity_zombie_behavior();
             continue;
@@ -526,7 +705,8 @@ bool entity_system_register_type(EntitySystem* sys, const EntityType* def, const
         dst = &sys->types[sys->typeCount++];
     }
 
-    *dst = *def;
+    *dst                       = *def;
+    sys->typeSlotById[dst->id] = (uint8_t)(dst - sys->types + 1);
     if (dst->traitCount < 0)
         dst->traitCount = 0;
     if (dst->traitCount > ENTITY_MAX_TRAITS)
@@ -630,10 +810,10 @@ static bool entity_schedule_near_structures(EntitySystem* sys, const EntitySpawn
         return false;
 
     bool spawnedAny = false;
-    int total = building_total_count();
+    int total = building_total_count(sys->buildings);
     for (int b = 0; b < total; ++b)
     {
-        const Building* building = building_get(b);
+        const Building* building = building_get(sys->buildings, b);
         if (!building || building->structureKind != rule->type->referredStructure)
             continue;
 
@@ -669,9 +849,7 @@ static bool entity_schedule_near_structures(EntitySystem* sys, const EntitySpawn
                                                      rule->type->referredStructure,
                                                      building->id,
                                                      building->villageId,
-                                                     speciesId,
-                                                     0.0f,
-                                                     0.0f);
+                                                     speciesId);
                 spawnedAny |= placed;
             }
 
@@ -684,9 +862,7 @@ static bool entity_schedule_near_structures(EntitySystem* sys, const EntitySpawn
                                                 rule->type->referredStructure,
                                                 building->id,
                                                 building->villageId,
-                                                speciesId,
-                                                0.0f,
-                                                0.0f))
+                                                speciesId))
                     spawnedAny = true;
             }
         }
@@ -695,6 +871,223 @@ static bool entity_schedule_near_structures(EntitySystem* sys, const EntitySpawn
     return spawnedAny;
 }
 
+// -----------------------------------------------------------------------------
+// Initial population seeding
+// -----------------------------------------------------------------------------
+
+/** Map tile indices (y * width + x) grouped by tile type with a counting sort. */
+typedef struct SpawnCandidates
+{
+    int* tiles;
+    int  typeStart[TILE_MAX + 1];
+} SpawnCandidates;
+
+typedef struct SeedSpawn
+{
+    Vector2 position;
+    int     group; /**< Group index within the rule; a failed reservation skips the rest of it. */
+} SeedSpawn;
+
+typedef struct SeedRuleOutput
+{
+    SeedSpawn* spawns;
+    int        count;
+    int        capacity;
+} SeedRuleOutput;
+
+typedef struct SeedJob
+{
+    const EntitySystem*    sys;
+    const Map*             map;
+    const SpawnCandidates* candidates;
+    SeedRuleOutput*        outputs;
+    uint64_t               seed;
+} SeedJob;
+
+static bool spawn_candidates_build(SpawnCandidates* c, const Map* map)
+{
+    memset(c, 0, sizeof(*c));
+    c->tiles = (int*)malloc((size_t)map->width * (size_t)map->height * sizeof(int));
+    if (!c->tiles)
+        return false;
+
+    int counts[TILE_MAX] = {0};
+    for (int y = 0; y < map->height; ++y)
+        for (int x = 0; x < map->width; ++x)
+            if (map->tiles[y][x] >= 0 && map->tiles[y][x] < TILE_MAX)
+                counts[map->tiles[y][x]]++;
+
+    int cursor[TILE_MAX];
+    for (int t = 0; t < TILE_MAX; ++t)
+    {
+        c->typeStart[t + 1] = c->typeStart[t] + counts[t];
+        cursor[t]           = c->typeStart[t];
+    }
+
+    for (int y = 0; y < map->height; ++y)
+        for (int x = 0; x < map->width; ++x)
+            if (map->tiles[y][x] >= 0 && map->tiles[y][x] < TILE_MAX)
+                c->tiles[cursor[map->tiles[y][x]]++] = y * map->width + x;
+    return true;
+}
+
+static bool seed_output_push(SeedRuleOutput* out, Vector2 position, int group)
+{
+    if (out->count >= out->capacity)
+    {
+        int        capacity = out->capacity ? out->capacity * 2 : 64;
+        SeedSpawn* grown    = (SeedSpawn*)realloc(out->spawns, (size_t)capacity * sizeof(SeedSpawn));
+        if (!grown)
+            return false;
+        out->spawns   = grown;
+        out->capacity = capacity;
+    }
+    out->spawns[out->count++] = (SeedSpawn){position, group};
+    return true;
+}
+
+/**
+ * Samples one tile rule. Matching tiles each spawn with probability
+ * rule->density; instead of rolling every tile, the gap to the next hit is
+ * drawn from the geometric distribution, so the cost follows the number of
+ * spawns rather than the number of tiles.
+ */
+static void seed_tile_rule(const SeedJob* job, int ruleIndex)
+{
+    const EntitySpawnRule* rule = &job->sys->spawnRules[ruleIndex];
+    const Map*             map  = job->map;
+    SeedRuleOutput*        out  = &job->outputs[ruleIndex];
+
+    int types[TILE_MAX];
+    int typeCount = 0;
+    int total     = 0;
+    for (int t = 0; t < TILE_MAX; ++t)
+    {
+        if (rule->tile != TILE_MAX && (TileTypeID)t != rule->tile)
+            continue;
+        if (rule->biome != BIO_MAX && infer_biome_from_tile((TileTypeID)t) != rule->biome)
+            continue;
+        int count = job->candidates->typeStart[t + 1] - job->candidates->typeStart[t];
+        if (count <= 0)
+            continue;
+        types[typeCount++] = t;
+        total += count;
+    }
+    if (total == 0 || rule->density <= 0.0f)
+        return;
+
+    const uint64_t key     = counter_rng_key(job->seed, (uint64_t)ruleIndex);
+    uint64_t       draw    = 0;
+    const double   logMiss = rule->density < 1.0f ? log(1.0 - (double)rule->density) : 0.0;
+
+    long hit   = -1;
+    int  group = 0;
+    for (;;)
+    {
+        if (rule->density >= 1.0f)
+            hit++;
+        else
+        {
+            double u    = 1.0 - (double)counter_rng_unit(key, draw++);
+            double skip = floor(log(u) / logMiss);
+            if (skip >= (double)total)
+                break;
+            hit += 1 + (long)skip;
+        }
+        if (hit >= total)
+            break;
+
+        // Locate the hit inside the concatenated candidate ranges.
+        long local = hit;
+        int  t     = 0;
+        while (local >= job->candidates->typeStart[types[t] + 1] - job->candidates->typeStart[types[t]])
+        {
+            local -= job->candidates->typeStart[types[t] + 1] - job->candidates->typeStart[types[t]];
+            t++;
+        }
+        int tileIndex = job->candidates->tiles[job->candidates->typeStart[types[t]] + local];
+        int x         = tileIndex % map->width;
+        int y         = tileIndex / map->width;
+
+        int members = counter_rng_int(key, draw++, rule->groupMin, rule->groupMax);
+        if (members <= 0)
+            members = 1;
+
+        for (int g = 0; g < members; ++g)
+        {
+            Vector2 spawnPos = {
+                (x + 0.5f) * TILE_SIZE + counter_rng_range(key, draw++, -TILE_SIZE * 0.3f, TILE_SIZE * 0.3f),
+                (y + 0.5f) * TILE_SIZE + counter_rng_range(key, draw++, -TILE_SIZE * 0.3f, TILE_SIZE * 0.3f),
+            };
+            if (!entity_position_is_walkable(map, spawnPos, rule->type->radius))
+                continue;
+            if (!seed_output_push(out, spawnPos, group))
+                return;
+        }
+        group++;
+    }
+}
+
+static void seed_rule_range(void* user, int begin, int end)
+{
+    const SeedJob* job = (const SeedJob*)user;
+    for (int r = begin; r < end; ++r)
+    {
+        const EntitySpawnRule* rule = &job->sys->spawnRules[r];
+        if (rule->type && rule->type->referredStructure == STRUCT_COUNT)
+            seed_tile_rule(job, r);
+    }
+}
+
+/**
+ * Seeds the initial reservations. Tile rules are sampled in parallel into
+ * per-rule buffers; reservations are then committed serially in rule order
+ * (structure rules included) so the result never depends on the thread count.
+ */
+static void entity_seed_population(EntitySystem* sys, const Map* map)
+{
+    SpawnCandidates candidates = {0};
+    SeedRuleOutput* outputs = (SeedRuleOutput*)calloc((size_t)(sys->spawnRuleCount > 0 ? sys->spawnRuleCount : 1), sizeof(SeedRuleOutput));
+    if (!outputs || !spawn_candidates_build(&candidates, map))
+    {
+        printf("❌ Not enough memory to seed the initial population.\n");
+        free(outputs);
+        free(candidates.tiles);
+        return;
+    }
+
+    SeedJob job = {sys, map, &candidates, outputs, counter_rng_key(sys->rngState, 0x5EEDu)};
+    jobs_parallel_for(sys->spawnRuleCount, 1, seed_rule_range, &job);
+
+    for (int r = 0; r < sys->spawnRuleCount; ++r)
+    {
+        const EntitySpawnRule* rule = &sys->spawnRules[r];
+        if (!rule->type)
+            continue;
+
+        if (rule->type->referredStructure != STRUCT_COUNT)
+        {
+            entity_schedule_near_structures(sys, rule, map);
+            continue;
+        }
+
+        int skipGroup = -1;
+        for (int i = 0; i < outputs[r].count; ++i)
+        {
+            const SeedSpawn* spawn = &outputs[r].spawns[i];
+            if (spawn->group == skipGroup)
+                continue;
+            if (!entity_reservation_schedule(sys, rule->type->id, spawn->position, spawn->position, STRUCT_COUNT, -1, -1, rule->type->speciesId))
+                skipGroup = spawn->group;
+        }
+    }
+
+    for (int r = 0; r < sys->spawnRuleCount; ++r)
+        free(outputs[r].spawns);
+    free(outputs);
+    free(candidates.tiles);
+}
+
 typedef struct ResidentDemand
 {
     EntitiesTypeID typeId;
@@ -830,14 +1223,14 @@ static void entity_rebuild_building_occupancy(EntitySystem* sys)
     if (!sys)
         return;
 
-    int totalBuildings = building_total_count();
+    int totalBuildings = building_total_count(sys->buildings);
     if (totalBuildings <= 0)
         return;
 
     int maxId = 0;
     for (int b = 0; b < totalBuildings; ++b)
     {
-        Building* building = building_get_mutable(b);
+        Building* building = building_get_mutable(sys->buildings, b);
         if (!building)
             continue;
 
@@ -857,7 +1250,7 @@ static void entity_rebuild_building_occupancy(EntitySystem* sys)
 
     for (int b = 0; b < totalBuildings; ++b)
     {
-        Building* building = building_get_mutable(b);
+        Building* building = building_get_mutable(sys->buildings, b);
         if (!building)
             continue;
         if (building->id < 0 || building->id > maxId)
@@ -907,11 +1300,15 @@ static bool entity_schedule_resident(EntitySystem* sys, const Map* map, Building
     bool   placed   = false;
     Vector2 spawnPos = home;
 
+    // Residents already housed or pending number the draws, so several
+    // schedules for one building in the same tick land apart.
+    uint64_t key  = entity_rng_key(sys, (uint32_t)building->id, ENTITY_RNG_RESIDENT_SCATTER);
+    uint64_t draw = (uint64_t)(building->residentCount + entity_count_pending_reservations(sys, building->id, ENTITY_TYPE_INVALID)) * 16u;
+
     for (int attempt = 0; attempt < 8 && !placed; ++attempt)
     {
-        unsigned int seed = entity_random(sys);
-        float angle       = ((float)(seed & 0xFFFFu) / 65535.0f) * 2.0f * PI;
-        float dist        = 0.35f + ((float)((seed >> 16) & 0xFFFFu) / 65535.0f) * 1.8f;
+        float angle       = counter_rng_range(key, draw++, 0.0f, 2.0f * PI);
+        float dist        = counter_rng_range(key, draw++, 0.35f, 2.15f);
         spawnPos          = (Vector2){home.x + cosf(angle) * dist * TILE_SIZE, home.y + sinf(angle) * dist * TILE_SIZE};
 
         if (!entity_position_is_walkable(map, spawnPos, type->radius))
@@ -924,9 +1321,7 @@ static bool entity_schedule_resident(EntitySystem* sys, const Map* map, Building
                                              building->structureKind,
                                              building->id,
                                              building->villageId,
-                                             speciesId,
-                                             0.0f,
-                                             0.0f);
+                                             speciesId);
     }
 
     if (!placed)
@@ -965,9 +1360,7 @@ static bool entity_schedule_resident(EntitySystem* sys, const Map* map, Building
                                                      building->structureKind,
                                                      building->id,
                                                      building->villageId,
-                                                     speciesId,
-                                                     0.0f,
-                                                     0.0f);
+                                                     speciesId);
             }
         }
     }
@@ -981,9 +1374,7 @@ static bool entity_schedule_resident(EntitySystem* sys, const Map* map, Building
                                              building->structureKind,
                                              building->id,
                                              building->villageId,
-                                             speciesId,
-                                             0.0f,
-                                             0.0f);
+                                             speciesId);
     }
 
     return placed;
@@ -994,10 +1385,10 @@ static void entity_schedule_structure_residents(EntitySystem* sys, const Map* ma
     if (!sys || !map)
         return;
 
-    int total = building_total_count();
+    int total = building_total_count(sys->buildings);
     for (int b = 0; b < total; ++b)
     {
-        Building* building = building_get_mutable(b);
+        Building* building = building_get_mutable(sys->buildings, b);
         if (!building || !building->structureDef)
             continue;
         if (!refreshing)
@@ -1031,7 +1422,7 @@ static void entity_schedule_structure_residents(EntitySystem* sys, const Map* ma
                 if (!candidate)
                     break;
                 building_add_resident(building, candidate);
-                building_on_reservation_spawn(building->id);
+                building_on_reservation_spawn(sys->buildings, building->id);
                 needed--;
             }
 
@@ -1045,7 +1436,7 @@ static void entity_schedule_structure_residents(EntitySystem* sys, const Map* ma
     }
 }
 
-static void entity_stream_reservations(EntitySystem* sys, const Map* map, const Camera2D* camera)
+static void entity_stream_reservations(EntitySystem* sys, const Map* map, const Camera2D* camera, const CameraMotion* motion)
 {
     if (!sys)
         return;
@@ -1061,23 +1452,43 @@ static void entity_stream_reservations(EntitySystem* sys, const Map* map, const
     float halfW             = viewWidth * 0.5f;
     float halfH             = viewHeight * 0.5f;
     float baseRadius        = sqrtf(halfW * halfW + halfH * halfH);
+    sys->streamActivationPadding   = TILE_SIZE * tunable_get(TUNABLE_STREAM_ACTIVATION_PADDING);
+    sys->streamDeactivationPadding = TILE_SIZE * tunable_get(TUNABLE_STREAM_DEACTIVATION_PADDING);
     float defaultActivation   = baseRadius + sys->streamActivationPadding;
     float defaultDeactivation = baseRadius + sys->streamDeactivationPadding;
 
+    // Wake entities where the camera is heading too, and keep them until both
+    // the current and the predicted view have left them behind.
+    Vector2 aheadFocus = focus;
+    float   aheadScale = 1.0f;
+    if (camera)
+    {
+        Camera2D ahead = camera_predict(camera, motion, tunable_get(TUNABLE_CAMERA_PREFETCH_SECONDS));
+        aheadFocus     = ahead.target;
+        aheadScale     = zoom / ahead.zoom;
+    }
+    float aheadActivation   = baseRadius * aheadScale + sys->streamActivationPadding;
+    float aheadDeactivation = baseRadius * aheadScale + sys->streamDeactivationPadding;
+
     for (int i = 0; i < sys->reservationCount; ++i)
     {
         EntityReservation* res = &sys->reservations[i];
         if (!res->used)
             continue;
 
-        float activationRadius   = (res->activationRadius > 0.0f) ? res->activationRadius : defaultActivation;
-        float deactivationRadius = (res->deactivationRadius > 0.0f) ? res->deactivationRadius : defaultDeactivation;
-        float activationSq       = activationRadius * activationRadius;
-        float deactivationSq     = deactivationRadius * deactivationRadius;
+        float activationSq   = defaultActivation * defaultActivation;
+        float deactivationSq = defaultDeactivation * defaultDeactivation;
 
-        float distSq = entity_distance_sq(res->position, focus);
+        // While resident the live entity is authoritative; the record is only
+        // written back when it hibernates.
+        const Entity* live        = res->active ? entity_get(sys, res->entityId) : NULL;
+        Vector2       position    = live ? live->position : res->position;
+        float         distSq      = entity_distance_sq(position, focus);
+        float         aheadDistSq = entity_distance_sq(position, aheadFocus);
+        bool          wanted      = distSq <= activationSq || aheadDistSq <= aheadActivation * aheadActivation;
+        bool          released    = distSq >= deactivationSq && aheadDistSq >= aheadDeactivation * aheadDeactivation;
 
-        if (!res->active && distSq <= activationSq)
+        if (!res->active && wanted)
         {
             const EntityType* type = entity_find_type(sys, res->typeId);
             if (!type)
@@ -1102,29 +1513,19 @@ static void entity_stream_reservations(EntitySystem* sys, const Map* map, const
             ent->reservationIndex  = i;
             if (res->hp <= 0 && type->maxHP > 0)
                 res->hp = type->maxHP;
-            entity_reservation_apply(res, ent);
+            entity_reservation_restore(res, ent);
             ent->hp = (res->hp > 0) ? res->hp : ent->hp;
             if (res->buildingId >= 0)
             {
-                Building* home = building_get_mutable(res->buildingId);
+                Building* home = building_get_mutable(sys->buildings, res->buildingId);
                 if (home)
                     building_add_resident(home, ent);
-                building_on_reservation_spawn(res->buildingId);
+                building_on_reservation_spawn(sys->buildings, res->buildingId);
             }
         }
-        else if (res->active && distSq >= deactivationSq)
+        else if (res->active && released)
         {
-            Entity* ent = entity_acquire(sys, res->entityId);
-            if (ent)
-            {
-                entity_reservation_capture(res, ent);
-                ent->reservationIndex = -1;
-            }
-
-            if (res->buildingId >= 0)
-                building_on_reservation_hibernate(res->buildingId);
-
-            entity_despawn(sys, res->entityId);
+            entity_remove(sys, res->entityId, res);
             res->entityId = ENTITY_ID_INVALID;
             res->active   = false;
         }
@@ -1135,13 +1536,16 @@ static void entity_stream_reservations(EntitySystem* sys, const Map* map, const
 // Core system operations
 // -----------------------------------------------------------------------------
 
-bool entity_system_init(EntitySystem* sys, const Map* map, unsigned int seed, const char* definitionsPath)
+bool entity_system_init(EntitySystem* sys, Map* map, unsigned int seed, const char* definitionsPath)
 {
     if (!sys)
         return false;
 
     entity_system_reset(sys);
+    sys->buildings = map ? &map->buildings : NULL;
+    path_telemetry_reset(&sys->pathTelemetry);
     sys->rngState = seed ? seed : 0xCAFEBABEu;
+    sys->rngSeed  = counter_rng_mix(sys->rngState);
 
     bool loaded = false;
     if (definitionsPath)
@@ -1153,6 +1557,7 @@ bool entity_system_init(EntitySystem* sys, const Map* map, unsigned int seed, co
         entity_register_fallbacks(sys);
     }
 
+    entity_build_type_relations(sys);
     entity_assign_builtin_behaviours(sys);
 
     if (map)
@@ -1163,64 +1568,7 @@ bool entity_system_init(EntitySystem* sys, const Map* map, unsigned int seed, co
                 sys->spawnRules[i].type = entity_find_type(sys, sys->spawnRules[i].id);
         }
 
-        for (int r = 0; r < sys->spawnRuleCount; ++r)
-        {
-            const EntitySpawnRule* rule = &sys->spawnRules[r];
-            if (!rule->type)
-                continue;
-
-            if (rule->type->referredStructure != STRUCT_COUNT)
-            {
-                entity_schedule_near_structures(sys, rule, map);
-                continue;
-            }
-
-            for (int y = 0; y < map->height; ++y)
-            {
-                for (int x = 0; x < map->width; ++x)
-                {
-                    TileTypeID tid = map->tiles[y][x];
-                    if (rule->tile != TILE_MAX && tid != rule->tile)
-                        continue;
-
-                    if (rule->biome != BIO_MAX)
-                    {
-                        BiomeKind b = infer_biome_from_tile(tid);
-                        if (b != rule->biome)
-                            continue;
-                    }
-
-                    float roll = entity_randomf(sys, 0.0f, 1.0f);
-                    if (roll > rule->density)
-                        continue;
-
-                    int group = entity_randomi(sys, rule->groupMin, rule->groupMax);
-                    if (group <= 0)
-                        group = 1;
-
-                    for (int g = 0; g < group; ++g)
-                    {
-                        Vector2 spawnPos = {
-                            (x + 0.5f) * TILE_SIZE + entity_randomf(sys, -TILE_SIZE * 0.3f, TILE_SIZE * 0.3f),
-                            (y + 0.5f) * TILE_SIZE + entity_randomf(sys, -TILE_SIZE * 0.3f, TILE_SIZE * 0.3f),
-                        };
-                        if (!entity_position_is_walkable(map, spawnPos, rule->type->radius))
-                            continue;
-                        if (!entity_reservation_schedule(sys,
-                                                         rule->type->id,
-                                                         spawnPos,
-                                                         spawnPos,
-                                                         STRUCT_COUNT,
-                                                         -1,
-                                                         -1,
-                                                         rule->type->speciesId,
-                                                         0.0f,
-                                                         0.0f))
-                            break;
-                    }
-                }
-            }
-        }
+        entity_seed_population(sys, map);
 
         entity_schedule_structure_residents(sys, map, false);
     }
@@ -1245,6 +1593,8 @@ void entity_system_shutdown(EntitySystem* sys)
     for (int t = 0; t < sys->typeCount; ++t)
         entity_unload_sprite(&sys->types[t].sprite);
 
+    light_schedule_reset(&sys->lights);
+    pathfinding_track_reset(&sys->pathTracks);
     entity_system_reset(sys);
 }
 
@@ -1344,57 +1694,91 @@ static void entity_draw_affection(const Entity* e)
     DrawTriangle(bottomA, bottomB, bottomC, heartColor);
 }
 
-void entity_system_update(EntitySystem* sys, const Map* map, const Camera2D* camera, float dt)
+/**
+ * @brief Runs one entity's whole step: needs and ageing, its behaviour, then timers.
+ *
+ * Each entity finishes before the next one starts, so what an entity sees of
+ * its neighbours does not depend on how the step is split into phases.
+ */
+static void entity_step(EntitySystem* sys, Entity* e, const Map* map, float dt, float dtDays)
+{
+    if (!e->active)
+        return;
+
+    behavior_hunger_update(sys, e, (Map*)map);
+    if (!e->active)
+        return;
+
+    behavior_eat_if_hungry(e);
+    if (!e->active)
+        return;
+
+    if (dtDays > 0.0f)
+    {
+        age_update(e, dtDays);
+        if (!e->active)
+            return;
+    }
+
+    // Ageing may have switched the behaviour (elder promotion); the new one runs now.
+    if (e->behavior && e->behavior->onUpdate)
+        e->behavior->onUpdate(sys, e, map, dt);
+    if (!e->active)
+        return;
+
+    entity_update_behavior_timers(e, dt);
+    entity_update_animation(e, dt);
+}
+
+void entity_system_update(EntitySystem* sys, const Map* map, const WorldTime* time, const Camera2D* camera, const CameraMotion* motion, float dt)
 {
     if (!sys)
         return;
 
-    entity_stream_reservations(sys, map, camera);
+    sys->time = time;
+    sys->tick++;
+    entity_stream_reservations(sys, map, camera, motion);
     entity_rebuild_building_occupancy(sys);
 
     sys->residentRefreshTimer += dt;
-    if (sys->residentRefreshTimer >= 5.0f)
+    if (sys->residentRefreshTimer >= tunable_get(TUNABLE_RESIDENT_REFRESH_INTERVAL) && frame_budget_allow(FRAME_TASK_RESIDENT_REFRESH))
     {
         entity_schedule_structure_residents(sys, map, true);
         sys->residentRefreshTimer = 0.0f;
     }
 
-    float dtDays = entity_sim_days_step();
+    float dtDays = entity_sim_days_step(sys);
 
-    for (int i = 0; i <= sys->highestIndex; ++i)
-    {
-        Entity* e = &sys->entities[i];
-        if (!e->active)
-            continue;
-
-        behavior_hunger_update(sys, e, (Map*)map);
-        if (!e->active)
-            continue;
+    // Each bucket is snapshotted before it runs: entities spawned, promoted or
+    // killed meanwhile only change which later bucket (if any) sees them, and the
+    // stamp keeps anyone from being updated twice in one step.
+    uint16_t* batch   = sys->updateBatch;
+    uint8_t*  updated = sys->updated;
+    memset(sys->updated, 0, sizeof(sys->updated));
 
-        behavior_eat_if_hungry(e);
-        if (!e->active)
-            continue;
+    for (int b = 0; b < sys->behaviorBucketCount; ++b)
+    {
+        const EntityBehaviorBucket* bucket = &sys->behaviorBuckets[b];
+        int                         count  = 0;
 
-        if (dtDays > 0.0f)
+        for (int k = 0; k < bucket->count; ++k)
         {
-            age_update(e, dtDays);
-            if (!e->active)
-                continue;
+            uint16_t id = bucket->ids[k];
+            if (!updated[id])
+                batch[count++] = id;
         }
 
-        if (e->behavior && e->behavior->onUpdate)
-            e->behavior->onUpdate(sys, e, map, dt);
-
-        entity_update_behavior_timers(e, dt);
-        entity_update_animation(e, dt);
-
-        if (e->reservationIndex >= 0 && e->reservationIndex < sys->reservationCount)
+        for (int k = 0; k < count; ++k)
         {
-            EntityReservation* res = &sys->reservations[e->reservationIndex];
-            if (res->used && res->active && res->entityId == e->id)
-                entity_reservation_capture(res, e);
+            Entity* e      = &sys->entities[batch[k]];
+            updated[e->id] = 1;
+            entity_step(sys, e, map, dt, dtDays);
         }
     }
+
+    // Doors opened by this step's movers close (or stay open) in one batch.
+    door_controller_update(&sys->doors, sys, (Map*)map, dt);
+    light_schedule_update(&sys->lights, sys, (Map*)map);
 }
 
 void entity_system_draw(const EntitySystem* sys)
@@ -1415,7 +1799,7 @@ void entity_system_draw(const EntitySystem* sys)
         {
             int       frameWidth  = sprite->frameWidth;
             int       frameHeight = sprite->frameHeight;
-            Rectangle src         = {(float)(frameWidth * e->animFrame), 0.0f, (float)frameWidth, (float)frameHeight};
+            Rectangle src         = sprite->frameRects[(unsigned)e->animFrame < (unsigned)sprite->frameCount ? e->animFrame : 0];
             Rectangle dst         = {e->position.x, e->position.y, (float)frameWidth, (float)frameHeight};
             Vector2   origin      = sprite->origin;
             if (origin.x == 0.0f && origin.y == 0.0f)
@@ -1498,6 +1882,7 @@ uint16_t entity_spawn(EntitySystem* sys, EntitiesTypeID typeId, Vector2 position
             printf("⚠️  Behaviour '%s' requires %zu bytes, but only %d are available\n", type->identifier, e->behavior->brainSize, ENTITY_BRAIN_BYTES);
         }
 
+        entity_bucket_add(sys, e);
         if (e->behavior && e->behavior->onSpawn)
             e->behavior->onSpawn(sys, e);
 
@@ -1511,7 +1896,13 @@ uint16_t entity_spawn(EntitySystem* sys, EntitiesTypeID typeId, Vector2 position
     return ENTITY_ID_INVALID;
 }
 
-void entity_despawn(EntitySystem* sys, uint16_t id)
+/**
+ * Shared teardown of despawn and hibernation. With @p hibernateInto the
+ * resident's state is archived into its record once the behaviour has let go
+ * of its shared resources (path tracks), so the archived brain holds no live
+ * handles.
+ */
+static void entity_remove(EntitySystem* sys, uint16_t id, EntityReservation* hibernateInto)
 {
     if (!sys || id >= MAX_ENTITIES)
         return;
@@ -1523,15 +1914,37 @@ void entity_despawn(EntitySystem* sys, uint16_t id)
     if (e->behavior && e->behavior->onDespawn)
         e->behavior->onDespawn(sys, e);
 
+    if (hibernateInto)
+    {
+        entity_reservation_archive(hibernateInto, e);
+        e->reservationIndex = -1;
+        if (hibernateInto->buildingId >= 0)
+            building_on_reservation_hibernate(sys->buildings, hibernateInto->buildingId);
+    }
+
+    // A resident that dies takes its persistent record with it (hibernation
+    // detaches the record before despawning).
+    if (e->reservationIndex >= 0 && e->reservationIndex < sys->reservationCount)
+    {
+        EntityReservation* res = &sys->reservations[e->reservationIndex];
+        if (res->used && res->active && res->entityId == e->id)
+        {
+            if (e->homeBuildingId >= 0)
+                building_on_reservation_hibernate(sys->buildings, e->homeBuildingId);
+            entity_reservation_reset(res);
+        }
+    }
+
     if (e->homeBuildingId >= 0)
     {
-        Building* home = building_get_mutable(e->homeBuildingId);
+        Building* home = building_get_mutable(sys->buildings, e->homeBuildingId);
         if (home)
             building_remove_resident(home, e->id);
         e->homeBuildingId = -1;
         e->villageId      = -1;
     }
 
+    entity_bucket_remove(sys, e);
     e->active = false;
     e->reservationIndex = -1;
     sys->activeCount--;
@@ -1545,6 +1958,11 @@ void entity_despawn(EntitySystem* sys, uint16_t id)
     }
 }
 
+void entity_despawn(EntitySystem* sys, uint16_t id)
+{
+    entity_remove(sys, id, NULL);
+}
+
 Entity* entity_acquire(EntitySystem* sys, uint16_t id)
 {
     if (!sys || id >= MAX_ENTITIES)
@@ -1563,15 +1981,11 @@ const Entity* entity_get(const EntitySystem* sys, uint16_t id)
 
 const EntityType* entity_find_type(const EntitySystem* sys, EntitiesTypeID typeId)
 {
-    if (!sys || typeId <= ENTITY_TYPE_INVALID)
+    if (!sys || typeId <= ENTITY_TYPE_INVALID || typeId >= ENTITY_TYPE_COUNT)
         return NULL;
 
-    for (int i = 0; i < sys->typeCount; ++i)
-    {
-        if (sys->types[i].id == typeId)
-            return &sys->types[i];
-    }
-    return NULL;
+    int slot = sys->typeSlotById[typeId];
+    return slot > 0 ? &sys->types[slot - 1] : NULL;
 }
 
 int entity_system_type_count(const EntitySystem* sys)
@@ -1633,58 +2047,17 @@ bool entity_is_category(const Entity* entity, const char* category)
     return entity && entity->type ? entity_type_is_category(entity->type, category) : false;
 }
 
-static bool entity_type_is_elder_variant(const EntityType* type)
-{
-    if (!type)
-        return false;
-    if (entity_type_has_trait(type, "elder"))
-        return true;
-    if (type->identifier[0] != '\0' && strstr(type->identifier, "elder"))
-        return true;
-    if (type->displayName[0] != '\0' && strstr(type->displayName, "Elder"))
-        return true;
-    return false;
-}
-
-static const EntityType* entity_find_elder_variant(const Entity* entity)
-{
-    if (!entity || !entity->system || !entity->type)
-        return NULL;
-
-    const EntitySystem* sys       = entity->system;
-    const EntityType*   baseType  = entity->type;
-    int                  speciesId = baseType->speciesId;
-    const EntityType*   fallback  = NULL;
-
-    for (int i = 0; i < sys->typeCount; ++i)
-    {
-        const EntityType* candidate = &sys->types[i];
-        if (candidate == baseType)
-            continue;
-        if (speciesId > 0 && candidate->speciesId != speciesId)
-            continue;
-        if (!entity_type_is_elder_variant(candidate))
-            continue;
-        if (!fallback)
-            fallback = candidate;
-        if (baseType->speciesId > 0 && candidate->speciesId == baseType->speciesId)
-            return candidate;
-    }
-
-    return fallback;
-}
-
 void entity_promote_to_elder(Entity* entity)
 {
     if (!entity || entity->isElder)
         return;
 
-    const EntityType* elderType = entity_find_elder_variant(entity);
+    const EntityType* elderType = entity->type ? entity_system_type_at(entity->system, entity->type->elderTypeIndex) : NULL;
     if (!elderType)
         return;
 
-    entity->type      = elderType;
-    entity->behavior  = elderType->behavior;
+    entity->type = elderType;
+    entity_set_behavior(entity, elderType->behavior);
     entity->hp        = (elderType->maxHP > 0) ? elderType->maxHP : entity->hp;
     entity->sex       = (elderType->sex != ENTITY_SEX_UNDEFINED) ? elderType->sex : entity->sex;
     entity->speciesId = (elderType->speciesId > 0) ? elderType->speciesId : entity->speciesId;
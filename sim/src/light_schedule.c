@@ -0,0 +1,195 @@
+/**
+ * @file light_schedule.c
+ * @brief Implements light ownership collection and staggered dusk/dawn switching.
+ */
+
+#include "light_schedule.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "behavior.h"
+#include "building.h"
+#include "entity.h"
+#include "map.h"
+#include "object.h"
+
+static bool is_light_type(const ObjectType* type)
+{
+    return type && type->activatable && (type->lightLevel > 0 || type->lightRadius > 0);
+}
+
+static bool light_push(LightSchedule* schedule, ScheduledLight light)
+{
+    if (schedule->count == schedule->capacity)
+    {
+        int             capacity = schedule->capacity ? schedule->capacity * 2 : 64;
+        ScheduledLight* grown    = (ScheduledLight*)realloc(schedule->lights, (size_t)capacity * sizeof(ScheduledLight));
+        if (!grown)
+            return false;
+        schedule->lights   = grown;
+        schedule->capacity = capacity;
+    }
+    schedule->lights[schedule->count++] = light;
+    return true;
+}
+
+/** Records the lights inside every building and on its walls. */
+static void light_collect(LightSchedule* schedule, const Map* map)
+{
+    schedule->count = 0;
+    if (++schedule->seenStamp == 0)
+    {
+        memset(schedule->seen, 0, sizeof(schedule->seen));
+        schedule->seenStamp = 1;
+    }
+
+    int total = building_total_count(&map->buildings);
+    for (int i = 0; i < total; ++i)
+    {
+        const Building* b = building_get(&map->buildings, i);
+        if (!b)
+            continue;
+
+        int x0 = (int)b->bounds.x - 1;
+        int y0 = (int)b->bounds.y - 1;
+        int x1 = (int)(b->bounds.x + b->bounds.width) + 1;
+        int y1 = (int)(b->bounds.y + b->bounds.height) + 1;
+        if (x0 < 0)
+            x0 = 0;
+        if (y0 < 0)
+            y0 = 0;
+        if (x1 > map->width)
+            x1 = map->width;
+        if (y1 > map->height)
+            y1 = map->height;
+
+        for (int y = y0; y < y1; ++y)
+        {
+            for (int x = x0; x < x1; ++x)
+            {
+                if (schedule->seen[y][x] == schedule->seenStamp)
+                    continue;
+                const Object* obj = map_object_record(map, x, y);
+                if (!obj || !is_light_type(obj->type))
+                    continue;
+                schedule->seen[y][x] = schedule->seenStamp;
+                light_push(schedule, (ScheduledLight){x, y, i, b->villageId, false});
+            }
+        }
+    }
+}
+
+static bool building_has_lighter(const EntitySystem* sys, const Building* b)
+{
+    const EntityType* occupant = entity_find_type(sys, b->occupantType);
+    if (occupant && entity_type_has_competence(occupant, ENTITY_COMPETENCE_LIGHT_AT_NIGHT))
+        return true;
+
+    for (int r = 0; r < b->residentCount; ++r)
+    {
+        const Entity* e = entity_get(sys, b->residents[r]);
+        if (e && e->active && e->type && entity_type_has_competence(e->type, ENTITY_COMPETENCE_LIGHT_AT_NIGHT))
+            return true;
+    }
+    return false;
+}
+
+static int compare_ints(const void* a, const void* b)
+{
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/** Decides which lights the next transition switches, from current residents. */
+static void light_refresh_management(LightSchedule* schedule, const EntitySystem* sys)
+{
+    int   total        = sys ? building_total_count(sys->buildings) : 0;
+    bool* lit          = total > 0 ? (bool*)calloc((size_t)total, sizeof(bool)) : NULL;
+    int*  litVillages  = total > 0 ? (int*)malloc((size_t)total * sizeof(int)) : NULL;
+    int   villageCount = 0;
+
+    // Lights of a village are tended by any of its lighters: gather the villages
+    // with at least one lit building once, then each light is a lookup.
+    for (int i = 0; i < total && lit && litVillages && sys; ++i)
+    {
+        const Building* b = building_get(sys->buildings, i);
+        lit[i]            = b && building_has_lighter(sys, b);
+        if (lit[i] && b->villageId >= 0)
+            litVillages[villageCount++] = b->villageId;
+    }
+    if (villageCount > 1)
+        qsort(litVillages, (size_t)villageCount, sizeof(int), compare_ints);
+
+    for (int l = 0; l < schedule->count; ++l)
+    {
+        ScheduledLight* light = &schedule->lights[l];
+        light->managed        = lit && light->buildingIndex < total && lit[light->buildingIndex];
+        if (!light->managed && villageCount > 0 && light->villageId >= 0)
+            light->managed = bsearch(&light->villageId, litVillages, (size_t)villageCount, sizeof(int), compare_ints) != NULL;
+    }
+
+    free(litVillages);
+    free(lit);
+}
+
+void light_schedule_reset(LightSchedule* schedule)
+{
+    if (!schedule)
+        return;
+    free(schedule->lights);
+    schedule->lights    = NULL;
+    schedule->count     = 0;
+    schedule->capacity  = 0;
+    schedule->collected = false;
+    schedule->night     = false;
+    schedule->cursor    = 0;
+}
+
+void light_schedule_update(LightSchedule* schedule, const EntitySystem* sys, Map* map)
+{
+    if (!schedule || !map)
+        return;
+
+    unsigned int generation = building_detection_generation(&map->buildings);
+    bool         night      = behavior_is_night(sys, LIGHT_SCHEDULE_NIGHT_THRESHOLD);
+
+    if (!schedule->collected || generation != schedule->generation)
+    {
+        light_collect(schedule, map);
+        schedule->collected  = true;
+        schedule->generation = generation;
+        schedule->night      = night;
+        light_refresh_management(schedule, sys);
+        schedule->cursor = 0;
+    }
+    else if (night != schedule->night)
+    {
+        schedule->night = night;
+        light_refresh_management(schedule, sys);
+        schedule->cursor = 0;
+    }
+
+    // Stagger the transition: only a few lights actually switch per step.
+    int budget = LIGHT_SCHEDULE_LIGHTS_PER_STEP;
+    while (schedule->cursor < schedule->count && budget > 0)
+    {
+        const ScheduledLight* light = &schedule->lights[schedule->cursor++];
+        if (!light->managed)
+            continue;
+
+        Object* obj = map_object_record(map, light->x, light->y);
+        if (!obj || !is_light_type(obj->type) || obj->isActive == schedule->night)
+            continue;
+
+        if (object_set_active(map, obj, schedule->night))
+            budget--;
+    }
+}
+
+int light_schedule_light_count(const LightSchedule* schedule)
+{
+    return schedule ? schedule->count : 0;
+}
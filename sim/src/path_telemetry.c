@@ -0,0 +1,302 @@
+/**
+ * @file path_telemetry.c
+ * @brief Implements pathfinding query recording, aggregates, CSV export and heatmap.
+ */
+
+#include "path_telemetry.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Weight of the newest query in the rolling averages. */
+#define PATH_TELEMETRY_SMOOTHING 0.05f
+/** Minimum delay between two overlay texture rebuilds (seconds). */
+#define PATH_TELEMETRY_OVERLAY_REFRESH 0.5
+
+// -----------------------------------------------------------------------------
+// State
+// -----------------------------------------------------------------------------
+// Render cache of the overlay; only the displayed world is drawn.
+static Texture2D G_OVERLAY_TEXTURE   = {0};
+static Color*    G_OVERLAY_PIXELS    = NULL;
+static double    G_OVERLAY_BUILT_AT  = -1.0;
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+
+static int stats_bucket(EntitiesTypeID requester)
+{
+    return (requester >= 0 && requester < ENTITY_TYPE_COUNT) ? (int)requester + 1 : 0;
+}
+
+static void stats_accumulate(PathTelemetryStats* stats, const PathQueryRecord* record)
+{
+    float alpha = stats->queries > 0 ? PATH_TELEMETRY_SMOOTHING : 1.0f;
+    stats->queries++;
+    stats->results[record->result]++;
+    stats->expandedTotal += record->expanded;
+    stats->durationTotalMs += record->durationMs;
+    if (record->expanded > stats->expandedMax)
+        stats->expandedMax = record->expanded;
+    if (record->durationMs > stats->durationMaxMs)
+        stats->durationMaxMs = record->durationMs;
+    stats->rollingExpanded += ((float)record->expanded - stats->rollingExpanded) * alpha;
+    stats->rollingDurationMs += (record->durationMs - stats->rollingDurationMs) * alpha;
+}
+
+static void bump_tile(uint16_t grid[MAP_HEIGHT][MAP_WIDTH], uint16_t* peak, int x, int y)
+{
+    if (x < 0 || y < 0 || x >= MAP_WIDTH || y >= MAP_HEIGHT)
+        return;
+    if (grid[y][x] < UINT16_MAX)
+        grid[y][x]++;
+    if (grid[y][x] > *peak)
+        *peak = grid[y][x];
+}
+
+static bool result_is_failure(PathQueryResult result)
+{
+    return result != PATH_RESULT_FOUND && result != PATH_RESULT_TRIVIAL;
+}
+
+// -----------------------------------------------------------------------------
+// Recording
+// -----------------------------------------------------------------------------
+
+void path_telemetry_reset(PathTelemetry* telemetry)
+{
+    if (!telemetry)
+        return;
+    memset(telemetry, 0, sizeof(*telemetry));
+    telemetry->overlayDirty = true;
+}
+
+void path_telemetry_note_expansion(PathTelemetry* telemetry, int tileX, int tileY)
+{
+    if (telemetry)
+        bump_tile(telemetry->expansions, &telemetry->expansionPeak, tileX, tileY);
+}
+
+void path_telemetry_record(PathTelemetry* telemetry, const PathQueryRecord* record)
+{
+    if (!telemetry || !record || record->result < 0 || record->result >= PATH_RESULT_COUNT)
+        return;
+
+    telemetry->history[telemetry->historyHead] = *record;
+    telemetry->historyHead                     = (telemetry->historyHead + 1) % PATH_TELEMETRY_HISTORY;
+    if (telemetry->historyCount < PATH_TELEMETRY_HISTORY)
+        telemetry->historyCount++;
+
+    stats_accumulate(&telemetry->totals, record);
+    stats_accumulate(&telemetry->perType[stats_bucket(record->requesterType)], record);
+
+    if (result_is_failure(record->result))
+    {
+        bump_tile(telemetry->failures, &telemetry->failurePeak, record->startX, record->startY);
+        bump_tile(telemetry->failures, &telemetry->failurePeak, record->goalX, record->goalY);
+    }
+    telemetry->overlayDirty = true;
+}
+
+const PathTelemetryStats* path_telemetry_totals(const PathTelemetry* telemetry)
+{
+    return telemetry ? &telemetry->totals : NULL;
+}
+
+const PathTelemetryStats* path_telemetry_stats_for(const PathTelemetry* telemetry, EntitiesTypeID requester)
+{
+    return telemetry ? &telemetry->perType[stats_bucket(requester)] : NULL;
+}
+
+const char* path_telemetry_result_name(PathQueryResult result)
+{
+    switch (result)
+    {
+        case PATH_RESULT_FOUND:
+            return "found";
+        case PATH_RESULT_TRIVIAL:
+            return "trivial";
+        case PATH_RESULT_BLOCKED_ENDPOINT:
+            return "blocked_endpoint";
+        case PATH_RESULT_WINDOW_TOO_LARGE:
+            return "window_too_large";
+        case PATH_RESULT_EXHAUSTED:
+            return "exhausted";
+        default:
+            return "unknown";
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Export
+// -----------------------------------------------------------------------------
+
+static void print_stats_line(const char* label, const PathTelemetryStats* stats)
+{
+    int   failures = stats->queries - stats->results[PATH_RESULT_FOUND] - stats->results[PATH_RESULT_TRIVIAL];
+    float avgExp   = stats->queries > 0 ? (float)stats->expandedTotal / (float)stats->queries : 0.0f;
+    float avgMs    = stats->queries > 0 ? stats->durationTotalMs / (float)stats->queries : 0.0f;
+    printf("  %-24s queries=%-6d fail=%-5d avgExp=%-7.1f maxExp=%-5d avgMs=%.3f maxMs=%.3f\n",
+           label,
+           stats->queries,
+           failures,
+           avgExp,
+           stats->expandedMax,
+           avgMs,
+           stats->durationMaxMs);
+}
+
+bool path_telemetry_dump_csv(const PathTelemetry* telemetry, const char* path)
+{
+    if (!telemetry)
+        return false;
+    if (!path)
+        path = PATH_TELEMETRY_DEFAULT_CSV;
+
+    FILE* f = fopen(path, "w");
+    if (!f)
+    {
+        printf("❌ Cannot write path telemetry: %s\n", path);
+        return false;
+    }
+
+    fprintf(f, "requester,start_x,start_y,goal_x,goal_y,window_w,window_h,expanded,result,duration_ms\n");
+    int first = (telemetry->historyHead - telemetry->historyCount + PATH_TELEMETRY_HISTORY) % PATH_TELEMETRY_HISTORY;
+    for (int i = 0; i < telemetry->historyCount; ++i)
+    {
+        const PathQueryRecord* r = &telemetry->history[(first + i) % PATH_TELEMETRY_HISTORY];
+        fprintf(f,
+                "%d,%d,%d,%d,%d,%d,%d,%d,%s,%.4f\n",
+                (int)r->requesterType,
+                r->startX,
+                r->startY,
+                r->goalX,
+                r->goalY,
+                r->windowWidth,
+                r->windowHeight,
+                r->expanded,
+                path_telemetry_result_name(r->result),
+                r->durationMs);
+    }
+    fclose(f);
+
+    printf("[PATH] %d recent queries written to %s\n", telemetry->historyCount, path);
+    print_stats_line("all", &telemetry->totals);
+    if (telemetry->perType[0].queries > 0)
+        print_stats_line("unknown", &telemetry->perType[0]);
+    for (int type = 0; type < ENTITY_TYPE_COUNT; ++type)
+    {
+        const PathTelemetryStats* stats = &telemetry->perType[type + 1];
+        if (stats->queries == 0)
+            continue;
+        char label[32];
+        snprintf(label, sizeof(label), "type %d", type);
+        print_stats_line(label, stats);
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Overlay
+// -----------------------------------------------------------------------------
+
+static void overlay_rebuild(PathTelemetry* telemetry, const Map* map)
+{
+    int width  = map->width;
+    int height = map->height;
+
+    if (!G_OVERLAY_PIXELS)
+    {
+        G_OVERLAY_PIXELS = calloc((size_t)MAP_WIDTH * MAP_HEIGHT, sizeof(Color));
+        if (!G_OVERLAY_PIXELS)
+            return;
+    }
+
+    // Log scale keeps hot corridors from washing out the rest of the map.
+    float expScale  = telemetry->expansionPeak > 0 ? 1.0f / logf(1.0f + (float)telemetry->expansionPeak) : 0.0f;
+    float failScale = telemetry->failurePeak > 0 ? 1.0f / logf(1.0f + (float)telemetry->failurePeak) : 0.0f;
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            Color    c    = BLANK;
+            uint16_t fail = telemetry->failures[y][x];
+            uint16_t exp  = telemetry->expansions[y][x];
+            if (fail > 0)
+            {
+                float t = logf(1.0f + (float)fail) * failScale;
+                c       = (Color){255, (unsigned char)(60.0f * (1.0f - t)), 40, (unsigned char)(140.0f + 115.0f * t)};
+            }
+            else if (exp > 0)
+            {
+                float t = logf(1.0f + (float)exp) * expScale;
+                c       = (Color){(unsigned char)(255.0f * t), (unsigned char)(80.0f + 175.0f * t), (unsigned char)(255.0f * (1.0f - t)), (unsigned char)(60.0f + 120.0f * t)};
+            }
+            G_OVERLAY_PIXELS[y * width + x] = c;
+        }
+    }
+
+    if (G_OVERLAY_TEXTURE.id == 0)
+    {
+        Image image = {
+            .data    = G_OVERLAY_PIXELS,
+            .width   = width,
+            .height  = height,
+            .mipmaps = 1,
+            .format  = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8,
+        };
+        G_OVERLAY_TEXTURE = LoadTextureFromImage(image);
+        SetTextureFilter(G_OVERLAY_TEXTURE, TEXTURE_FILTER_POINT);
+    }
+    else
+    {
+        UpdateTexture(G_OVERLAY_TEXTURE, G_OVERLAY_PIXELS);
+    }
+
+    telemetry->overlayDirty = false;
+    G_OVERLAY_BUILT_AT      = GetTime();
+}
+
+void path_telemetry_draw_overlay(PathTelemetry* telemetry, const Map* map, const Camera2D* camera)
+{
+    if (!telemetry || !map || !camera)
+        return;
+
+    double now = GetTime();
+    if (G_OVERLAY_TEXTURE.id == 0 || (telemetry->overlayDirty && now - G_OVERLAY_BUILT_AT >= PATH_TELEMETRY_OVERLAY_REFRESH))
+        overlay_rebuild(telemetry, map);
+    if (G_OVERLAY_TEXTURE.id == 0)
+        return;
+
+    BeginMode2D(*camera);
+    Rectangle source = {0.0f, 0.0f, (float)map->width, (float)map->height};
+    Rectangle dest   = {0.0f, 0.0f, (float)(map->width * TILE_SIZE), (float)(map->height * TILE_SIZE)};
+    DrawTexturePro(G_OVERLAY_TEXTURE, source, dest, (Vector2){0.0f, 0.0f}, 0.0f, WHITE);
+    EndMode2D();
+
+    const PathTelemetryStats* totals   = &telemetry->totals;
+    int                       failures = totals->queries - totals->results[PATH_RESULT_FOUND] - totals->results[PATH_RESULT_TRIVIAL];
+    char                      line[160];
+    snprintf(line,
+             sizeof(line),
+             "Path heatmap: %d queries, %d failed, avg %.0f nodes / %.3f ms",
+             totals->queries,
+             failures,
+             totals->rollingExpanded,
+             totals->rollingDurationMs);
+    DrawText(line, 20, GetScreenHeight() - 30, 16, YELLOW);
+}
+
+void path_telemetry_shutdown(void)
+{
+    if (G_OVERLAY_TEXTURE.id != 0)
+        UnloadTexture(G_OVERLAY_TEXTURE);
+    G_OVERLAY_TEXTURE  = (Texture2D){0};
+    G_OVERLAY_BUILT_AT = -1.0;
+    free(G_OVERLAY_PIXELS);
+    G_OVERLAY_PIXELS = NULL;
+}
@@ -5,11 +5,23 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "clearance_map.h"
+#include "jobs.h"
+#include "map.h"
 #include "object.h"
+#include "path_telemetry.h"
 #include "tile.h"
+#include "tile_stats.h"
+#include "profiler.h"
+#include "tunables.h"
 
 #define PATHFINDING_MAX_NODES 4096
-#define PATHFINDING_MAX_EXTENT 30
+// Nodes are pushed again when their cost improves, so the heap needs headroom.
+#define PATHFINDING_HEAP_CAPACITY (PATHFINDING_MAX_NODES * 2)
+/** Half size of a tracked search window (the window fits PATHFINDING_MAX_NODES). */
+#define PATHFINDING_TRACK_HALF_EXTENT 31
+/** Tiles the agent may move away from a track's root before the track is re-rooted. */
+#define PATHFINDING_TRACK_REROOT_DISTANCE 8
 
 typedef struct Node
 {
@@ -23,8 +35,6 @@ typedef struct Node
     unsigned short visitedID;
 } Node;
 
-static unsigned short globalVisitID = 1;
-
 // --------------------------------------------------------------------------------------
 // Min-heap simple pour la open list
 // --------------------------------------------------------------------------------------
@@ -36,7 +46,7 @@ typedef struct
 
 typedef struct
 {
-    HeapNode nodes[PATHFINDING_MAX_NODES];
+    HeapNode nodes[PATHFINDING_HEAP_CAPACITY];
     int      count;
 } MinHeap;
 
@@ -47,6 +57,9 @@ static inline void heap_init(MinHeap* heap)
 
 static inline void heap_push(MinHeap* heap, int index, float f)
 {
+    if (heap->count >= PATHFINDING_HEAP_CAPACITY)
+        return;
+
     int i = heap->count++;
     while (i > 0)
     {
@@ -101,9 +114,19 @@ static inline float tile_cost(const TileType* tile)
     return (cost > 0.01f) ? cost : 1.0f;
 }
 
-static inline bool tile_walkable_cached(const Map* map, bool** walk, int x, int y)
+static bool tile_passable(const Map* map, const PathfindingOptions* options, int x, int y)
 {
-    return (x >= 0 && y >= 0 && x < map->width && y < map->height) ? walk[y][x] : false;
+    if (x < 0 || y < 0 || x >= map->width || y >= map->height)
+        return false;
+
+    const TileType* tile = get_tile_type(map->tiles[y][x]);
+    if (!tile || !tile->walkable)
+        return false;
+
+    const ObjectType* obj = map_object_type_at(map, x, y);
+    if (obj && !map_object_walkable_at(map, x, y) && !(options->canOpenDoors && obj->isDoor))
+        return false;
+    return true;
 }
 
 static void reconstruct_path(const Node* nodes, int currentIndex, PathfindingPath* outPath)
@@ -127,63 +150,487 @@ static void reconstruct_path(const Node* nodes, int currentIndex, PathfindingPat
 }
 
 // --------------------------------------------------------------------------------------
-// Main Pathfinding avec diagonales
+// Recherche A* partagée (requêtes ponctuelles et suivis)
 // --------------------------------------------------------------------------------------
-bool pathfinding_find_path(const Map* map, Vector2 start, Vector2 goal, const PathfindingOptions* options, PathfindingPath* outPath)
+typedef struct SearchSpace
 {
-    if (outPath)
-        memset(outPath, 0, sizeof(*outPath));
-    if (!map)
+    const Map*         map;
+    PathfindingOptions options;
+    Node*              nodes;
+    MinHeap*           heap;
+    unsigned short     visitID;
+    int                minX;
+    int                minY;
+    int                width;
+    int                height;
+    uint8_t            needClearance;
+    bool               useClearance;
+} SearchSpace;
+
+static void search_configure(SearchSpace* space, const Map* map, const PathfindingOptions* options)
+{
+    static const PathfindingOptions DEFAULT_OPTIONS = {.allowDiagonal = true, .requesterType = ENTITY_TYPE_INVALID};
+
+    space->map     = map;
+    space->options = options ? *options : DEFAULT_OPTIONS;
+
+    // Agents wider than a tile need that many free rings around each step.
+    space->needClearance = clearance_map_required(space->options.agentRadius);
+    space->useClearance  = space->needClearance > 1 && clearance_map_ready(map);
+}
+
+static inline bool search_contains(const SearchSpace* space, int x, int y)
+{
+    return x >= space->minX && y >= space->minY && x < space->minX + space->width && y < space->minY + space->height;
+}
+
+static inline int search_index(const SearchSpace* space, int x, int y)
+{
+    return (y - space->minY) * space->width + (x - space->minX);
+}
+
+static Node* search_touch(SearchSpace* space, int index, int x, int y, int gx, int gy)
+{
+    Node* node = &space->nodes[index];
+    if (node->visitedID != space->visitID)
+    {
+        node->x         = x;
+        node->y         = y;
+        node->visitedID = space->visitID;
+        node->g         = FLT_MAX;
+        node->h         = heuristic_cost(x, y, gx, gy);
+        node->parent    = -1;
+        node->open      = false;
+        node->closed    = false;
+    }
+    return node;
+}
+
+/** Clears the space and seeds it with a single open start node. */
+static void search_seed(SearchSpace* space, int sx, int sy, int gx, int gy)
+{
+    if (++space->visitID == 0)
+    {
+        // Visit ids wrapped: forget every stamp so none matches by accident.
+        for (int i = 0; i < PATHFINDING_MAX_NODES; ++i)
+            space->nodes[i].visitedID = 0;
+        space->visitID = 1;
+    }
+
+    heap_init(space->heap);
+    int   startIndex = search_index(space, sx, sy);
+    Node* startNode  = search_touch(space, startIndex, sx, sy, gx, gy);
+    startNode->g     = 0.0f;
+    startNode->open  = true;
+    heap_push(space->heap, startIndex, startNode->g + startNode->h);
+}
+
+/** Whether a single step between neighbouring tiles is allowed. */
+static bool search_step_allowed(const SearchSpace* space, int fromX, int fromY, int toX, int toY, int gx, int gy)
+{
+    const Map* map = space->map;
+    if (!tile_passable(map, &space->options, toX, toY))
         return false;
 
-    int sx = (int)floorf(start.x / TILE_SIZE);
-    int sy = (int)floorf(start.y / TILE_SIZE);
-    int gx = (int)floorf(goal.x / TILE_SIZE);
-    int gy = (int)floorf(goal.y / TILE_SIZE);
+    // The goal itself is accepted so agents can still close in on targets near walls.
+    if (space->useClearance && map->clearance[toY][toX] < space->needClearance && !(toX == gx && toY == gy))
+        return false;
 
-    if (sx == gx && sy == gy)
+    // Évite de couper un coin entre deux obstacles
+    if (toX != fromX && toY != fromY)
     {
-        if (outPath)
+        if (!tile_passable(map, &space->options, toX, fromY) || !tile_passable(map, &space->options, fromX, toY))
+            return false;
+    }
+    return true;
+}
+
+static void search_expand(SearchSpace* space, int currentIndex, int gx, int gy)
+{
+    // 8 directions
+    static const int OFFSETS[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+    const Node* current  = &space->nodes[currentIndex];
+    const int   dirCount = space->options.allowDiagonal ? 8 : 4;
+
+    for (int n = 0; n < dirCount; ++n)
+    {
+        int nx = current->x + OFFSETS[n][0];
+        int ny = current->y + OFFSETS[n][1];
+        if (!search_contains(space, nx, ny))
+            continue;
+        if (!search_step_allowed(space, current->x, current->y, nx, ny, gx, gy))
+            continue;
+
+        int   neighborIndex = search_index(space, nx, ny);
+        Node* neighbor      = search_touch(space, neighborIndex, nx, ny, gx, gy);
+        if (neighbor->closed)
+            continue;
+
+        float     stepCost = (n < 4) ? 1.0f : 1.41421356f; // diagonale = sqrt(2)
+        TileType* tile     = get_tile_type(space->map->tiles[ny][nx]);
+        stepCost *= tile_cost(tile);
+
+        float tentativeG = current->g + stepCost;
+        if (!neighbor->open || tentativeG < neighbor->g)
         {
-            outPath->points[0] = (Vector2){(gx + 0.5f) * TILE_SIZE, (gy + 0.5f) * TILE_SIZE};
-            outPath->count     = 1;
+            neighbor->parent = currentIndex;
+            neighbor->g      = tentativeG;
+            float f          = tentativeG + neighbor->h;
+            heap_push(space->heap, neighborIndex, f);
+            neighbor->open = true;
         }
-        return true;
     }
+}
+
+/**
+ * Runs A* from the current open list until the goal is closed.
+ *
+ * The goal is expanded as well before returning, so a later search resumed
+ * from the same tree (see the tracking API) still grows past it; a goal only
+ * admitted through the clearance exception is never expanded.
+ *
+ * @return The goal's node index, or -1 once the open list is exhausted.
+ */
+static int search_run(SearchSpace* space, int gx, int gy, PathQueryRecord* record)
+{
+    const int goalIndex = search_index(space, gx, gy);
 
-    // Pré-calcul du cache de walkables
-    bool** walkable = malloc(sizeof(bool*) * map->height);
-    for (int y = 0; y < map->height; ++y)
+    while (space->heap->count > 0)
     {
-        walkable[y] = malloc(sizeof(bool) * map->width);
-        for (int x = 0; x < map->width; ++x)
+        int   currentIndex = heap_pop(space->heap);
+        Node* current      = &space->nodes[currentIndex];
+        if (current->closed)
+            continue; // stale entry left by a cheaper re-push
+        current->open   = false;
+        current->closed = true;
+        record->expanded++;
+        path_telemetry_note_expansion(space->options.telemetry, current->x, current->y);
+
+        if (currentIndex == goalIndex)
         {
-            TileTypeID tileId = map->tiles[y][x];
-            TileType*  tile   = get_tile_type(tileId);
-            bool       ok     = (tile && tile->walkable);
-            if (ok)
-            {
-                Object* obj = map->objects[y][x];
-                if (obj)
-                {
-                    if (!object_is_walkable(obj) && !(options && options->canOpenDoors && obj->type && obj->type->isDoor))
-                        ok = false;
-                }
-            }
-            walkable[y][x] = ok;
+            if (!space->useClearance || space->map->clearance[gy][gx] >= space->needClearance)
+                search_expand(space, currentIndex, gx, gy);
+            return currentIndex;
         }
+
+        search_expand(space, currentIndex, gx, gy);
     }
+    return -1;
+}
 
-    if (!tile_walkable_cached(map, walkable, sx, sy) || !tile_walkable_cached(map, walkable, gx, gy))
+// --------------------------------------------------------------------------------------
+// Jump Point Search pour les fenêtres à coût uniforme
+//
+// When every walkable tile of the window costs the same, symmetric paths are
+// pruned: a node only generates the jump points reachable in its pruned
+// directions, and straight runs across open ground cost no expansion. Steps
+// follow the A* rules (no corner cutting), so both searches agree on which
+// paths exist.
+// --------------------------------------------------------------------------------------
+
+/** True when every walkable tile type in the chunks covering the window has the same cost. */
+static bool search_window_uniform(const SearchSpace* space, float* outCost)
+{
+    if (!tile_stats_ready(space->map))
+        return false;
+
+    TileStatsSummary summary;
+    tile_stats_query_chunks(space->map, space->minX / CHUNK_W,
+                            space->minY / CHUNK_H,
+                            (space->minX + space->width - 1) / CHUNK_W,
+                            (space->minY + space->height - 1) / CHUNK_H,
+                            &summary);
+
+    bool  found = false;
+    float cost  = 1.0f;
+    for (int t = 0; t < TILE_MAX; ++t)
     {
-        for (int y = 0; y < map->height; ++y)
-            free(walkable[y]);
-        free(walkable);
+        if (summary.tileCounts[t] == 0)
+            continue;
+        const TileType* tile = get_tile_type((TileTypeID)t);
+        if (!tile || !tile->walkable)
+            continue;
+        float c = tile_cost(tile);
+        if (found && c != cost)
+            return false;
+        cost  = c;
+        found = true;
+    }
+    *outCost = cost;
+    return found;
+}
+
+static inline bool jps_open(const SearchSpace* space, int x, int y)
+{
+    return search_contains(space, x, y) && tile_passable(space->map, &space->options, x, y);
+}
+
+/** Walks a straight line from (x, y) until the goal, a forced neighbour or a wall. */
+static bool jps_jump_straight(const SearchSpace* space, int x, int y, int dx, int dy, int gx, int gy, int* outX, int* outY)
+{
+    for (;; x += dx, y += dy)
+    {
+        if (!jps_open(space, x, y))
+            return false;
+
+        bool forced;
+        if (dx != 0)
+            forced = (jps_open(space, x, y - 1) && !jps_open(space, x - dx, y - 1)) || (jps_open(space, x, y + 1) && !jps_open(space, x - dx, y + 1));
+        else
+            forced = (jps_open(space, x - 1, y) && !jps_open(space, x - 1, y - dy)) || (jps_open(space, x + 1, y) && !jps_open(space, x + 1, y - dy));
+
+        if (forced || (x == gx && y == gy))
+        {
+            *outX = x;
+            *outY = y;
+            return true;
+        }
+    }
+}
+
+/** Jumps from (x, y) in direction (dx, dy); diagonal runs stop where a straight run finds something. */
+static bool jps_jump(const SearchSpace* space, int x, int y, int dx, int dy, int gx, int gy, int* outX, int* outY)
+{
+    if (dx == 0 || dy == 0)
+        return jps_jump_straight(space, x, y, dx, dy, gx, gy, outX, outY);
+
+    for (;; x += dx, y += dy)
+    {
+        if (!jps_open(space, x, y))
+            return false;
+
+        int jx, jy;
+        if ((x == gx && y == gy) || jps_jump_straight(space, x + dx, y, dx, 0, gx, gy, &jx, &jy) ||
+            jps_jump_straight(space, x, y + dy, 0, dy, gx, gy, &jx, &jy))
+        {
+            *outX = x;
+            *outY = y;
+            return true;
+        }
+
+        // No corner cutting: the next diagonal step needs both orthogonal tiles.
+        if (!jps_open(space, x + dx, y) || !jps_open(space, x, y + dy))
+            return false;
+    }
+}
+
+/** Directions worth exploring from a node reached from its parent; returns the count. */
+static int jps_directions(const Node* node, const Node* parent, int dirs[8][2])
+{
+    int x     = node->x;
+    int y     = node->y;
+    int count = 0;
+
+    if (!parent)
+    {
+        static const int ALL[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+        for (int i = 0; i < 8; ++i)
+        {
+            dirs[count][0] = ALL[i][0];
+            dirs[count][1] = ALL[i][1];
+            count++;
+        }
+        return count;
+    }
+
+    int dx = (x > parent->x) - (x < parent->x);
+    int dy = (y > parent->y) - (y < parent->y);
+
+#define ADD_DIR(ax, ay)                                                                                                         \
+    do                                                                                                                          \
+    {                                                                                                                           \
+        dirs[count][0] = (ax);                                                                                                  \
+        dirs[count][1] = (ay);                                                                                                  \
+        count++;                                                                                                                \
+    } while (0)
+
+    if (dx != 0 && dy != 0)
+    {
+        ADD_DIR(dx, 0);
+        ADD_DIR(0, dy);
+        ADD_DIR(dx, dy);
+    }
+    else if (dx != 0)
+    {
+        ADD_DIR(dx, 0);
+        ADD_DIR(0, 1);
+        ADD_DIR(0, -1);
+        ADD_DIR(dx, 1);
+        ADD_DIR(dx, -1);
+    }
+    else
+    {
+        ADD_DIR(0, dy);
+        ADD_DIR(1, 0);
+        ADD_DIR(-1, 0);
+        ADD_DIR(1, dy);
+        ADD_DIR(-1, dy);
+    }
+
+#undef ADD_DIR
+    return count;
+}
+
+static void jps_expand(SearchSpace* space, int currentIndex, int gx, int gy, float cost)
+{
+    const Node* current = &space->nodes[currentIndex];
+    const Node* parent  = current->parent >= 0 ? &space->nodes[current->parent] : NULL;
+
+    int dirs[8][2];
+    int dirCount = jps_directions(current, parent, dirs);
+
+    for (int d = 0; d < dirCount; ++d)
+    {
+        int dx = dirs[d][0];
+        int dy = dirs[d][1];
+        int nx = current->x + dx;
+        int ny = current->y + dy;
+        if (!search_step_allowed(space, current->x, current->y, nx, ny, gx, gy))
+            continue;
+
+        int jx, jy;
+        if (!search_contains(space, nx, ny) || !jps_jump(space, nx, ny, dx, dy, gx, gy, &jx, &jy))
+            continue;
+
+        int   jumpIndex = search_index(space, jx, jy);
+        Node* jump      = search_touch(space, jumpIndex, jx, jy, gx, gy);
+        if (jump->closed)
+            continue;
+
+        int   ax         = abs(jx - current->x);
+        int   ay         = abs(jy - current->y);
+        int   diag       = ax < ay ? ax : ay;
+        float tentativeG = current->g + ((float)(ax + ay - 2 * diag) + 1.41421356f * (float)diag) * cost;
+        if (!jump->open || tentativeG < jump->g)
+        {
+            jump->parent = currentIndex;
+            jump->g      = tentativeG;
+            heap_push(space->heap, jumpIndex, tentativeG + jump->h);
+            jump->open = true;
+        }
+    }
+}
+
+/** JPS counterpart of search_run; the goal's parent chain links jump points. */
+static int jps_run(SearchSpace* space, int gx, int gy, float cost, PathQueryRecord* record)
+{
+    const int goalIndex = search_index(space, gx, gy);
+
+    while (space->heap->count > 0)
+    {
+        int   currentIndex = heap_pop(space->heap);
+        Node* current      = &space->nodes[currentIndex];
+        if (current->closed)
+            continue;
+        current->open   = false;
+        current->closed = true;
+        record->expanded++;
+        path_telemetry_note_expansion(space->options.telemetry, current->x, current->y);
+
+        if (currentIndex == goalIndex)
+            return currentIndex;
+
+        jps_expand(space, currentIndex, gx, gy, cost);
+    }
+    return -1;
+}
+
+/** Writes the tiles between consecutive jump points (each leg is straight or diagonal). */
+static void jps_reconstruct_path(const Node* nodes, int goalIndex, PathfindingPath* outPath)
+{
+    if (!outPath)
+        return;
+
+    int chain[PATHFINDING_MAX_LENGTH];
+    int length = 0;
+    for (int i = goalIndex; i >= 0 && length < PATHFINDING_MAX_LENGTH; i = nodes[i].parent)
+        chain[length++] = i;
+
+    outPath->count = 0;
+    int x          = nodes[chain[length - 1]].x;
+    int y          = nodes[chain[length - 1]].y;
+    outPath->points[outPath->count++] = (Vector2){(x + 0.5f) * TILE_SIZE, (y + 0.5f) * TILE_SIZE};
+
+    for (int c = length - 2; c >= 0; --c)
+    {
+        const Node* to = &nodes[chain[c]];
+        int         dx = (to->x > x) - (to->x < x);
+        int         dy = (to->y > y) - (to->y < y);
+        while ((x != to->x || y != to->y) && outPath->count < PATHFINDING_MAX_LENGTH)
+        {
+            x += dx;
+            y += dy;
+            outPath->points[outPath->count++] = (Vector2){(x + 0.5f) * TILE_SIZE, (y + 0.5f) * TILE_SIZE};
+        }
+    }
+}
+
+static bool finish_query(PathTelemetry* telemetry, PathQueryRecord* record, PathQueryResult result, double startTime)
+{
+    record->result     = result;
+    record->durationMs = (float)((GetTime() - startTime) * 1000.0);
+    path_telemetry_record(telemetry, record);
+    return result == PATH_RESULT_FOUND || result == PATH_RESULT_TRIVIAL;
+}
+
+static void write_single_point(PathfindingPath* outPath, int x, int y)
+{
+    if (!outPath)
+        return;
+    outPath->points[0] = (Vector2){(x + 0.5f) * TILE_SIZE, (y + 0.5f) * TILE_SIZE};
+    outPath->count     = 1;
+}
+
+// --------------------------------------------------------------------------------------
+// Main Pathfinding avec diagonales
+// --------------------------------------------------------------------------------------
+
+// Scratch of one-off queries. Each thread owns a copy, so queries issued from job
+// workers or from worlds stepped on different threads never share nodes.
+static JOBS_THREAD_LOCAL Node        G_QUERY_NODES[PATHFINDING_MAX_NODES];
+static JOBS_THREAD_LOCAL MinHeap     G_QUERY_HEAP;
+static JOBS_THREAD_LOCAL SearchSpace G_QUERY_SPACE;
+
+bool pathfinding_find_path(const Map* map, Vector2 start, Vector2 goal, const PathfindingOptions* options, PathfindingPath* outPath)
+{
+    if (outPath)
+        memset(outPath, 0, sizeof(*outPath));
+    if (!map)
         return false;
+    profiler_count(PROFILER_COUNT_PATH_QUERIES, 1);
+
+    PathTelemetry* telemetry = options ? options->telemetry : NULL;
+    double         startTime = GetTime();
+    int            sx        = (int)floorf(start.x / TILE_SIZE);
+    int            sy        = (int)floorf(start.y / TILE_SIZE);
+    int            gx        = (int)floorf(goal.x / TILE_SIZE);
+    int            gy        = (int)floorf(goal.y / TILE_SIZE);
+
+    PathQueryRecord record = {
+        .requesterType = options ? options->requesterType : ENTITY_TYPE_INVALID,
+        .startX        = sx,
+        .startY        = sy,
+        .goalX         = gx,
+        .goalY         = gy,
+    };
+
+    if (sx == gx && sy == gy)
+    {
+        write_single_point(outPath, gx, gy);
+        return finish_query(telemetry, &record, PATH_RESULT_TRIVIAL, startTime);
     }
 
+    SearchSpace* space = &G_QUERY_SPACE;
+    space->nodes       = G_QUERY_NODES;
+    space->heap        = &G_QUERY_HEAP;
+    search_configure(space, map, options);
+
+    if (!tile_passable(map, &space->options, sx, sy) || !tile_passable(map, &space->options, gx, gy))
+        return finish_query(telemetry, &record, PATH_RESULT_BLOCKED_ENDPOINT, startTime);
+
     // Définir la zone de recherche
-    int halfExtent = PATHFINDING_MAX_EXTENT;
+    int halfExtent = tunable_get_int(TUNABLE_PATH_MAX_EXTENT);
     int minX       = sx < gx ? sx : gx;
     int minY       = sy < gy ? sy : gy;
     int maxX       = sx > gx ? sx : gx;
@@ -214,112 +661,352 @@ bool pathfinding_find_path(const Map* map, Vector2 start, Vector2 goal, const Pa
         }
         halfExtent -= 4;
         if (halfExtent <= 4)
-        {
-            for (int y = 0; y < map->height; ++y)
-                free(walkable[y]);
-            free(walkable);
-            return false;
-        }
+            return finish_query(telemetry, &record, PATH_RESULT_WINDOW_TOO_LARGE, startTime);
     }
 
-    int width  = maxX - minX + 1;
-    int height = maxY - minY + 1;
-    int total  = width * height;
+    space->minX   = minX;
+    space->minY   = minY;
+    space->width  = maxX - minX + 1;
+    space->height = maxY - minY + 1;
 
-    static Node nodes[PATHFINDING_MAX_NODES];
-    ++globalVisitID;
+    record.windowWidth  = space->width;
+    record.windowHeight = space->height;
 
-    int startIndex = (sy - minY) * width + (sx - minX);
-    int goalIndex  = (gy - minY) * width + (gx - minX);
+    // Uniform-cost windows use JPS; cost changes (forest, swamp) keep plain A*.
+    float uniformCost = 1.0f;
+    bool  useJps      = space->options.allowDiagonal && !space->useClearance && search_window_uniform(space, &uniformCost);
 
-    Node* startNode      = &nodes[startIndex];
-    startNode->x         = sx;
-    startNode->y         = sy;
-    startNode->g         = 0.0f;
-    startNode->h         = heuristic_cost(sx, sy, gx, gy);
-    startNode->parent    = -1;
-    startNode->open      = true;
-    startNode->closed    = false;
-    startNode->visitedID = globalVisitID;
+    search_seed(space, sx, sy, gx, gy);
+    int goalIndex = useJps ? jps_run(space, gx, gy, uniformCost, &record) : search_run(space, gx, gy, &record);
+    if (goalIndex < 0)
+        return finish_query(telemetry, &record, PATH_RESULT_EXHAUSTED, startTime);
 
-    MinHeap heap;
-    heap_init(&heap);
-    heap_push(&heap, startIndex, startNode->g + startNode->h);
+    if (useJps)
+        jps_reconstruct_path(space->nodes, goalIndex, outPath);
+    else
+        reconstruct_path(space->nodes, goalIndex, outPath);
+    return finish_query(telemetry, &record, PATH_RESULT_FOUND, startTime);
+}
 
-    // 8 directions
-    static const int OFFSETS[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+// --------------------------------------------------------------------------------------
+// Suivi incrémental d'une cible mobile
+//
+// A track keeps an A* tree rooted at the agent's tile. Closed nodes hold exact
+// costs from the root whatever the goal is, so when the target moves the open
+// list is simply re-keyed for the new goal and the search resumes; a goal that
+// is already closed costs nothing. The tree is rebuilt only when walkability
+// changed inside its window, when the agent strays from the root, or when the
+// target leaves the window.
+// --------------------------------------------------------------------------------------
+typedef struct PathTrack
+{
+    bool         used;
+    bool         seeded;
+    int          rootX;
+    int          rootY;
+    int          goalX;     // goal the open list is keyed for
+    int          goalY;
+    unsigned int generation; // map walkability generation the tree was built on
+    SearchSpace  space;
+    Node         nodes[PATHFINDING_MAX_NODES];
+    MinHeap      heap;
+} PathTrack;
+
+// Goal-to-join chain scratch of track_write_path (per thread, like the query scratch).
+static JOBS_THREAD_LOCAL int G_TRACK_CHAIN[PATHFINDING_MAX_NODES];
+
+static PathTrack* track_get(PathTrackPool* pool, PathTrackHandle handle)
+{
+    if (!pool || handle == PATH_TRACK_INVALID || handle > PATHFINDING_MAX_TRACKS)
+        return NULL;
+    PathTrack* track = pool->tracks[handle - 1];
+    return (track && track->used) ? track : NULL;
+}
+
+static void track_seed(PathTrack* track, const Map* map, int sx, int sy, int gx, int gy)
+{
+    SearchSpace* space = &track->space;
+
+    int loX = sx - PATHFINDING_TRACK_HALF_EXTENT;
+    int loY = sy - PATHFINDING_TRACK_HALF_EXTENT;
+    int hiX = sx + PATHFINDING_TRACK_HALF_EXTENT;
+    int hiY = sy + PATHFINDING_TRACK_HALF_EXTENT;
+    if (loX < 0)
+        loX = 0;
+    if (loY < 0)
+        loY = 0;
+    if (hiX >= map->width)
+        hiX = map->width - 1;
+    if (hiY >= map->height)
+        hiY = map->height - 1;
+
+    space->minX   = loX;
+    space->minY   = loY;
+    space->width  = hiX - loX + 1;
+    space->height = hiY - loY + 1;
+
+    search_seed(space, sx, sy, gx, gy);
+    track->seeded     = true;
+    track->rootX      = sx;
+    track->rootY      = sy;
+    track->goalX      = gx;
+    track->goalY      = gy;
+    track->generation = map_walkability_generation(map);
+}
 
-    while (heap.count > 0)
+/** Re-keys the open list for a new goal; closed nodes stay valid. */
+static void track_retarget(PathTrack* track, int gx, int gy)
+{
+    SearchSpace* space = &track->space;
+    int          total = space->width * space->height;
+
+    heap_init(space->heap);
+    for (int i = 0; i < total; ++i)
     {
-        int   currentIndex = heap_pop(&heap);
-        Node* current      = &nodes[currentIndex];
-        current->open      = false;
-        current->closed    = true;
+        Node* node = &space->nodes[i];
+        if (node->visitedID != space->visitID)
+            continue;
+        node->h = heuristic_cost(node->x, node->y, gx, gy);
+        if (node->open)
+            heap_push(space->heap, i, node->g + node->h);
+    }
+    track->goalX = gx;
+    track->goalY = gy;
+}
 
-        if (currentIndex == goalIndex)
-        {
-            reconstruct_path(nodes, currentIndex, outPath);
-            for (int y = 0; y < map->height; ++y)
-                free(walkable[y]);
-            free(walkable);
-            return true;
-        }
+/**
+ * Links a goal the clearance test kept out of the tree to its best closed
+ * neighbour, so targets hugging walls stay reachable for wide agents.
+ */
+static int track_attach_goal(PathTrack* track, int gx, int gy)
+{
+    SearchSpace* space = &track->space;
+    int          best  = -1;
+    float        bestG = FLT_MAX;
 
-        for (int n = 0; n < 8; ++n)
+    for (int dy = -1; dy <= 1; ++dy)
+    {
+        for (int dx = -1; dx <= 1; ++dx)
         {
-            int nx = current->x + OFFSETS[n][0];
-            int ny = current->y + OFFSETS[n][1];
-            if (!tile_walkable_cached(map, walkable, nx, ny))
+            int nx = gx + dx;
+            int ny = gy + dy;
+            if ((dx == 0 && dy == 0) || !search_contains(space, nx, ny))
+                continue;
+            if (dx != 0 && dy != 0 && !space->options.allowDiagonal)
                 continue;
 
-            // Évite de couper un coin entre deux obstacles
-            if (n >= 4)
-            {
-                int ax = current->x + OFFSETS[n][0];
-                int ay = current->y;
-                int bx = current->x;
-                int by = current->y + OFFSETS[n][1];
-                if (!tile_walkable_cached(map, walkable, ax, ay) || !tile_walkable_cached(map, walkable, bx, by))
-                    continue;
-            }
-
-            int neighborIndex = (ny - minY) * width + (nx - minX);
-            if (neighborIndex < 0 || neighborIndex >= total)
+            const Node* node = &space->nodes[search_index(space, nx, ny)];
+            if (node->visitedID != space->visitID || !node->closed)
+                continue;
+            if (!search_step_allowed(space, nx, ny, gx, gy, gx, gy))
                 continue;
 
-            Node* neighbor = &nodes[neighborIndex];
-            if (neighbor->visitedID != globalVisitID)
+            float g = node->g + ((dx != 0 && dy != 0) ? 1.41421356f : 1.0f) * tile_cost(get_tile_type(space->map->tiles[gy][gx]));
+            if (g < bestG)
             {
-                neighbor->x         = nx;
-                neighbor->y         = ny;
-                neighbor->visitedID = globalVisitID;
-                neighbor->g         = FLT_MAX;
-                neighbor->h         = heuristic_cost(nx, ny, gx, gy);
-                neighbor->parent    = -1;
-                neighbor->open      = false;
-                neighbor->closed    = false;
+                bestG = g;
+                best  = search_index(space, nx, ny);
             }
-            if (neighbor->closed)
-                continue;
+        }
+    }
+    if (best < 0)
+        return -1;
+
+    int   goalIndex = search_index(space, gx, gy);
+    Node* goalNode  = search_touch(space, goalIndex, gx, gy, gx, gy);
+    goalNode->g      = bestG;
+    goalNode->parent = best;
+    goalNode->open   = false;
+    goalNode->closed = true;
+    return goalIndex;
+}
+
+/** Resolves the goal in the current tree, extending the search if needed. */
+static int track_resolve_goal(PathTrack* track, int gx, int gy, PathQueryRecord* record)
+{
+    SearchSpace* space     = &track->space;
+    int          goalIndex = search_index(space, gx, gy);
+    const Node*  goalNode  = &space->nodes[goalIndex];
+    if (goalNode->visitedID == space->visitID && goalNode->closed)
+        return goalIndex;
+
+    if (gx != track->goalX || gy != track->goalY)
+        track_retarget(track, gx, gy);
+
+    int found = search_run(space, gx, gy, record);
+    if (found < 0)
+        found = track_attach_goal(track, gx, gy);
+    return found;
+}
 
-            float     stepCost = (n < 4) ? 1.0f : 1.41421356f; // diagonale = sqrt(2)
-            TileType* tile     = get_tile_type(map->tiles[ny][nx]);
-            stepCost *= tile_cost(tile);
+/**
+ * Writes the tree path from the agent's tile to the goal.
+ *
+ * The agent normally walks along the tree, so its tile (or a neighbour) lies
+ * on the root-to-goal chain; the path starts from the chain node closest to
+ * the goal that the agent can step onto.
+ */
+static bool track_write_path(PathTrack* track, int goalIndex, int sx, int sy, PathfindingPath* outPath)
+{
+    SearchSpace* space = &track->space;
+    int          join  = -1;
 
-            float tentativeG = current->g + stepCost;
-            if (!neighbor->open || tentativeG < neighbor->g)
-            {
-                neighbor->parent = currentIndex;
-                neighbor->g      = tentativeG;
-                float f          = tentativeG + neighbor->h;
-                heap_push(&heap, neighborIndex, f);
-                neighbor->open = true;
-            }
+    for (int index = goalIndex; index >= 0; index = space->nodes[index].parent)
+    {
+        const Node* n = &space->nodes[index];
+        if (n->x == sx && n->y == sy)
+        {
+            join = index;
+            break;
         }
+        if (abs(n->x - sx) <= 1 && abs(n->y - sy) <= 1 && search_step_allowed(space, sx, sy, n->x, n->y, -1, -1))
+        {
+            join = index;
+            break;
+        }
+    }
+    if (join < 0)
+        return false;
+
+    if (!outPath)
+        return true;
+
+    // Chain from the goal back to the join node, then emitted from the agent's end.
+    int* chain  = G_TRACK_CHAIN;
+    int  length = 0;
+    for (int index = goalIndex; length < PATHFINDING_MAX_NODES; index = space->nodes[index].parent)
+    {
+        chain[length++] = index;
+        if (index == join)
+            break;
     }
 
-    for (int y = 0; y < map->height; ++y)
-        free(walkable[y]);
-    free(walkable);
-    return false;
+    outPath->count = 0;
+    if (space->nodes[join].x != sx || space->nodes[join].y != sy)
+        outPath->points[outPath->count++] = (Vector2){(sx + 0.5f) * TILE_SIZE, (sy + 0.5f) * TILE_SIZE};
+    for (int i = length - 1; i >= 0 && outPath->count < PATHFINDING_MAX_LENGTH; --i)
+    {
+        const Node* n                     = &space->nodes[chain[i]];
+        outPath->points[outPath->count++] = (Vector2){(n->x + 0.5f) * TILE_SIZE, (n->y + 0.5f) * TILE_SIZE};
+    }
+    return true;
+}
+
+void pathfinding_track_reset(PathTrackPool* pool)
+{
+    if (!pool)
+        return;
+    for (int i = 0; i < PATHFINDING_MAX_TRACKS; ++i)
+    {
+        free(pool->tracks[i]);
+        pool->tracks[i] = NULL;
+    }
+}
+
+PathTrackHandle pathfinding_track_begin(PathTrackPool* pool, const PathfindingOptions* options)
+{
+    if (!pool)
+        return PATH_TRACK_INVALID;
+    for (int i = 0; i < PATHFINDING_MAX_TRACKS; ++i)
+    {
+        PathTrack* track = pool->tracks[i];
+        if (track && track->used)
+            continue;
+
+        if (!track)
+        {
+            track = (PathTrack*)calloc(1, sizeof(PathTrack));
+            if (!track)
+                return PATH_TRACK_INVALID;
+            pool->tracks[i] = track;
+        }
+
+        track->used        = true;
+        track->seeded      = false;
+        track->space.nodes = track->nodes;
+        track->space.heap  = &track->heap;
+        search_configure(&track->space, NULL, options);
+        return (PathTrackHandle)(i + 1);
+    }
+    return PATH_TRACK_INVALID;
+}
+
+bool pathfinding_track_update(PathTrackPool* pool, PathTrackHandle handle, const Map* map, Vector2 start, Vector2 goal, PathfindingPath* outPath)
+{
+    PathTrack* track = track_get(pool, handle);
+    if (!track)
+        return false;
+
+    if (outPath)
+        memset(outPath, 0, sizeof(*outPath));
+    if (!map)
+        return false;
+    profiler_count(PROFILER_COUNT_PATH_QUERIES, 1);
+
+    SearchSpace* space     = &track->space;
+    double       startTime = GetTime();
+    int          sx        = (int)floorf(start.x / TILE_SIZE);
+    int          sy        = (int)floorf(start.y / TILE_SIZE);
+    int          gx        = (int)floorf(goal.x / TILE_SIZE);
+    int          gy        = (int)floorf(goal.y / TILE_SIZE);
+
+    PathQueryRecord record = {
+        .requesterType = space->options.requesterType,
+        .startX        = sx,
+        .startY        = sy,
+        .goalX         = gx,
+        .goalY         = gy,
+    };
+
+    if (sx == gx && sy == gy)
+    {
+        write_single_point(outPath, gx, gy);
+        return finish_query(space->options.telemetry, &record, PATH_RESULT_TRIVIAL, startTime);
+    }
+
+    space->map = map;
+    if (!tile_passable(map, &space->options, sx, sy) || !tile_passable(map, &space->options, gx, gy))
+        return finish_query(space->options.telemetry, &record, PATH_RESULT_BLOCKED_ENDPOINT, startTime);
+
+    bool stale = !track->seeded || abs(sx - track->rootX) > PATHFINDING_TRACK_REROOT_DISTANCE || abs(sy - track->rootY) > PATHFINDING_TRACK_REROOT_DISTANCE ||
+                 !search_contains(space, sx, sy) || !search_contains(space, gx, gy);
+    if (!stale)
+    {
+        stale = map_walkability_changed_since(map, track->generation, space->minX, space->minY, space->minX + space->width, space->minY + space->height,
+                                              space->options.canOpenDoors);
+    }
+
+    // Re-rooting once covers an agent that left the chain (pushed aside, detour).
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        if (stale)
+        {
+            track_seed(track, map, sx, sy, gx, gy);
+            if (!search_contains(space, gx, gy))
+                break;
+        }
+
+        record.windowWidth  = space->width;
+        record.windowHeight = space->height;
+
+        int goalIndex = track_resolve_goal(track, gx, gy, &record);
+        if (goalIndex >= 0 && track_write_path(track, goalIndex, sx, sy, outPath))
+            return finish_query(space->options.telemetry, &record, PATH_RESULT_FOUND, startTime);
+
+        // A tree rooted on the agent's tile already gave the definitive answer.
+        if (track->rootX == sx && track->rootY == sy)
+            break;
+        stale = true;
+    }
+
+    if (!search_contains(space, gx, gy))
+        return finish_query(space->options.telemetry, &record, PATH_RESULT_WINDOW_TOO_LARGE, startTime);
+    return finish_query(space->options.telemetry, &record, PATH_RESULT_EXHAUSTED, startTime);
+}
+
+void pathfinding_track_end(PathTrackPool* pool, PathTrackHandle handle)
+{
+    PathTrack* track = track_get(pool, handle);
+    if (track)
+        track->used = false;
 }
@@ -4,6 +4,7 @@
 #include <string.h>
 
 #include "behavior.h"
+#include "counter_rng.h"
 #include "tile.h"
 
 #ifndef PI
@@ -22,13 +23,8 @@ static bool zombie_is_valid_target(const Entity* self, const Entity* other)
     if (!other || other == self || !other->active || !other->type)
         return false;
 
-    if (entity_type_is_category(other->type, "undead") || entity_type_is_category(other->type, "undead"))
-        return false;
-    if (entity_type_is_category(other->type, "demon") || entity_type_is_category(other->type, "démon"))
-        return false;
-    if (entity_type_has_trait(other->type, "undead") || entity_type_has_trait(other->type, "demon") || entity_type_has_trait(other->type, "démon"))
-        return false;
-    return true;
+    const uint32_t kin = ENTITY_TAG_CATEGORY_UNDEAD | ENTITY_TAG_CATEGORY_DEMON | ENTITY_TAG_TRAIT_UNDEAD | ENTITY_TAG_TRAIT_DEMON;
+    return (other->type->relationTags & kin) == 0;
 }
 
 static uint16_t zombie_pick_target(EntitySystem* sys, Entity* self)
@@ -62,13 +58,14 @@ static void zombie_pick_direction(EntitySystem* sys, Entity* e, ZombieBrain* bra
     if (!sys || !e || !e->type || !brain)
         return;
 
-    float angle = entity_randomf(sys, 0.0f, 2.0f * PI);
-    float speed = e->type->maxSpeed * entity_randomf(sys, 0.45f, 1.0f);
+    uint64_t key   = entity_rng_key(sys, e->id, ENTITY_RNG_WANDER);
+    float    angle = counter_rng_range(key, 0, 0.0f, 2.0f * PI);
+    float    speed = e->type->maxSpeed * counter_rng_range(key, 1, 0.45f, 1.0f);
 
     e->velocity.x      = cosf(angle) * speed;
     e->velocity.y      = sinf(angle) * speed;
     e->orientation     = angle;
-    brain->wanderTimer = entity_randomf(sys, 1.2f, 3.6f);
+    brain->wanderTimer = counter_rng_range(key, 2, 1.2f, 3.6f);
 }
 
 static void zombie_on_spawn(EntitySystem* sys, Entity* e)
@@ -54,6 +54,14 @@ bool ui_is_input_blocked(void);
  */
 bool ui_is_paused(void);
 
+/**
+ * @brief True while the menu shows Settings > Performance: the simulation keeps
+ *        stepping behind it so tunable edits show in the profiler readout.
+ *
+ * World input (hotkeys, editing) stays suspended as for any paused frame.
+ */
+bool ui_keeps_simulation_running(void);
+
 /**
  * @brief Lets the main loop know the user picked the "Exit" option.
  */
@@ -9,6 +9,8 @@
 #include "object.h"
 #include "music.h"
 #include "localization.h"
+#include "profiler.h"
+#include "tunables.h"
 
 #include <math.h>
 #include <stdio.h>
@@ -18,7 +20,7 @@
 #define SLOT_MARGIN 8.0f
 #define MAX_SLOTS_PER_ROW 10
 #define INVENTORY_TABS 3
-#define SETTINGS_SECTION_COUNT 3
+#define SETTINGS_SECTION_COUNT 4
 
 enum
 {
@@ -31,7 +33,8 @@ enum
 {
     SETTINGS_SECTION_AUDIO   = 0,
     SETTINGS_SECTION_KEYS    = 1,
-    SETTINGS_SECTION_GENERAL = 2
+    SETTINGS_SECTION_GENERAL     = 2,
+    SETTINGS_SECTION_PERFORMANCE = 3
 };
 
 static const char* TAB_KEYS[INVENTORY_TABS] = {
@@ -44,6 +47,7 @@ static const char* SETTINGS_TAB_KEYS[SETTINGS_SECTION_COUNT] = {
     "ui.settings.tab.audio",
     "ui.settings.tab.keys",
     "ui.settings.tab.general",
+    "ui.settings.tab.performance",
 };
 
 static const char* PAUSE_BUTTON_KEYS[] = {
@@ -589,6 +593,57 @@ static void draw_general_settings(Rectangle content)
     }
 }
 
+static void draw_performance_settings(Rectangle content)
+{
+    const UiTheme* ui        = theme();
+    const float    rowHeight = 22.0f;
+    const float    rowGap    = 2.0f;
+
+    char line[160];
+    snprintf(line,
+             sizeof(line),
+             localization_get("ui.settings.perf.readout"),
+             profiler_average_ms(PROFILER_FRAME),
+             profiler_average_ms(PROFILER_SIMULATION),
+             profiler_average_ms(PROFILER_CHUNKS),
+             profiler_average_count(PROFILER_COUNT_PATH_QUERIES));
+    DrawText(line, (int)content.x, (int)content.y, 16, ui->textSecondary);
+
+    float top = content.y + 24.0f;
+    for (int id = 0; id < TUNABLE_COUNT; ++id)
+    {
+        const TunableDef* def = tunable_def((TunableId)id);
+        Rectangle         row = {content.x, top + id * (rowHeight + rowGap), content.width, rowHeight};
+        DrawRectangleRounded(row, 0.2f, 4, ColorAlpha(ui->textSecondary, 0.08f));
+        DrawText(localization_get(def->labelKey), (int)(row.x + 8.0f), (int)(row.y + 3.0f), 16, ui->textPrimary);
+
+        char value[32];
+        if (def->integer)
+            snprintf(value, sizeof(value), "%d", tunable_get_int((TunableId)id));
+        else
+            snprintf(value, sizeof(value), "%.2f", tunable_get((TunableId)id));
+
+        Rectangle plusBtn  = {row.x + row.width - 30.0f, row.y, 30.0f, rowHeight};
+        Rectangle valueBox = {plusBtn.x - 72.0f, row.y, 68.0f, rowHeight};
+        Rectangle minusBtn = {valueBox.x - 34.0f, row.y, 30.0f, rowHeight};
+        draw_text_centered(value, valueBox, 16, ui->accentBright);
+
+        float current = tunable_get((TunableId)id);
+        if (draw_button(minusBtn, "-", current > def->minValue))
+            tunable_step((TunableId)id, -1);
+        if (draw_button(plusBtn, "+", current < def->maxValue))
+            tunable_step((TunableId)id, 1);
+    }
+
+    // Reset/save share the bottom row with the back button.
+    Rectangle resetBtn = {content.x, content.y + content.height + 8.0f, 150.0f, 46.0f};
+    Rectangle saveBtn  = {resetBtn.x + resetBtn.width + 12.0f, resetBtn.y, 150.0f, 46.0f};
+    if (draw_button(resetBtn, localization_get("ui.settings.perf.reset"), true))
+        tunables_reset_defaults();
+    if (draw_button(saveBtn, localization_get("ui.settings.perf.save"), true))
+        tunables_save(NULL);
+}
+
 static void draw_settings(InputState* input)
 {
     const UiTheme* ui    = theme();
@@ -598,7 +653,7 @@ static void draw_settings(InputState* input)
     Rectangle title = {panel.x, panel.y + 16.0f, panel.width, 32.0f};
     draw_text_centered(localization_get("ui.settings.title"), title, 26, ui->textPrimary);
 
-    float tabWidth  = (panel.width - 64.0f) / SETTINGS_SECTION_COUNT;
+    float tabWidth  = (panel.width - 64.0f - 12.0f * (SETTINGS_SECTION_COUNT - 1)) / SETTINGS_SECTION_COUNT;
     float tabHeight = 36.0f;
     float tabX      = panel.x + 32.0f;
     float tabY      = panel.y + 62.0f;
@@ -616,6 +671,8 @@ static void draw_settings(InputState* input)
         draw_audio_settings(content);
     else if (g_ui.settingsSection == SETTINGS_SECTION_KEYS)
         draw_key_settings(content, input);
+    else if (g_ui.settingsSection == SETTINGS_SECTION_PERFORMANCE)
+        draw_performance_settings(content);
     else
         draw_general_settings(content);
 
@@ -851,6 +908,11 @@ bool ui_is_paused(void)
     return g_ui.pauseOpen;
 }
 
+bool ui_keeps_simulation_running(void)
+{
+    return g_ui.pauseOpen && g_ui.settingsOpen && g_ui.settingsSection == SETTINGS_SECTION_PERFORMANCE;
+}
+
 bool ui_should_close_application(void)
 {
     return g_ui.requestExit;
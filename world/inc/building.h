@@ -7,7 +7,7 @@
  * A "building" is typically defined as a contiguous enclosed space
  * surrounded by wall-type tiles and possibly containing objects or
  * furniture. The detection process analyzes the world map to identify
- * these enclosed regions and populate the global building list.
+ * these enclosed regions and populate the map's building registries.
  *
  * @date 2025-10-23
  * @author Hugo
@@ -29,38 +29,48 @@ struct EntitySystem;
 // QUERIES
 // -----------------------------------------------------------------------------
 
-/** Maximum number of generated structures tracked simultaneously. */
-#define MAX_GENERATED_BUILDINGS MAX_BUILDINGS
-/** Maximum number of player-created structures tracked simultaneously. */
-#define MAX_PLAYER_BUILDINGS MAX_BUILDINGS
+/*
+ * BuildingSystem (world.h) holds the registries, pantries and detection
+ * scratch of one map (Map::buildings); every query below takes the system it
+ * works on.
+ */
+
+/** Clears @p sys to an empty world (no buildings, no pantries, no structure markers). */
+void building_system_init(BuildingSystem* sys);
+
+/** Frees the resident/object lists and pantries of every building in @p sys. */
+void building_system_release(BuildingSystem* sys);
 
 /** Returns the number of procedurally generated structures currently tracked. */
-int building_generated_count(void);
+int building_generated_count(const BuildingSystem* sys);
 
 /** Returns the number of player-created buildings currently tracked. */
-int building_player_count(void);
+int building_player_count(const BuildingSystem* sys);
 
 /** Returns the total number of buildings (generated + player-built). */
-int building_total_count(void);
+int building_total_count(const BuildingSystem* sys);
 
 /** Retrieves a read-only pointer to a building by global index. */
-const Building* building_get(int index);
+const Building* building_get(const BuildingSystem* sys, int index);
 
 /** Retrieves a mutable pointer to a building by global index. */
-Building* building_get_mutable(int index);
+Building* building_get_mutable(BuildingSystem* sys, int index);
 
 /** Retrieves a read-only pointer to a generated structure by index. */
-const Building* building_get_generated(int index);
+const Building* building_get_generated(const BuildingSystem* sys, int index);
 
 /** Retrieves a read-only pointer to a player-created building by index. */
-const Building* building_get_player(int index);
+const Building* building_get_player(const BuildingSystem* sys, int index);
 
 // -----------------------------------------------------------------------------
 // FUNCTIONS
 // -----------------------------------------------------------------------------
 
+/** Returns a counter bumped by every building detection pass (indices may change when it does). */
+unsigned int building_detection_generation(const BuildingSystem* sys);
+
 /**
- * @brief Detects enclosed buildings within the given map and updates the global building list.
+ * @brief Detects enclosed buildings within the given map and updates its building registries (Map::buildings).
  *
  * This function performs a flood-fill or contour search on the map to locate
  * enclosed areas bounded by structural wall tiles. Each enclosed area is
@@ -89,25 +99,21 @@ void register_building_with_metadata(Map* map, Rectangle bounds, StructureKind k
 
 void building_add_resident(Building* b, struct Entity* e);
 void building_remove_resident(Building* b, uint16_t entityId);
+/** Home of @p e, looked up in the buildings of its entity system. */
 Building* entity_get_home(const struct Entity* e);
-Building* building_get_for_species(const char* species, int villageId);
+Building* building_get_for_species(BuildingSystem* sys, const char* species, int villageId);
 int building_active_residents(const Building* b, const struct EntitySystem* sys);
-Building* building_get_at_tile(int tileX, int tileY);
-void building_debug_print(const Building* b, const struct EntitySystem* sys);
-
-/**
- * @brief Clears structure kind markers stored on the map grid.
- */
-void building_clear_structure_markers(void);
+Building* building_get_at_tile(BuildingSystem* sys, int tileX, int tileY);
+void building_debug_print(BuildingSystem* buildings, const Building* b, const struct EntitySystem* sys);
 
 /**
  * @brief Marks that a reserved resident has been instantiated for a building.
  */
-void building_on_reservation_spawn(int buildingId);
+void building_on_reservation_spawn(BuildingSystem* sys, int buildingId);
 
 /**
  * @brief Marks that a reserved resident has been hibernated for a building.
  */
-void building_on_reservation_hibernate(int buildingId);
+void building_on_reservation_hibernate(BuildingSystem* sys, int buildingId);
 
 #endif /* BUILDING_H */
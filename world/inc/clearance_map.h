@@ -0,0 +1,49 @@
+/**
+ * @file clearance_map.h
+ * @brief Per-tile clearance (distance to the nearest obstacle) for sized agents.
+ *
+ * Map::clearance holds, for every tile, the Chebyshev distance in tiles to the
+ * nearest blocking tile or to the map border, capped at
+ * @ref CLEARANCE_MAP_MAX. Blocking means an unwalkable tile or an object that
+ * is never walkable; doors count as free since they exist to be passed.
+ *
+ * @ref clearance_map_rebuild runs one distance transform after world
+ * generation. From then on the map edit helpers report changes and only the
+ * tiles within @ref CLEARANCE_MAP_MAX of an edit are recomputed.
+ */
+
+#ifndef CLEARANCE_MAP_H
+#define CLEARANCE_MAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "world.h"
+
+/** @brief Largest stored clearance, in tiles; also bounds the local update window. */
+#define CLEARANCE_MAP_MAX 8
+
+/** @brief Drops the clearance data; edits are ignored until the next rebuild. */
+void clearance_map_reset(Map* map);
+
+/** @brief Recomputes the clearance of every tile (one full distance transform). */
+void clearance_map_rebuild(Map* map);
+
+/** @brief True once @ref clearance_map_rebuild ran for @p map. */
+bool clearance_map_ready(const Map* map);
+
+/** @brief Refreshes clearance around an edited tile (wrapped coordinates). */
+void clearance_map_on_tile_changed(Map* map, int tileX, int tileY);
+
+/** @brief Refreshes clearance around every tile of [x0, x1) x [y0, y1). */
+void clearance_map_on_rect_changed(Map* map, int x0, int y0, int x1, int y1);
+
+/**
+ * @brief Clearance a tile needs for an agent of the given radius to stand on its centre.
+ *
+ * An agent centred on a tile overlaps its neighbours once its radius reaches
+ * half a tile; the result is the number of rings its footprint covers plus one.
+ */
+uint8_t clearance_map_required(float agentRadius);
+
+#endif /* CLEARANCE_MAP_H */
@@ -0,0 +1,57 @@
+/**
+ * @file climate_field.h
+ * @brief Per-tile climate simulation driven by seasons, diffusion and heat sources.
+ *
+ * World generation hands its temperature, humidity and height maps to this
+ * module instead of discarding them. They become the static base layers of
+ * @ref ClimateLayers; the live temperature and humidity layers relax toward a
+ * per-tile target (tile type values, which already follow the season, plus
+ * the local worldgen anomaly, altitude and nearby heat) and diffuse between
+ * neighbours.
+ *
+ * Updates run at a fixed simulation rate. Each step processes a fixed number
+ * of square blocks in round-robin order across the job system, so the cost
+ * per tick is bounded regardless of the map size. Blocks are computed from
+ * the current layers into scratch buffers and committed afterwards, making
+ * the result independent of the thread count. The stepping progress and the
+ * scratch buffers live in Map::climateStepper.
+ */
+
+#ifndef CLIMATE_FIELD_H
+#define CLIMATE_FIELD_H
+
+#include "world.h"
+
+/* CLIMATE_BLOCK_SIZE and CLIMATE_BLOCKS_PER_STEP live in world.h (ClimateStepper). */
+/** @brief Simulation seconds between two climate steps. */
+#define CLIMATE_STEP_SECONDS 0.25f
+/** @brief Lowest temperature representable in the quantised layer (°C). */
+#define CLIMATE_TEMP_MIN -40.0f
+/** @brief Highest temperature representable in the quantised layer (°C). */
+#define CLIMATE_TEMP_MAX 60.0f
+
+/**
+ * @brief Stores the worldgen climate maps and initialises the live layers.
+ *
+ * All inputs are row-major [height * width] arrays normalised to [0, 1].
+ */
+void climate_field_capture(Map* map, const float* temperatureMap, const float* humidityMap, const float* heightMap, int width, int height);
+
+/** @brief Snaps the live layers to their current targets (no diffusion). */
+void climate_field_reset(Map* map);
+
+/**
+ * @brief Advances the climate by @p deltaSeconds of simulation time.
+ *
+ * Runs at most a few fixed steps per call; surplus time is dropped so time
+ * warp cannot stall a frame.
+ */
+void climate_field_update(Map* map, float deltaSeconds);
+
+/** @brief Local temperature in °C (0 outside the map). */
+float climate_field_temperature_at(const Map* map, int tileX, int tileY);
+
+/** @brief Local humidity in [0, 1] (0 outside the map). */
+float climate_field_humidity_at(const Map* map, int tileX, int tileY);
+
+#endif /* CLIMATE_FIELD_H */
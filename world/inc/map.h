@@ -78,6 +78,14 @@ TileTypeID map_get_tile(Map* map, int x, int y);
  */
 void map_set_tile(Map* map, int x, int y, TileTypeID id);
 
+/**
+ * @brief Recomputes the texture variation byte of every tile.
+ *
+ * Needed after tiles were written directly (world generation); edits made
+ * through map_set_tile() keep their variant up to date.
+ */
+void map_refresh_tile_variants(Map* map);
+
 /**
  * @brief Places a new object on the map, replacing any previous one.
  *
@@ -97,6 +105,43 @@ void map_place_object(Map* map, ObjectTypeID id, int x, int y);
  */
 void map_remove_object(Map* map, int x, int y);
 
+/**
+ * @brief Returns whether the tile holds an object (decor or record).
+ */
+bool map_has_object(const Map* map, int x, int y);
+
+/**
+ * @brief Returns the type of the object on a tile.
+ *
+ * @return The object's type definition, or `NULL` if the tile is empty.
+ */
+const ObjectType* map_object_type_at(const Map* map, int x, int y);
+
+/**
+ * @brief Returns the full record of the object on a tile, if it has one.
+ *
+ * Activatable objects always have a record; static decor only once promoted.
+ *
+ * @return The record, or `NULL` for an empty tile or plain decor.
+ */
+Object* map_object_record(const Map* map, int x, int y);
+
+/**
+ * @brief Ensures the object on a tile has a full record and returns it.
+ *
+ * Used when decor gains per-instance state (e.g. it takes damage).
+ *
+ * @return The record, or `NULL` if the tile is empty or the pool is exhausted.
+ */
+Object* map_object_promote(Map* map, int x, int y);
+
+/**
+ * @brief Returns whether the object on a tile lets entities walk through.
+ *
+ * Empty tiles are walkable; the terrain is not considered.
+ */
+bool map_object_walkable_at(const Map* map, int x, int y);
+
 /**
  * @brief Toggles a door object between open and closed states.
  *
@@ -112,4 +157,37 @@ void map_remove_object(Map* map, int x, int y);
  */
 bool map_toggle_door(Map* map, int x, int y, bool open);
 
+/**
+ * @brief Records that walkability may have changed over [x0, x1) x [y0, y1).
+ *
+ * Tile and object edits made through this module are recorded automatically;
+ * other writers (object state changes) report their own.
+ */
+void map_note_walkability_change(Map* map, int x0, int y0, int x1, int y1);
+
+/** @brief Records a door opening or closing on a tile. */
+void map_note_door_change(Map* map, int x, int y);
+
+/**
+ * @brief Flags the chunks overlapping [x0, x1) x [y0, y1) for rehashing.
+ *
+ * Tile and object-cell edits made through this module flag themselves; other
+ * writers of Map::tiles, Map::objectCells or the live climate layers must call
+ * this so state_hash_compute() picks their change up.
+ *
+ * @param layers MAP_DIGEST_* layers that changed.
+ */
+void map_note_digest_change(Map* map, int x0, int y0, int x1, int y1, uint8_t layers);
+
+/** @brief Counter bumped by every @ref map_note_walkability_change call on @p map. */
+unsigned int map_walkability_generation(const Map* map);
+
+/**
+ * @brief Whether walkability may have changed inside a rectangle since a generation.
+ *
+ * Only the most recent changes are remembered; older generations always
+ * report a change. Agents that open doors themselves can skip door changes.
+ */
+bool map_walkability_changed_since(const Map* map, unsigned int generation, int x0, int y0, int x1, int y1, bool ignoreDoors);
+
 #endif /* MAP_H */
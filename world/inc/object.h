@@ -17,6 +17,26 @@
 
 #include "world.h"
 
+// -----------------------------------------------------------------------------
+// DYNAMIC OBJECT SETS
+// -----------------------------------------------------------------------------
+
+/** Chunk grid the dynamic object sets are bucketed by (matches the render chunks). */
+#define OBJECT_DRAW_CHUNKS_X MAP_CHUNKS_X
+#define OBJECT_DRAW_CHUNKS_Y MAP_CHUNKS_Y
+
+/*
+ * The record pool and dynamic sets (ObjectPool, ObjectDynamics) are part of
+ * the Map; record creation, activation, update and drawing work on the map
+ * they are given.
+ */
+
+/** @brief Empties the map's record pool and dynamic sets and requests an initial environment rebuild. */
+void object_records_init(Map* map);
+
+/** @brief Frees the map's record blocks and list storage. Records must already be destroyed. */
+void object_records_release(Map* map);
+
 // -----------------------------------------------------------------------------
 // FUNCTION DECLARATIONS
 // -----------------------------------------------------------------------------
@@ -62,27 +82,69 @@ const StructureDef* analyze_building_type(const Building* b);
 ObjectTypeID object_type_id_from_name(const char* name);
 
 /**
- * @brief Creates a new object instance and places it on the map.
+ * @brief Creates a new object record for the given tile.
  *
- * This function allocates and initializes an @ref Object
- * of the specified type at the given tile coordinates.
+ * This function takes an @ref Object from the record pool and initializes
+ * it for the specified type at the given tile coordinates. Records never
+ * move once created; Object::handle identifies them in Map::objectSlots.
  *
+ * @param[in,out] map Map whose record pool provides the record.
  * @param[in] id Type identifier of the object to create.
  * @param[in] x  X coordinate in tile units.
  * @param[in] y  Y coordinate in tile units.
  * @return Pointer to the created @ref Object instance, or `NULL` on failure.
  *
- * @note The created object must later be managed (stored or freed)
- *       by the map or object system.
+ * @note Use map_place_object() or map_object_promote() to attach objects to
+ *       the map; this function does not touch the map layers.
  */
-Object* create_object(ObjectTypeID id, int x, int y);
+Object* create_object(Map* map, ObjectTypeID id, int x, int y);
 
 /**
- * @brief Releases memory associated with an object instance.
+ * @brief Returns an object record to the pool.
  *
+ * @param[in,out] map Map that owns the record.
  * @param[in,out] obj Pointer to the object to destroy.
  */
-void object_destroy(Object* obj);
+void object_destroy(Map* map, Object* obj);
+
+/**
+ * @brief Resolves a pool handle of @p map to its live record.
+ *
+ * @param[in] map    Map that owns the pool.
+ * @param[in] handle 1-based handle (0 means no record).
+ * @return The record, or `NULL` if the handle is empty or released.
+ */
+Object* object_from_handle(const Map* map, uint16_t handle);
+
+/**
+ * @brief Number of object records currently allocated from the pool.
+ */
+int object_record_count(const Map* map);
+
+/**
+ * @brief Number of record slots allocated so far; live handles are at most this value.
+ */
+int object_record_capacity(const Map* map);
+
+/**
+ * @brief Whether objects of this type always need a full record.
+ *
+ * Activatable types carry activation and animation state; every other type
+ * is stored as packed decor until something promotes it (e.g. damage).
+ */
+bool object_type_needs_record(const ObjectType* type);
+
+/**
+ * @brief Picks the static frame variation for a type placed on a tile.
+ *
+ * The choice is a hash of the tile and type, so it is stable across runs.
+ */
+int object_type_pick_variant(const ObjectType* type, int tileX, int tileY);
+
+/**
+ * @brief Requests a rebuild of the light and heat fields on the next update.
+ */
+void object_mark_environment_dirty(Map* map);
 
 /**
  * @brief Returns whether the object supports activation toggling.
@@ -92,19 +154,21 @@ bool object_has_activation(const Object* obj);
 /**
  * @brief Sets the activation state of an object, triggering animations if defined.
  *
+ * @param[in,out] map Map the object lives on; walkability changes are logged there.
  * @param[in,out] obj Pointer to the object instance.
  * @param[in] active Desired activation state.
  * @return true if the state changed, false otherwise.
  */
-bool object_set_active(Object* obj, bool active);
+bool object_set_active(Map* map, Object* obj, bool active);
 
 /**
  * @brief Toggles the activation state of an object.
  *
+ * @param[in,out] map Map the object lives on.
  * @param[in,out] obj Pointer to the object instance.
  * @return true if the state changed, false otherwise.
  */
-bool object_toggle(Object* obj);
+bool object_toggle(Map* map, Object* obj);
 
 /**
  * @brief Draws all active objects on the map using the given camera view.
@@ -156,6 +220,14 @@ Rectangle object_type_frame_rect(const ObjectType* type, int frameIndex);
  */
 Vector2 object_frame_draw_position(const Object* obj, int frameWidth, int frameHeight);
 
+/**
+ * @brief Computes the draw position of a frame for a type anchored on a tile.
+ *
+ * Same placement rule as object_frame_draw_position(), for packed decor that
+ * has no @ref Object record.
+ */
+Vector2 object_type_draw_position(const ObjectType* type, int tileX, int tileY, int frameWidth, int frameHeight);
+
 /**
  * @brief Returns the currently visible frame index for a static object.
  *
@@ -25,12 +25,15 @@ typedef struct Pantry
     int counts[PANTRY_ITEM_MAX];
 } Pantry;
 
-void      pantry_system_reset(void);
-Pantry*   pantry_create_or_get(int buildingId, int capacity);
-Pantry*   pantry_get_for_building(int buildingId);
+/* Registries are per world: BuildingSystem::pantries (see world.h). */
+struct PantryRegistry;
+
+void      pantry_system_reset(struct PantryRegistry* reg);
+Pantry*   pantry_create_or_get(struct PantryRegistry* reg, int buildingId, int capacity);
+Pantry*   pantry_get_for_building(struct PantryRegistry* reg, int buildingId);
 bool      pantry_deposit(Pantry* pantry, PantryItemType type, int quantity);
 int       pantry_withdraw(Pantry* pantry, PantryItemType type, int quantity);
-void      pantry_remove(int buildingId);
+void      pantry_remove(struct PantryRegistry* reg, int buildingId);
 void      pantry_debug_draw(const Pantry* pantry, Vector2 screenPosition);
 
 #ifdef __cplusplus
@@ -59,6 +59,28 @@ void unload_tile_types(void);
  */
 TileType* get_tile_type(TileTypeID id);
 
+/**
+ * @brief Picks the texture variation of a tile from its coordinates.
+ *
+ * The result is stored per tile in Map::tileVariants when the tile is set, so
+ * draw paths only look it up.
+ *
+ * @param[in] type   Tile definition.
+ * @param[in] tileX  World X coordinate of the tile.
+ * @param[in] tileY  World Y coordinate of the tile.
+ * @return Variation index in [0, textureVariations).
+ */
+uint8_t tile_variant_at(const TileType* type, int tileX, int tileY);
+
+/**
+ * @brief Returns the precomputed source rectangle of a texture variation.
+ *
+ * @param[in] type    Tile definition.
+ * @param[in] variant Variation index (see @ref tile_variant_at).
+ * @return Rectangle defining the portion of the texture to draw.
+ */
+Rectangle tile_variant_rect(const TileType* type, int variant);
+
 /**
  * @brief Computes the source rectangle to use when drawing a tile, taking into account texture variations.
  *
@@ -72,12 +94,11 @@ Rectangle tile_get_source_rect(const TileType* type, int tileX, int tileY);
 /**
  * @brief Draws the tile at the specified destination pixel coordinates.
  *
- * @param[in] type  Tile definition.
- * @param[in] tileX World X coordinate of the tile (for variation hashing).
- * @param[in] tileY World Y coordinate of the tile.
- * @param[in] destX Destination pixel X.
- * @param[in] destY Destination pixel Y.
+ * @param[in] type    Tile definition.
+ * @param[in] variant Texture variation of the tile (Map::tileVariants).
+ * @param[in] destX   Destination pixel X.
+ * @param[in] destY   Destination pixel Y.
  */
-void tile_draw(const TileType* type, int tileX, int tileY, float destX, float destY);
+void tile_draw(const TileType* type, int variant, float destX, float destY);
 
 #endif /* TILE_H */
@@ -0,0 +1,59 @@
+/**
+ * @file tile_stats.h
+ * @brief Incremental tile-type histograms kept per chunk, with regional queries.
+ *
+ * The map is split into CHUNK_W x CHUNK_H cells, each holding a count of every
+ * tile type it contains; the histograms live in Map::tileStats. @ref tile_stats_rebuild fills the histograms once
+ * after world generation; from then on map_set_tile() reports every edit so
+ * the counts (and the global totals derived from them) stay exact in O(1).
+ *
+ * Area queries sum whole chunks, so a rectangle or radius query covers every
+ * chunk it touches rather than the exact tile footprint.
+ */
+
+#ifndef TILE_STATS_H
+#define TILE_STATS_H
+
+#include <stdbool.h>
+
+#include "raylib.h"
+#include "world.h"
+
+/* TileStatsSummary and the per-map TileStats live in world.h (Map::tileStats). */
+
+/** @brief Drops every histogram; edits are ignored until the next rebuild. */
+void tile_stats_reset(Map* map);
+
+/** @brief Rebuilds every chunk histogram from the map (one full scan). */
+void tile_stats_rebuild(Map* map);
+
+/** @brief True once @ref tile_stats_rebuild ran for @p map. */
+bool tile_stats_ready(const Map* map);
+
+/** @brief Records a tile edit. Called by map_set_tile() with wrapped coordinates. */
+void tile_stats_on_tile_changed(Map* map, int tileX, int tileY, TileTypeID before, TileTypeID after);
+
+/** @brief Biome a tile type is reported under in statistics. */
+BiomeKind tile_stats_biome_of(TileTypeID tile);
+
+/** @brief Whole-map totals. */
+const TileStatsSummary* tile_stats_global(const Map* map);
+
+/** @brief Sums the chunks in [chunkX0, chunkX1] x [chunkY0, chunkY1] (clamped to the map). */
+void tile_stats_query_chunks(const Map* map, int chunkX0, int chunkY0, int chunkX1, int chunkY1, TileStatsSummary* out);
+
+/** @brief Sums the chunks overlapping a rectangle in world pixels (e.g. the camera view). */
+void tile_stats_query_rect(const Map* map, Rectangle worldRect, TileStatsSummary* out);
+
+/** @brief Sums the chunks overlapping a circle of @p radius tiles around a tile. */
+void tile_stats_query_radius(const Map* map, int tileX, int tileY, int radius, TileStatsSummary* out);
+
+/**
+ * @brief Averages the map's seasonal tile-type climate (Map::tileClimate) over a summary.
+ *
+ * @param biome Restricts the average to one biome; BIO_MAX averages every tile.
+ * @return Number of tiles averaged (outputs are left at 0 when none).
+ */
+int tile_stats_climate_means(const Map* map, const TileStatsSummary* stats, BiomeKind biome, float* fertility, float* humidity, float* temperature);
+
+#endif /* TILE_STATS_H */
@@ -17,6 +17,8 @@
 #include "raylib.h"
 #include <stdbool.h>
 #include <stdint.h>
+
+#include "pantry.h"
 /**
  * @def MAP_WIDTH
  * @brief Width of the game map in tiles.
@@ -35,6 +37,12 @@
  */
 #define TILE_SIZE 64
 
+/**
+ * @def TILE_MAX_VARIATIONS
+ * @brief Texture variations usable per tile type (the per-tile variant is one byte).
+ */
+#define TILE_MAX_VARIATIONS 256
+
 /**
  * @def MAX_BUILDINGS
  * @brief Maximum number of buildings that can be tracked simultaneously.
@@ -401,6 +409,8 @@ typedef struct
     int spriteSpacingX;    /**< Horizontal spacing between frames, in pixels. */
     int spriteSpacingY;    /**< Vertical spacing between frames, in pixels. */
 
+    Rectangle* frameRects; /**< Source rect of each of the spriteFrameCount frames (derived at load). */
+
     int   activationFrameInactive; /**< Frame index (0-based) representing the inactive state. */
     int   activationFrameActive;   /**< Frame index (0-based) representing the active state. */
     float activationFrameTime;     /**< Time per animation frame when toggling states (seconds). */
@@ -432,9 +442,26 @@ typedef struct Object
         bool  forward;      /**< True if animating towards higher frame indices. */
     } animation;
 
-    struct Object* nextDynamic; /**< Intrusive list pointer for dynamic rendering. */
+    struct Object* nextFree;     /**< Free list link while the record sits in the pool. */
+    int            animSlot;     /**< Index in the animating set, -1 when idle. */
+    int            drawSlot;     /**< Index in its chunk's dynamic draw list, -1 if not listed. */
+    uint16_t       handle;       /**< 1-based pool handle stored in Map::objectSlots. */
 } Object;
 
+/**
+ * @struct ObjectCell
+ * @brief Packed object entry of one map tile.
+ *
+ * Static decor lives entirely in this pair of bytes. Objects that need
+ * per-instance state (activation, animation, damage) additionally own a full
+ * @ref Object record referenced from Map::objectSlots.
+ */
+typedef struct
+{
+    uint8_t type;    /**< ObjectTypeID on the tile, OBJ_NONE when empty. */
+    uint8_t variant; /**< Static sprite frame chosen at placement. */
+} ObjectCell;
+
 /**
  * @struct ObjectRequirement
  * @brief Describes a condition based on object presence within a room.
@@ -466,99 +493,129 @@ typedef struct
     int          variationFrameHeight; /**< Height in pixels for a single variation frame (derived). */
     int          variationColumns;     /**< Number of columns in the variation grid (optional). */
     int          variationRows;        /**< Number of rows in the variation grid (optional). */
+    Rectangle*   variationRects;       /**< Source rect of each variation (derived at load). */
     bool         isBreakable;          /**< Whether the tile can be terraformed */
     int          durability;           /**< Hit points before terraformation */
     float        movementCost;         /**< Relative movement cost (1.0 = normal) */
-    float        darkness;             /**< Darkness factor [0.0 light .. 1.0 night]. */
-    float        fertility;            /**< Fertility level (0.0 - 1.0). */
-    float        humidity;             /**< Humidity level (0.0 dry to 1.0 wet). */
-    float        temperature;          /**< Current temperature in °C. */
+    float        fertility;            /**< Base fertility level (0.0 - 1.0). */
+    float        humidity;             /**< Base humidity level (0.0 dry to 1.0 wet). */
+    float        temperature;          /**< Base temperature in °C. */
 } TileType;
 
 /**
- * @struct Map
- * @brief Represents the full world grid, including terrain and objects.
+ * @struct TileClimate
+ * @brief Seasonal climate of a tile type on one map (see Map::tileClimate).
+ */
+typedef struct
+{
+    float fertility;   /**< Fertility level (0.0 - 1.0). */
+    float humidity;    /**< Humidity level (0.0 dry to 1.0 wet). */
+    float temperature; /**< Temperature in °C. */
+} TileClimate;
+
+/** @brief Side of a square climate update block in tiles (32x32 bytes per layer). */
+#define CLIMATE_BLOCK_SIZE 32
+/** @brief Climate blocks processed per climate step. */
+#define CLIMATE_BLOCKS_PER_STEP 16
+
+/**
+ * @struct ClimateLayers
+ * @brief Per-tile climate state stored as one byte per value (see climate_field.h).
  *
- * Each tile contains both a terrain type and an optional object instance.
+ * The base layers are the normalised worldgen drivers and never change after
+ * generation; temperature and humidity evolve during play.
  */
 typedef struct
 {
-    int        width;                             /**< Map width in tiles */
-    int        height;                            /**< Map height in tiles */
-    TileTypeID tiles[MAP_HEIGHT][MAP_WIDTH];      /**< 2D grid of terrain tiles */
-    Object*    objects[MAP_HEIGHT][MAP_WIDTH];    /**< 2D grid of placed objects */
-    float      lightField[MAP_HEIGHT][MAP_WIDTH]; /**< Accumulated light intensity per tile. */
-    float      heatField[MAP_HEIGHT][MAP_WIDTH];  /**< Accumulated heat intensity per tile. */
-} Map;
+    uint8_t baseTemperature[MAP_HEIGHT][MAP_WIDTH]; /**< Worldgen temperature driver (0..255 = 0..1). */
+    uint8_t baseHumidity[MAP_HEIGHT][MAP_WIDTH];    /**< Worldgen humidity driver (0..255 = 0..1). */
+    uint8_t height[MAP_HEIGHT][MAP_WIDTH];          /**< Worldgen height (0..255 = 0..1). */
+    uint8_t temperature[MAP_HEIGHT][MAP_WIDTH];     /**< Current temperature, quantised over the climate range. */
+    uint8_t humidity[MAP_HEIGHT][MAP_WIDTH];        /**< Current humidity (0..255 = 0..1). */
+} ClimateLayers;
 
-typedef struct StructureClusterMember
+/**
+ * @struct ClimateStepper
+ * @brief Fixed-step progress of the climate simulation (see climate_field.h).
+ *
+ * Blocks of a step are computed into the scratch slots across the job system
+ * and committed once every block is done.
+ */
+typedef struct
 {
-    StructureKind kind;     /**< Blueprint to instantiate as part of the cluster. */
-    int           minCount; /**< Minimum amount of this member. */
-    int           maxCount; /**< Maximum amount of this member. */
-} StructureClusterMember;
+    int      cursor;      /**< Round-robin index of the next block to step. */
+    float    accumulator; /**< Simulation seconds not yet consumed by a step. */
+    uint32_t stepIndex;   /**< Steps run since the last reset (dither salt). */
+    uint8_t  scratchTemperature[CLIMATE_BLOCKS_PER_STEP][CLIMATE_BLOCK_SIZE * CLIMATE_BLOCK_SIZE];
+    uint8_t  scratchHumidity[CLIMATE_BLOCKS_PER_STEP][CLIMATE_BLOCK_SIZE * CLIMATE_BLOCK_SIZE];
+} ClimateStepper;
+
+/** Chunk grid covering the map (same CHUNK_W x CHUNK_H tiling as the render cache). */
+#define MAP_CHUNKS_X ((MAP_WIDTH + CHUNK_W - 1) / CHUNK_W)
+#define MAP_CHUNKS_Y ((MAP_HEIGHT + CHUNK_H - 1) / CHUNK_H)
+
+/** Layers of a chunk whose digest is stale (see MapDigest). */
+#define MAP_DIGEST_TILES 0x01u   /**< Tiles or live climate changed. */
+#define MAP_DIGEST_OBJECTS 0x02u /**< Object cells changed. */
+#define MAP_DIGEST_ALL (MAP_DIGEST_TILES | MAP_DIGEST_OBJECTS)
 
 /**
- * @brief Generic, data-driven descriptor for a world structure.
+ * @struct MapDigest
+ * @brief Per-chunk fingerprints of the tile and object layers (see state_hash.h).
  *
- * This structure holds all the metadata required to define a type of structure,
- * including its size constraints, relative rarity for generation, and the
- * concrete function used to build it.
+ * Writers flag the chunks they touch through map_note_digest_change(); the
+ * next state hash only rehashes flagged chunks.
  */
-typedef struct StructureDef
+typedef struct
 {
-    char          name[64];             ///< Descriptive display name of the structure.
-    StructureKind kind;                 ///< The type/classification of the structure.
-    int           minWidth, maxWidth;   ///< Minimum and maximum width in map tiles.
-    int           minHeight, maxHeight; ///< Minimum and maximum height in map tiles.
-    float         rarity;               ///< Relative weight for drawing/picking this structure (higher = more common).
-    /**
-     * @brief Concrete construction callback.
-     *
-     * This function is responsible for placing walls, doors, objects, and
-     * other details that constitute the structure on the map.
-     * @param map The map where the structure will be built.
-     * @param x The top-left X coordinate of the structure's bounding box.
-     * @param y The top-left Y coordinate of the structure's bounding box.
-     * @param rng Pointer to the random number generator state.
-     */
-    void (*build)(Map* map, int x, int y, uint64_t* rng);
-    int      minInstances;      ///< Guaranteed minimum number of instances to spawn per world.
-    int      maxInstances;      ///< Maximum number of instances to spawn per world (0 = unlimited).
-    uint32_t allowedBiomesMask; ///< Bitmask restricting which biomes may host this structure (0 = any biome).
+    uint8_t  dirty[MAP_CHUNKS_Y][MAP_CHUNKS_X];   /**< MAP_DIGEST_* layers changed since the last hash. */
+    uint64_t tiles[MAP_CHUNKS_Y][MAP_CHUNKS_X];   /**< Tiles and live climate of each chunk. */
+    uint64_t objects[MAP_CHUNKS_Y][MAP_CHUNKS_X]; /**< Object cells of each chunk. */
+} MapDigest;
 
-    char  auraName[STRUCTURE_AURA_NAME_MAX];        ///< Short aura label.
-    char  auraDescription[STRUCTURE_AURA_DESC_MAX]; ///< Long form aura description.
-    float auraRadius;                               ///< Aura influence radius (in tiles).
-    float auraIntensity;                            ///< Aura intensity score (arbitrary units).
+/** Walkability edits remembered by a map (see map_walkability_changed_since()). */
+#define MAP_EDIT_LOG_SIZE 64
 
-    EntitiesTypeID occupantType;                                                ///< Default resident type.
-    int            occupantMin;                                                 ///< Minimum number of residents.
-    int            occupantMax;                                                 ///< Maximum number of residents.
-    char           occupantDescription[STRUCTURE_OCCUPANT_DESC_MAX];            ///< Resident label/description.
-    char           triggerDescription[STRUCTURE_TRIGGER_DESC_MAX];              ///< Description of the structure's triggered action/effect.
-    char           species[BUILDING_SPECIES_NAME_MAX];                          ///< Normalised species owning the structure.
-    int            speciesId;                                                   ///< Stable species identifier for the owning faction.
-    bool           hasPantry;                                                   ///< True if the structure exposes a pantry inventory.
-    int            pantryCapacity;                                              ///< Maximum number of food stacks stored in the pantry.
-    int            roleCount;                                                   ///< Number of role labels bound to resident slots.
-    char           roles[STRUCTURE_MAX_RESIDENT_ROLES][BUILDING_ROLE_NAME_MAX]; ///< Role labels for residents.
+typedef struct
+{
+    unsigned int generation;
+    int          x0, y0, x1, y1;
+    bool         door;
+} MapEdit;
 
-    char                   clusterGroup[STRUCTURE_CLUSTER_NAME_MAX];      ///< Optional identifier grouping related structures.
-    bool                   clusterAnchor;                                 ///< Whether this blueprint seeds a cluster.
-    int                    clusterMinMembers;                             ///< Minimum number of additional members to attempt.
-    int                    clusterMaxMembers;                             ///< Maximum number of additional members to attempt.
-    float                  clusterRadiusMin;                              ///< Minimum scatter radius (tiles).
-    float                  clusterRadiusMax;                              ///< Maximum scatter radius (tiles).
-    int                    clusterMemberCount;                            ///< Number of explicit cluster member descriptors.
-    StructureClusterMember clusterMembers[STRUCTURE_CLUSTER_MAX_MEMBERS]; ///< Member descriptors.
+/**
+ * @struct MapEditLog
+ * @brief Ring of the latest walkability changes, so incremental path searches
+ * can tell whether their window was touched.
+ */
+typedef struct
+{
+    MapEdit      entries[MAP_EDIT_LOG_SIZE];
+    unsigned int generation; /**< Bumped by every recorded change. */
+} MapEditLog;
 
-    RoomTypeID        roomId;                                   ///< Identifier matching RoomTypeID for classification.
-    int               minArea;                                  ///< Minimum interior area required to match.
-    int               maxArea;                                  ///< Maximum interior area (0 = unlimited).
-    ObjectRequirement requirements[STRUCTURE_MAX_REQUIREMENTS]; ///< List of object presence requirements.
-    int               requirementCount;                         ///< Number of active requirements.
-} StructureDef;
+/**
+ * @struct TileStatsSummary
+ * @brief Tile and biome counts over a set of chunks (see tile_stats.h).
+ */
+typedef struct TileStatsSummary
+{
+    int totalTiles;            /**< Tiles covered by the query. */
+    int chunkCount;            /**< Chunks summed. */
+    int tileCounts[TILE_MAX];  /**< Tiles per type. */
+    int biomeCounts[BIO_MAX];  /**< Tiles per biome (see tile_stats_biome_of()). */
+} TileStatsSummary;
+
+/**
+ * @struct TileStats
+ * @brief Per-chunk tile histograms of a map and their whole-map totals.
+ */
+typedef struct
+{
+    uint16_t         chunkCounts[MAP_CHUNKS_Y][MAP_CHUNKS_X][TILE_MAX]; /**< A chunk holds at most CHUNK_W * CHUNK_H tiles. */
+    TileStatsSummary global;                                           /**< Sum of every chunk. */
+    bool             ready;                                            /**< Built for the current terrain. */
+} TileStats;
 
 /**
  * @struct Building
@@ -575,7 +632,7 @@ typedef struct Building
     int                        area;          /**< Interior area in tiles */
     char                       name[64];      /**< Inferred or generic building name */
     int                        objectCount;   /**< Number of objects inside */
-    Object**                   objects;       /**< Pointer to a dynamic list of object instances */
+    ObjectTypeID*              objectTypes;   /**< Types of the interior objects (walls and doors excluded) */
     RoomTypeID                 roomTypeId;    /**< Detected room category (optional) */
     StructureKind              structureKind; /**< Optional originating structure blueprint. */
     const struct StructureDef* structureDef;  /**< Back-reference to immutable structure definition. */
@@ -604,6 +661,81 @@ typedef struct Building
     int                        residentCapacity;                                            /**< Allocated capacity for resident ids. */
 } Building;
 
+/**
+ * @struct PantryRegistry
+ * @brief Pantries of one world's buildings (see pantry.h).
+ */
+typedef struct PantryRegistry
+{
+    Pantry entries[MAX_BUILDINGS];
+    int    count;
+} PantryRegistry;
+
+/** Maximum number of generated structures tracked simultaneously. */
+#define MAX_GENERATED_BUILDINGS MAX_BUILDINGS
+/** Maximum number of player-created structures tracked simultaneously. */
+#define MAX_PLAYER_BUILDINGS MAX_BUILDINGS
+
+/**
+ * @struct BuildingSystem
+ * @brief Building registries, pantries and detection scratch of one map (see building.h).
+ */
+typedef struct BuildingSystem
+{
+    Building       generated[MAX_GENERATED_BUILDINGS];
+    Building       player[MAX_PLAYER_BUILDINGS];
+    int            generatedCount;
+    int            playerCount;
+    int            nextBuildingId;
+    unsigned int   detectionGeneration;                         /**< Bumped by every detection pass. */
+    unsigned int   visitedStamp[MAP_HEIGHT][MAP_WIDTH];         /**< Flood-fill stamps of the latest pass. */
+    unsigned int   visitedGeneration;                           /**< Next stamp handed to a pass. */
+    StructureKind  structureMarkers[MAP_HEIGHT][MAP_WIDTH];     /**< Generated footprint kinds (STRUCT_COUNT = none). */
+    int            structureVillageIds[MAP_HEIGHT][MAP_WIDTH];  /**< Village of each generated footprint tile (-1 = none). */
+    int            structureSpeciesIds[MAP_HEIGHT][MAP_WIDTH];  /**< Species of each generated footprint tile (0 = none). */
+    PantryRegistry pantries;                                    /**< Food stores of the buildings with a pantry. */
+} BuildingSystem;
+
+/** Object records live in fixed-size blocks so pointers held by the dynamic sets
+ *  stay valid; a record is addressed from the map by its 1-based 16-bit handle. */
+#define OBJECT_POOL_BLOCK_SIZE 256
+#define OBJECT_POOL_MAX_BLOCKS 255
+
+/**
+ * @struct ObjectPool
+ * @brief Promoted object records of one map (see Map::objectSlots).
+ */
+typedef struct ObjectPool
+{
+    Object* blocks[OBJECT_POOL_MAX_BLOCKS];
+    int     blockCount;
+    Object* freeList;
+    int     live;       /**< Records currently handed out. */
+} ObjectPool;
+
+/** Dense list of object records; each record keeps its own index for swap-removal. */
+typedef struct ObjectPtrList
+{
+    Object** items;
+    int      count;
+    int      capacity;
+} ObjectPtrList;
+
+/**
+ * @struct ObjectDynamics
+ * @brief Per-map tracking of dynamic objects.
+ *
+ * Holds the records currently animating (walked by the update) and, per map
+ * chunk, every dynamic record of that chunk (walked by the draw for visible
+ * chunks only), plus the pending light/heat rebuild.
+ */
+typedef struct ObjectDynamics
+{
+    ObjectPtrList animating;
+    ObjectPtrList chunks[MAP_CHUNKS_Y][MAP_CHUNKS_X];
+    bool          environmentDirty; /**< Light and heat fields need a rebuild. */
+} ObjectDynamics;
+
 /**
  * @brief Parameters for world generation.
  *
@@ -655,6 +787,144 @@ typedef struct
     float biome_struct_mult_hell;     ///< Structure chance multiplier for the Hell biome.
 } WorldGenParams;
 
+typedef struct
+{
+    int           x;
+    int           y;
+    StructureKind kind;
+    int           doorX;
+    int           doorY;
+    int           boundsX;
+    int           boundsY;
+    int           boundsW;
+    int           boundsH;
+    int           speciesId;
+    int           villageId;
+} PlacedStructure;
+
+/**
+ * @brief Per-world generator state: seed, parameters and village numbering.
+ *
+ * The placement fields point at generate_world()'s working buffers while it
+ * runs, so village and custom structure placement share them; they are NULL
+ * otherwise.
+ */
+typedef struct WorldGenState
+{
+    uint64_t         seed64;          /**< Root of every worldgen splitmix64 stream. */
+    WorldGenParams   cfg;             /**< Active generation parameters. */
+    int              nextVillageId;   /**< Identifier given to the next generated village. */
+    PlacedStructure* placed;          /**< Structures placed so far. */
+    int*             placedCount;     /**< Number of entries in placed. */
+    int              placedCap;       /**< Capacity of placed. */
+    int*             structureCounts; /**< Instances placed per StructureKind. */
+    uint64_t*        rng;             /**< Placement and structure builder stream. */
+} WorldGenState;
+
+/**
+ * @struct Map
+ * @brief Represents the full world grid, including terrain and objects.
+ *
+ * Each tile contains a terrain type and an optional object. Objects are stored
+ * as packed cells; only those needing instance state are promoted to records
+ * (see map_object_record()).
+ */
+typedef struct
+{
+    int        width;                             /**< Map width in tiles */
+    int        height;                            /**< Map height in tiles */
+    TileTypeID tiles[MAP_HEIGHT][MAP_WIDTH];      /**< 2D grid of terrain tiles */
+    uint8_t    tileVariants[MAP_HEIGHT][MAP_WIDTH]; /**< Texture variation of each tile (see tile_variant_at()). */
+    ObjectCell objectCells[MAP_HEIGHT][MAP_WIDTH]; /**< Packed object layer (type + variant per tile). */
+    uint16_t   objectSlots[MAP_HEIGHT][MAP_WIDTH]; /**< Pool handle of a promoted Object record, 0 for plain decor. */
+    uint8_t    clearance[MAP_HEIGHT][MAP_WIDTH];   /**< Tiles to the nearest obstacle (see clearance_map.h). */
+    float      lightField[MAP_HEIGHT][MAP_WIDTH]; /**< Accumulated light intensity per tile. */
+    float      heatField[MAP_HEIGHT][MAP_WIDTH];  /**< Accumulated heat intensity per tile. */
+    TileClimate   tileClimate[TILE_MAX];          /**< Tile type climate drifting with the season (world_apply_season_effects()). */
+    TileClimate   climateMean;                    /**< Map-wide average of tileClimate over every tile. */
+    ClimateLayers climate;                        /**< Local temperature/humidity simulated per tile. */
+    ClimateStepper climateStepper;                /**< Fixed-step progress of the climate layers. */
+    MapDigest     digest;                         /**< Cached per-chunk state fingerprints. */
+    ObjectPool     objectPool;                    /**< Records behind Map::objectSlots (see object.h). */
+    ObjectDynamics objectSets;                    /**< Animating and per-chunk dynamic records. */
+    BuildingSystem buildings;                     /**< Detected and generated buildings (see building.h). */
+    WorldGenState  worldgen;                      /**< Generator state (see world_generation.h). */
+    struct ChunkGrid* chunks;                     /**< Render cache (see world_chunk.h), NULL when headless. */
+    MapEditLog    edits;                          /**< Latest walkability changes. */
+    TileStats     tileStats;                      /**< Per-chunk tile histograms. */
+    bool          clearanceReady;                 /**< Map::clearance is built (see clearance_map.h). */
+    uint8_t       clearanceScratch[MAP_HEIGHT * MAP_WIDTH]; /**< Distance transform workspace. */
+} Map;
+
+typedef struct StructureClusterMember
+{
+    StructureKind kind;     /**< Blueprint to instantiate as part of the cluster. */
+    int           minCount; /**< Minimum amount of this member. */
+    int           maxCount; /**< Maximum amount of this member. */
+} StructureClusterMember;
+
+/**
+ * @brief Generic, data-driven descriptor for a world structure.
+ *
+ * This structure holds all the metadata required to define a type of structure,
+ * including its size constraints, relative rarity for generation, and the
+ * concrete function used to build it.
+ */
+typedef struct StructureDef
+{
+    char          name[64];             ///< Descriptive display name of the structure.
+    StructureKind kind;                 ///< The type/classification of the structure.
+    int           minWidth, maxWidth;   ///< Minimum and maximum width in map tiles.
+    int           minHeight, maxHeight; ///< Minimum and maximum height in map tiles.
+    float         rarity;               ///< Relative weight for drawing/picking this structure (higher = more common).
+    /**
+     * @brief Concrete construction callback.
+     *
+     * This function is responsible for placing walls, doors, objects, and
+     * other details that constitute the structure on the map.
+     * @param map The map where the structure will be built.
+     * @param x The top-left X coordinate of the structure's bounding box.
+     * @param y The top-left Y coordinate of the structure's bounding box.
+     * @param rng Pointer to the random number generator state.
+     */
+    void (*build)(Map* map, int x, int y, uint64_t* rng);
+    int      minInstances;      ///< Guaranteed minimum number of instances to spawn per world.
+    int      maxInstances;      ///< Maximum number of instances to spawn per world (0 = unlimited).
+    uint32_t allowedBiomesMask; ///< Bitmask restricting which biomes may host this structure (0 = any biome).
+
+    char  auraName[STRUCTURE_AURA_NAME_MAX];        ///< Short aura label.
+    char  auraDescription[STRUCTURE_AURA_DESC_MAX]; ///< Long form aura description.
+    float auraRadius;                               ///< Aura influence radius (in tiles).
+    float auraIntensity;                            ///< Aura intensity score (arbitrary units).
+
+    EntitiesTypeID occupantType;                                                ///< Default resident type.
+    int            occupantMin;                                                 ///< Minimum number of residents.
+    int            occupantMax;                                                 ///< Maximum number of residents.
+    char           occupantDescription[STRUCTURE_OCCUPANT_DESC_MAX];            ///< Resident label/description.
+    char           triggerDescription[STRUCTURE_TRIGGER_DESC_MAX];              ///< Description of the structure's triggered action/effect.
+    char           species[BUILDING_SPECIES_NAME_MAX];                          ///< Normalised species owning the structure.
+    int            speciesId;                                                   ///< Stable species identifier for the owning faction.
+    bool           hasPantry;                                                   ///< True if the structure exposes a pantry inventory.
+    int            pantryCapacity;                                              ///< Maximum number of food stacks stored in the pantry.
+    int            roleCount;                                                   ///< Number of role labels bound to resident slots.
+    char           roles[STRUCTURE_MAX_RESIDENT_ROLES][BUILDING_ROLE_NAME_MAX]; ///< Role labels for residents.
+
+    char                   clusterGroup[STRUCTURE_CLUSTER_NAME_MAX];      ///< Optional identifier grouping related structures.
+    bool                   clusterAnchor;                                 ///< Whether this blueprint seeds a cluster.
+    int                    clusterMinMembers;                             ///< Minimum number of additional members to attempt.
+    int                    clusterMaxMembers;                             ///< Maximum number of additional members to attempt.
+    float                  clusterRadiusMin;                              ///< Minimum scatter radius (tiles).
+    float                  clusterRadiusMax;                              ///< Maximum scatter radius (tiles).
+    int                    clusterMemberCount;                            ///< Number of explicit cluster member descriptors.
+    StructureClusterMember clusterMembers[STRUCTURE_CLUSTER_MAX_MEMBERS]; ///< Member descriptors.
+
+    RoomTypeID        roomId;                                   ///< Identifier matching RoomTypeID for classification.
+    int               minArea;                                  ///< Minimum interior area required to match.
+    int               maxArea;                                  ///< Maximum interior area (0 = unlimited).
+    ObjectRequirement requirements[STRUCTURE_MAX_REQUIREMENTS]; ///< List of object presence requirements.
+    int               requirementCount;                         ///< Number of active requirements.
+} StructureDef;
+
 /**
  * @brief Defines the properties of a single biome cell or center point.
  *
@@ -688,21 +958,6 @@ typedef struct
     int                  structureCount;
 } BiomeDef;
 
-typedef struct
-{
-    int           x;
-    int           y;
-    StructureKind kind;
-    int           doorX;
-    int           doorY;
-    int           boundsX;
-    int           boundsY;
-    int           boundsW;
-    int           boundsH;
-    int           speciesId;
-    int           villageId;
-} PlacedStructure;
-
 typedef struct MapChunk
 {
     int             cx, cy;      // Chunk coordinates (in chunk units, not tiles)
@@ -716,7 +971,8 @@ typedef struct MapChunk
 
 typedef struct ChunkGrid
 {
-    int       chunksX, chunksY;
-    MapChunk* chunks; // [chunksY * chunksX]
+    int                   chunksX, chunksY;
+    MapChunk*             chunks;    // [chunksY * chunksX]
+    struct ChunkDrawList* drawLists; // Rebuild staging, one per batch slot (private to world_chunk.c)
 } ChunkGrid;
 #endif /* WORLD_H */
@@ -11,11 +11,7 @@
 #include <stdbool.h>
 #include "world.h"
 
-// ---------------------------------------------------------------------------
-//  Global access
-// ---------------------------------------------------------------------------
-
-extern ChunkGrid* gChunks; ///< Global pointer to the active chunk grid
+struct CameraMotion;
 
 // ---------------------------------------------------------------------------
 //  API
@@ -58,10 +54,13 @@ void chunkgrid_mark_all(ChunkGrid* cg, Map* map);
  * @brief Draw only chunks currently visible by the camera.
  *
  * This function lazily rebuilds missing or dirty chunks within a small
- * per-frame budget and draws their cached textures.  It should be called
- * once per frame during world rendering.
+ * per-frame budget and draws their cached textures.  Budget left after the
+ * visible chunks goes to the chunks the camera is predicted to reach next
+ * along @p motion (see camera_predict; NULL for a still camera), then to
+ * the preload ring.  It should be called once per frame during world
+ * rendering.
  */
-void chunkgrid_draw_visible(ChunkGrid* cg, Map* map, Camera2D* cam);
+void chunkgrid_draw_visible(ChunkGrid* cg, Map* map, Camera2D* cam, const struct CameraMotion* motion);
 
 /**
  * @brief Manually unload chunks that are far from the camera to save VRAM.
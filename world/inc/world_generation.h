@@ -18,14 +18,27 @@
 /** @name Configuration and Initialization */
 /// @{
 
+/**
+ * @brief Loads the structure metadata and biome definitions worlds are generated from.
+ *
+ * Generation only reads them, so they are loaded once per process, after the
+ * tile and object types, and shared by every world.
+ */
+void worldgen_load_definitions(void);
+
+/** @brief Resets @p state to the built-in seed and default parameters. */
+void worldgen_state_init(WorldGenState* state);
+
 /**
  * @brief Initializes the random number generator for world generation.
  *
  * This function should be called first to ensure deterministic generation
- * based on the provided seed.
+ * based on the provided seed. It also restarts village numbering, so
+ * consecutive worlds do not depend on each other.
+ * @param state Generator state to seed.
  * @param seed The 64-bit seed value to use for generation.
  */
-void worldgen_seed(uint64_t seed);
+void worldgen_seed(WorldGenState* state, uint64_t seed);
 
 /**
  * @brief Sets the high-level configuration parameters for world generation.
@@ -33,9 +46,10 @@ void worldgen_seed(uint64_t seed);
  * This function must be called before @ref generate_world to define the
  * characteristics (like biome distribution and structure density) of the
  * world to be generated.
+ * @param state Generator state to configure.
  * @param params Pointer to the structure containing all generation parameters.
  */
-void worldgen_config(const WorldGenParams* params);
+void worldgen_config(WorldGenState* state, const WorldGenParams* params);
 
 /// @}
 
@@ -46,8 +60,8 @@ void worldgen_config(const WorldGenParams* params);
  * placing tiles, generating biomes (potentially via Voronoi centers), and
  * spawning objects and structures.
  *
- * @note @ref worldgen_seed and @ref worldgen_config must be called prior
- * to this function.
+ * @note @ref worldgen_seed and @ref worldgen_config must be called on the
+ * map's Map::worldgen prior to this function.
  *
  * @param map Pointer to the Map structure where the world will be generated.
  */
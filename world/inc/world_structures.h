@@ -14,19 +14,37 @@
 #include "map.h"
 #include "object.h"
 
+/** @brief Per-biome alias tables of one world generation (see structure_samplers_create()). */
+typedef struct StructureSamplers StructureSamplers;
+
 /**
  * @brief Selects a random structure definition appropriate for a given biome.
  *
- * The selection is weighted by the @c rarity field of the StructureDef.
+ * Each biome entry weighs its @c weight times the @c rarity of its
+ * StructureDef. Draws come from the biome's alias table in O(1); the table is
+ * rebuilt only when a drawn kind turns out to have reached @c maxInstances.
+ * @param samplers Tables of the generation in progress.
  * @param biome The type of biome for which a structure is being sought.
- * @param rng Pointer to the random number generator state.
+ * @param rng Worldgen splitmix64 state the draw is taken from.
  * @param structureCounts Array tracking how many instances of each structure
  *                        kind have already been placed (may be NULL for no
  *                        limit checks).
  * @return A constant pointer to the selected StructureDef, or NULL if no
- * structure is defined for the biome.
+ * structure can spawn in the biome.
+ */
+const StructureDef* pick_structure_for_biome(StructureSamplers* samplers, BiomeKind biome, uint64_t* rng, const int* structureCounts);
+
+/**
+ * @brief Builds the per-biome alias tables used by @ref pick_structure_for_biome.
+ *
+ * Each generation owns its tables, since they drop the kinds that world has
+ * capped. Call after the structure metadata and biome definitions are loaded.
+ * @return The tables, or NULL when allocation fails.
  */
-const StructureDef* pick_structure_for_biome(BiomeKind biome, uint64_t* rng, const int* structureCounts);
+StructureSamplers* structure_samplers_create(void);
+
+/** @brief Releases tables built by @ref structure_samplers_create (NULL is ignored). */
+void structure_samplers_destroy(StructureSamplers* samplers);
 
 /**
  * @brief Retrieves the immutable definition associated with a structure kind.
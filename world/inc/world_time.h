@@ -38,6 +38,7 @@ typedef struct
     float      secondsPerDay;   /**< Real-time duration of one in-game day (defaults to 600s). */
     int        timeWarpIndex;   /**< Index into the debug time warp presets (0 = real-time). */
     float      lastDeltaSeconds;/**< Actual simulated seconds advanced during the last update. */
+    float      darkness;        /**< Darkness after the last update [0.0 day .. 1.0 night]. */
 } WorldTime;
 
 void world_time_init(WorldTime* t);
@@ -45,12 +46,14 @@ void world_time_update(WorldTime* t, float deltaTime);
 void world_time_cycle_timewarp(WorldTime* t);
 float world_time_get_timewarp_multiplier(const WorldTime* t);
 void world_time_draw_ui(const WorldTime* t, const Map* map, const Camera2D* camera);
+/** @brief Drifts the map's seasonal tile climate (Map::tileClimate) and steps its climate layers. */
 void world_apply_season_effects(Map* map, const WorldTime* t);
-float world_time_get_darkness(void);
-int   world_time_get_current_day(void);
-float world_time_get_time_of_day(void);
-float world_time_get_seconds_per_day(void);
-float world_time_get_last_step_seconds(void);
+/* Getters return 0 when @p t is NULL (no clock). */
+float world_time_get_darkness(const WorldTime* t);
+int   world_time_get_current_day(const WorldTime* t);
+float world_time_get_time_of_day(const WorldTime* t);
+float world_time_get_seconds_per_day(const WorldTime* t);
+float world_time_get_last_step_seconds(const WorldTime* t);
 
 #ifdef __cplusplus
 }
@@ -12,6 +12,7 @@
 #include "pantry.h"
 #include "tile.h"
 #include "object.h"
+#include "map.h"
 #include "world_structures.h"
 
 /* ===========================================
@@ -27,82 +28,103 @@ typedef struct
     bool      touchesBorder;
 } FloodResult;
 
-static Building gGeneratedBuildings[MAX_GENERATED_BUILDINGS];
-static Building gPlayerBuildings[MAX_PLAYER_BUILDINGS];
-static int      gGeneratedCount = 0;
-static int      gPlayerCount    = 0;
-static int      gNextBuildingId = 1;
+static bool building_residents_reserve(Building* b, int minCapacity);
+static void reset_building_list(BuildingSystem* sys, Building* list, int* count, int maxEntries);
 
-static unsigned int gVisitedStamp[MAP_HEIGHT][MAP_WIDTH];
-static unsigned int gVisitedGeneration = 1;
-static int          gStructureVillageIds[MAP_HEIGHT][MAP_WIDTH];
-static int          gStructureSpeciesIds[MAP_HEIGHT][MAP_WIDTH];
+static void clear_structure_markers(BuildingSystem* sys)
+{
+    for (int y = 0; y < MAP_HEIGHT; ++y)
+    {
+        for (int x = 0; x < MAP_WIDTH; ++x)
+        {
+            sys->structureMarkers[y][x]    = STRUCT_COUNT;
+            sys->structureVillageIds[y][x] = -1;
+            sys->structureSpeciesIds[y][x] = 0;
+        }
+    }
+}
 
-static bool building_residents_reserve(Building* b, int minCapacity);
-int         building_generated_count(void)
+void building_system_init(BuildingSystem* sys)
 {
-    return gGeneratedCount;
+    if (!sys)
+        return;
+    memset(sys, 0, sizeof(*sys));
+    sys->nextBuildingId    = 1;
+    sys->visitedGeneration = 1;
+    clear_structure_markers(sys);
 }
 
-int building_player_count(void)
+void building_system_release(BuildingSystem* sys)
 {
-    return gPlayerCount;
+    if (!sys)
+        return;
+    reset_building_list(sys, sys->generated, &sys->generatedCount, MAX_GENERATED_BUILDINGS);
+    reset_building_list(sys, sys->player, &sys->playerCount, MAX_PLAYER_BUILDINGS);
+    pantry_system_reset(&sys->pantries);
 }
 
-int building_total_count(void)
+int building_generated_count(const BuildingSystem* sys)
 {
-    return gGeneratedCount + gPlayerCount;
+    return sys ? sys->generatedCount : 0;
 }
 
-const Building* building_get_generated(int index)
+int building_player_count(const BuildingSystem* sys)
 {
-    if (index < 0 || index >= gGeneratedCount)
-        return NULL;
-    return &gGeneratedBuildings[index];
+    return sys ? sys->playerCount : 0;
+}
+
+unsigned int building_detection_generation(const BuildingSystem* sys)
+{
+    return sys ? sys->detectionGeneration : 0;
+}
+
+int building_total_count(const BuildingSystem* sys)
+{
+    return building_generated_count(sys) + building_player_count(sys);
 }
 
-const Building* building_get_player(int index)
+const Building* building_get_generated(const BuildingSystem* sys, int index)
 {
-    if (index < 0 || index >= gPlayerCount)
+    if (index < 0 || index >= building_generated_count(sys))
         return NULL;
-    return &gPlayerBuildings[index];
+    return &sys->generated[index];
 }
 
-const Building* building_get(int index)
+const Building* building_get_player(const BuildingSystem* sys, int index)
 {
-    if (index < 0)
+    if (index < 0 || index >= building_player_count(sys))
         return NULL;
-    if (index < gGeneratedCount)
-        return &gGeneratedBuildings[index];
-    index -= gGeneratedCount;
-    if (index < gPlayerCount)
-        return &gPlayerBuildings[index];
-    return NULL;
+    return &sys->player[index];
 }
 
-Building* building_get_mutable(int index)
+const Building* building_get(const BuildingSystem* sys, int index)
 {
-    if (index < 0)
+    if (index < 0 || !sys)
         return NULL;
-    if (index < gGeneratedCount)
-        return &gGeneratedBuildings[index];
-    index -= gGeneratedCount;
-    if (index < gPlayerCount)
-        return &gPlayerBuildings[index];
+    if (index < sys->generatedCount)
+        return &sys->generated[index];
+    index -= sys->generatedCount;
+    if (index < sys->playerCount)
+        return &sys->player[index];
     return NULL;
 }
 
-void building_on_reservation_spawn(int buildingId)
+Building* building_get_mutable(BuildingSystem* sys, int index)
 {
-    Building* b = building_get_mutable(buildingId);
+    return (Building*)building_get(sys, index);
+}
+
+void building_on_reservation_spawn(BuildingSystem* sys, int buildingId)
+{
+    Building* b = building_get_mutable(sys, buildingId);
     if (!b)
         return;
     b->occupantActive++;
 }
 
-void building_on_reservation_hibernate(int buildingId)
+void building_on_reservation_hibernate(BuildingSystem* sys, int buildingId)
 {
-    Building* b = building_get_mutable(buildingId);
+    Building* b = building_get_mutable(sys, buildingId);
     if (!b)
         return;
     b->occupantActive--;
@@ -164,12 +186,12 @@ int building_active_residents(const Building* b, const EntitySystem* sys)
     return count;
 }
 
-Building* building_get_at_tile(int tileX, int tileY)
+Building* building_get_at_tile(BuildingSystem* sys, int tileX, int tileY)
 {
-    int total = building_total_count();
+    int total = building_total_count(sys);
     for (int i = 0; i < total; ++i)
     {
-        Building* b = building_get_mutable(i);
+        Building* b = building_get_mutable(sys, i);
         if (!b)
             continue;
 
@@ -184,7 +206,7 @@ Building* building_get_at_tile(int tileX, int tileY)
     return NULL;
 }
 
-void building_debug_print(const Building* b, const EntitySystem* sys)
+void building_debug_print(BuildingSystem* buildings, const Building* b, const EntitySystem* sys)
 {
     if (!b)
     {
@@ -219,7 +241,7 @@ void building_debug_print(const Building* b, const EntitySystem* sys)
 
     if (b->hasPantry)
     {
-        Pantry* pantry = pantry_get_for_building(b->id);
+        Pantry* pantry = buildings ? pantry_get_for_building(&buildings->pantries, b->id) : NULL;
         if (pantry)
         {
             printf("  Pantry contents: meat=%d plant=%d capacity=%d\n", pantry->counts[PANTRY_ITEM_MEAT], pantry->counts[PANTRY_ITEM_PLANT], pantry->capacity);
@@ -235,18 +257,18 @@ void building_debug_print(const Building* b, const EntitySystem* sys)
 
 Building* entity_get_home(const Entity* e)
 {
-    if (!e || e->homeBuildingId < 0)
+    if (!e || e->homeBuildingId < 0 || !e->system)
         return NULL;
-    return building_get_mutable(e->homeBuildingId);
+    return building_get_mutable(e->system->buildings, e->homeBuildingId);
 }
 
-Building* building_get_for_species(const char* species, int villageId)
+Building* building_get_for_species(BuildingSystem* sys, const char* species, int villageId)
 {
     int speciesId = entity_species_id_from_label(species);
-    int total     = building_total_count();
+    int total     = building_total_count(sys);
     for (int i = 0; i < total; ++i)
     {
-        Building* b = building_get_mutable(i);
+        Building* b = building_get_mutable(sys, i);
         if (!b)
             continue;
         if (speciesId > 0 && b->speciesId != speciesId)
@@ -275,18 +297,18 @@ static inline int clamp_int(int value, int minValue, int maxValue)
     return value;
 }
 
-static void release_building(Building* b)
+static void release_building(BuildingSystem* sys, Building* b)
 {
     if (!b)
         return;
 
     if (b->hasPantry || b->pantryId >= 0)
-        pantry_remove(b->id);
+        pantry_remove(&sys->pantries, b->id);
 
-    if (b->objects)
+    if (b->objectTypes)
     {
-        free(b->objects);
-        b->objects = NULL;
+        free(b->objectTypes);
+        b->objectTypes = NULL;
     }
     b->objectCount = 0;
 
@@ -299,14 +321,14 @@ static void release_building(Building* b)
     b->residentCapacity = 0;
 }
 
-static void reset_building_list(Building* list, int* count, int maxEntries)
+static void reset_building_list(BuildingSystem* sys, Building* list, int* count, int maxEntries)
 {
     if (!list || !count)
         return;
 
     for (int i = 0; i < *count && i < maxEntries; ++i)
     {
-        release_building(&list[i]);
+        release_building(sys, &list[i]);
     }
 
     memset(list, 0, sizeof(Building) * (size_t)maxEntries);
@@ -333,7 +355,7 @@ static bool building_residents_reserve(Building* b, int minCapacity)
     return true;
 }
 
-static void remove_buildings_in_region(Building* list, int* count, Rectangle tileRegion)
+static void remove_buildings_in_region(BuildingSystem* sys, Building* list, int* count, Rectangle tileRegion)
 {
     if (!list || !count || *count <= 0)
         return;
@@ -342,7 +364,7 @@ static void remove_buildings_in_region(Building* list, int* count, Rectangle til
     {
         if (rectangles_overlap(list[i].bounds, tileRegion))
         {
-            release_building(&list[i]);
+            release_building(sys, &list[i]);
 
             if (i < *count - 1)
                 memmove(&list[i], &list[i + 1], (size_t)(*count - i - 1) * sizeof(Building));
@@ -363,40 +385,40 @@ static void remove_buildings_in_region(Building* list, int* count, Rectangle til
  * @brief Checks if an object is part of a building's structure.
  * (Wall, door, or any future structural element.)
  */
-static inline bool is_structural_object(const Object* obj)
+static inline bool is_structural_object(const ObjectType* type)
 {
-    if (!obj)
+    if (!type)
         return false;
 
-    return is_wall_object(obj) || is_door_object(obj);
+    return type->isWall || type->isDoor;
 }
 
 /**
  * @brief Checks if an object blocks walking without being structural.
  * Example: bed, table, chest -> blocks, but doesn't form a wall.
  */
-static inline bool is_non_structural_blocker(const Object* obj)
+static inline bool is_non_structural_blocker(const Map* map, int x, int y, const ObjectType* type)
 {
-    if (!obj)
+    if (!type)
         return false;
 
-    if (is_structural_object(obj))
+    if (is_structural_object(type))
         return false;
 
-    return !object_is_walkable(obj);
+    return !map_object_walkable_at(map, x, y);
 }
 
 /**
  * @brief Determines if an object contributes to the "structural boundary".
  * I.e., if it encloses the room.
  */
-static inline bool contributes_to_building_boundary(const Object* obj)
+static inline bool contributes_to_building_boundary(const ObjectType* type)
 {
-    if (!obj)
+    if (!type)
         return false;
 
     // Wall or door encloses the room
-    if (is_wall_object(obj) || is_door_object(obj))
+    if (type->isWall || type->isDoor)
         return true;
 
     /* FOR FUTURE ???*/
@@ -419,21 +441,6 @@ static inline bool contributes_to_building_boundary(const Object* obj)
  * - Walkable objects do not block.
  * - A room is valid if it is enclosed and does not touch the border.
  */
-static StructureKind gStructureMarkers[MAP_HEIGHT][MAP_WIDTH];
-
-void building_clear_structure_markers(void)
-{
-    for (int y = 0; y < MAP_HEIGHT; ++y)
-    {
-        for (int x = 0; x < MAP_WIDTH; ++x)
-        {
-            gStructureMarkers[y][x]    = STRUCT_COUNT;
-            gStructureVillageIds[y][x] = -1;
-            gStructureSpeciesIds[y][x] = 0;
-        }
-    }
-}
-
 static FloodResult perform_flood_fill(Map* map, int sx, int sy, unsigned int stamp, unsigned int visited[MAP_HEIGHT][MAP_WIDTH])
 {
     FloodResult res = {0};
@@ -479,7 +486,7 @@ static FloodResult perform_flood_fill(Map* map, int sx, int sy, unsigned int sta
             if (visited[ny][nx] == stamp)
                 continue;
 
-            Object* obj = map->objects[ny][nx];
+            const ObjectType* obj = map_object_type_at(map, nx, ny);
 
             if (!obj)
             {
@@ -489,15 +496,15 @@ static FloodResult perform_flood_fill(Map* map, int sx, int sy, unsigned int sta
             else if (contributes_to_building_boundary(obj))
             {
                 // Wall or door = boundary
-                if (is_wall_object(obj))
+                if (obj->isWall)
                     res.wallBoundaryCount++;
-                else if (is_door_object(obj))
+                else if (obj->isDoor)
                     res.doorCount++;
 
                 // We don't cross a wall/door: the room stops here
                 continue;
             }
-            else if (is_non_structural_blocker(obj))
+            else if (is_non_structural_blocker(map, nx, ny, obj))
             {
                 // Checks if the furniture touches an unvisited outside area (open wall, map border)
                 bool touchesOutside = false;
@@ -571,7 +578,7 @@ static bool is_valid_building_area(const FloodResult* r)
 /* ===========================================
  * 4. Initialization and collection
  * =========================================== */
-static void infer_structure_metadata_from_markers(const FloodResult* res, int* outSpeciesId, int* outVillageId)
+static void infer_structure_metadata_from_markers(const BuildingSystem* sys, const FloodResult* res, int* outSpeciesId, int* outVillageId)
 {
     if (outSpeciesId)
         *outSpeciesId = 0;
@@ -596,7 +603,7 @@ static void infer_structure_metadata_from_markers(const FloodResult* res, int* o
             if (tx < 0 || tx >= MAP_WIDTH)
                 continue;
 
-            int sid = gStructureSpeciesIds[ty][tx];
+            int sid = sys->structureSpeciesIds[ty][tx];
             if (sid > 0)
             {
                 bool found = false;
@@ -617,7 +624,7 @@ static void infer_structure_metadata_from_markers(const FloodResult* res, int* o
                 }
             }
 
-            int vid = gStructureVillageIds[ty][tx];
+            int vid = sys->structureVillageIds[ty][tx];
             if (vid >= 0)
             {
                 bool found = false;
@@ -686,7 +693,7 @@ static int compute_structure_resident_count(const StructureDef* def, int id, con
     return def->occupantMin + (int)(seed % (unsigned int)(span + 1));
 }
 
-static StructureKind infer_marker_kind(const FloodResult* res)
+static StructureKind infer_marker_kind(const BuildingSystem* sys, const FloodResult* res)
 {
     if (!res)
         return STRUCT_COUNT;
@@ -710,7 +717,7 @@ static StructureKind infer_marker_kind(const FloodResult* res)
     {
         for (int x = startX; x <= endX; ++x)
         {
-            StructureKind marker = gStructureMarkers[y][x];
+            StructureKind marker = sys->structureMarkers[y][x];
             if (marker >= 0 && marker < STRUCT_COUNT)
                 counts[marker]++;
         }
@@ -730,14 +737,14 @@ static StructureKind infer_marker_kind(const FloodResult* res)
     return (bestCount > 0) ? (StructureKind)bestIndex : STRUCT_COUNT;
 }
 
-static void init_building_structure(Building* b, int id, const FloodResult* res, StructureKind kind)
+static void init_building_structure(BuildingSystem* sys, Building* b, int id, const FloodResult* res, StructureKind kind)
 {
     b->id                   = id;
     b->bounds               = res->bounds;
     b->area                 = res->area;
     b->center               = (Vector2){res->bounds.x + res->bounds.width / 2.0f, res->bounds.y + res->bounds.height / 2.0f};
     b->objectCount          = 0;
-    b->objects              = NULL;
+    b->objectTypes          = NULL;
     b->roomTypeId           = ROOM_NONE;
     b->structureKind        = kind;
     b->speciesId            = 0;
@@ -755,7 +762,7 @@ static void init_building_structure(Building* b, int id, const FloodResult* res,
 
     int inferredSpecies = 0;
     int inferredVillage = -1;
-    infer_structure_metadata_from_markers(res, &inferredSpecies, &inferredVillage);
+    infer_structure_metadata_from_markers(sys, res, &inferredSpecies, &inferredVillage);
 
     if (def)
     {
@@ -822,7 +829,7 @@ static void init_building_structure(Building* b, int id, const FloodResult* res,
         b->villageId = inferredVillage;
     if (b->hasPantry)
     {
-        Pantry* pantry = pantry_create_or_get(b->id, b->pantryCapacity);
+        Pantry* pantry = pantry_create_or_get(&sys->pantries, b->id, b->pantryCapacity);
         if (pantry)
             b->pantryId = pantry->id;
     }
@@ -830,8 +837,8 @@ static void init_building_structure(Building* b, int id, const FloodResult* res,
 
 static void collect_building_objects(Map* map, Building* b, const FloodResult* res, unsigned int stamp, unsigned int visited[MAP_HEIGHT][MAP_WIDTH])
 {
-    Object** temp_objects    = (Object**)malloc(res->area * sizeof(Object*));
-    int      collected_count = 0;
+    ObjectTypeID* temp_objects    = (ObjectTypeID*)malloc(res->area * sizeof(ObjectTypeID));
+    int           collected_count = 0;
 
     for (int y = (int)res->bounds.y; y < res->bounds.y + res->bounds.height; ++y)
     {
@@ -840,28 +847,28 @@ static void collect_building_objects(Map* map, Building* b, const FloodResult* r
             if (visited[y][x] != stamp)
                 continue;
 
-            Object* obj = map->objects[y][x];
+            const ObjectType* obj = map_object_type_at(map, x, y);
             if (!obj)
                 continue;
 
             // We do not collect walls and doors (structural boundaries)
-            if (is_wall_object(obj) || is_door_object(obj))
+            if (obj->isWall || obj->isDoor)
                 continue;
 
             // All other interior objects (bed, table, torch, decor...) are collected
-            temp_objects[collected_count++] = obj;
+            temp_objects[collected_count++] = obj->id;
         }
     }
 
     b->objectCount = collected_count;
     if (collected_count > 0)
     {
-        b->objects = (Object**)malloc(collected_count * sizeof(Object*));
-        memcpy(b->objects, temp_objects, collected_count * sizeof(Object*));
+        b->objectTypes = (ObjectTypeID*)malloc(collected_count * sizeof(ObjectTypeID));
+        memcpy(b->objectTypes, temp_objects, collected_count * sizeof(ObjectTypeID));
     }
     else
     {
-        b->objects = NULL;
+        b->objectTypes = NULL;
     }
 
     free(temp_objects);
@@ -875,6 +882,8 @@ void update_building_detection(Map* map, Rectangle worldRegion)
     if (!map)
         return;
 
+    BuildingSystem* sys = &map->buildings;
+
     const float mapWidthPixels  = (float)(map->width * TILE_SIZE);
     const float mapHeightPixels = (float)(map->height * TILE_SIZE);
     const float padding         = (float)TILE_SIZE;
@@ -928,67 +937,67 @@ void update_building_detection(Map* map, Rectangle worldRegion)
 
     if (fullRebuild)
     {
-        reset_building_list(gGeneratedBuildings, &gGeneratedCount, MAX_GENERATED_BUILDINGS);
-        reset_building_list(gPlayerBuildings, &gPlayerCount, MAX_PLAYER_BUILDINGS);
-        gNextBuildingId = 1;
-        pantry_system_reset();
-        building_clear_structure_markers();
+        reset_building_list(sys, sys->generated, &sys->generatedCount, MAX_GENERATED_BUILDINGS);
+        reset_building_list(sys, sys->player, &sys->playerCount, MAX_PLAYER_BUILDINGS);
+        sys->nextBuildingId = 1;
+        pantry_system_reset(&sys->pantries);
+        clear_structure_markers(sys);
     }
     else
     {
-        remove_buildings_in_region(gGeneratedBuildings, &gGeneratedCount, tileRegion);
-        remove_buildings_in_region(gPlayerBuildings, &gPlayerCount, tileRegion);
+        remove_buildings_in_region(sys, sys->generated, &sys->generatedCount, tileRegion);
+        remove_buildings_in_region(sys, sys->player, &sys->playerCount, tileRegion);
     }
 
-    unsigned int stamp = gVisitedGeneration++;
-    if (gVisitedGeneration == 0)
+    unsigned int stamp = sys->visitedGeneration++;
+    if (sys->visitedGeneration == 0)
     {
-        memset(gVisitedStamp, 0, sizeof(gVisitedStamp));
-        gVisitedGeneration = 1;
-        stamp              = gVisitedGeneration++;
+        memset(sys->visitedStamp, 0, sizeof(sys->visitedStamp));
+        sys->visitedGeneration = 1;
+        stamp                         = sys->visitedGeneration++;
     }
 
     for (int y = startY; y <= endY; ++y)
     {
         for (int x = startX; x <= endX; ++x)
         {
-            if (gVisitedStamp[y][x] == stamp)
+            if (sys->visitedStamp[y][x] == stamp)
                 continue;
 
-            Object* obj = map->objects[y][x];
+            const ObjectType* obj = map_object_type_at(map, x, y);
 
-            if (obj && (is_structural_object(obj) || is_non_structural_blocker(obj)))
+            if (obj && (is_structural_object(obj) || is_non_structural_blocker(map, x, y, obj)))
             {
-                gVisitedStamp[y][x] = stamp;
+                sys->visitedStamp[y][x] = stamp;
                 continue;
             }
 
-            FloodResult res = perform_flood_fill(map, x, y, stamp, gVisitedStamp);
+            FloodResult res = perform_flood_fill(map, x, y, stamp, sys->visitedStamp);
             if (!is_valid_building_area(&res))
                 continue;
 
-            StructureKind kind        = infer_marker_kind(&res);
+            StructureKind kind        = infer_marker_kind(sys, &res);
             bool          isGenerated = (kind >= 0 && kind < STRUCT_COUNT);
 
             Building* b = NULL;
             if (isGenerated)
             {
-                if (gGeneratedCount >= MAX_GENERATED_BUILDINGS)
+                if (sys->generatedCount >= MAX_GENERATED_BUILDINGS)
                     continue;
-                b = &gGeneratedBuildings[gGeneratedCount];
+                b = &sys->generated[sys->generatedCount];
             }
             else
             {
-                if (gPlayerCount >= MAX_PLAYER_BUILDINGS)
+                if (sys->playerCount >= MAX_PLAYER_BUILDINGS)
                     continue;
-                b = &gPlayerBuildings[gPlayerCount];
+                b = &sys->player[sys->playerCount];
             }
 
-            int buildingId = gNextBuildingId++;
-            init_building_structure(b, buildingId, &res, kind);
+            int buildingId = sys->nextBuildingId++;
+            init_building_structure(sys, b, buildingId, &res, kind);
             b->isGenerated = isGenerated && b->structureDef != NULL;
 
-            collect_building_objects(map, b, &res, stamp, gVisitedStamp);
+            collect_building_objects(map, b, &res, stamp, sys->visitedStamp);
 
             const StructureDef* detected = analyze_building_type(b);
             if (detected)
@@ -1010,7 +1019,7 @@ void update_building_detection(Map* map, Rectangle worldRegion)
 
                 int inferredSpecies = 0;
                 int inferredVillage = -1;
-                infer_structure_metadata_from_markers(&res, &inferredSpecies, &inferredVillage);
+                infer_structure_metadata_from_markers(sys, &res, &inferredSpecies, &inferredVillage);
 
                 if (detected->species[0] != '\0')
                 {
@@ -1044,11 +1053,13 @@ void update_building_detection(Map* map, Rectangle worldRegion)
             }
 
             if (b->isGenerated)
-                gGeneratedCount++;
+                sys->generatedCount++;
             else
-                gPlayerCount++;
+                sys->playerCount++;
         }
     }
+
+    sys->detectionGeneration++;
 }
 
 void register_building_from_bounds(Map* map, Rectangle bounds, StructureKind kind)
@@ -1058,7 +1069,10 @@ void register_building_from_bounds(Map* map, Rectangle bounds, StructureKind kin
 
 void register_building_with_metadata(Map* map, Rectangle bounds, StructureKind kind, int speciesId, int villageId)
 {
-    (void)map;
+    if (!map)
+        return;
+
+    BuildingSystem* sys = &map->buildings;
 
     int ix = (int)bounds.x + 1;
     int iy = (int)bounds.y + 1;
@@ -1075,9 +1089,9 @@ void register_building_with_metadata(Map* map, Rectangle bounds, StructureKind k
         {
             if (x < 0 || x >= MAP_WIDTH)
                 continue;
-            gStructureMarkers[y][x]    = kind;
-            gStructureVillageIds[y][x] = villageId;
-            gStructureSpeciesIds[y][x] = speciesId;
+            sys->structureMarkers[y][x]    = kind;
+            sys->structureVillageIds[y][x] = villageId;
+            sys->structureSpeciesIds[y][x] = speciesId;
         }
     }
 }
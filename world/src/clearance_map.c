@@ -0,0 +1,165 @@
+/**
+ * @file clearance_map.c
+ * @brief Implements the clearance distance transform and its local updates.
+ */
+
+#include "clearance_map.h"
+
+#include <math.h>
+
+#include "map.h"
+#include "tile.h"
+
+static inline int clamp_coord(int v, int maxExclusive)
+{
+    if (v < 0)
+        return 0;
+    if (v > maxExclusive)
+        return maxExclusive;
+    return v;
+}
+
+/** True when no agent can ever stand on the tile. */
+static bool tile_blocks(const Map* map, int x, int y)
+{
+    const TileType* tile = get_tile_type(map->tiles[y][x]);
+    if (!tile || !tile->walkable)
+        return true;
+
+    const ObjectType* type = map_object_type_at(map, x, y);
+    if (!type || type->isDoor)
+        return false;
+    if (type->activatable)
+        return !type->activationWalkableOn && !type->activationWalkableOff;
+    return !type->walkable;
+}
+
+static inline uint8_t min_u8(uint8_t a, uint8_t b)
+{
+    return a < b ? a : b;
+}
+
+/**
+ * Two-pass Chebyshev distance transform over [x0, x1) x [y0, y1).
+ *
+ * Neighbours outside the map count as obstacles; neighbours inside the map but
+ * outside the window are unknown and treated as far away, so only tiles at
+ * least CLEARANCE_MAP_MAX away from an open window edge come out exact.
+ */
+static void transform_window(Map* map, int x0, int y0, int x1, int y1, uint8_t* scratch)
+{
+    const int     w       = x1 - x0;
+    const uint8_t FAR     = CLEARANCE_MAP_MAX;
+    const uint8_t OUTSIDE = 0;
+
+#define CELL(px, py) scratch[((py) - y0) * w + ((px) - x0)]
+#define SAMPLE(px, py)                                                                                                          \
+    (((px) < 0 || (py) < 0 || (px) >= map->width || (py) >= map->height) ? OUTSIDE                                             \
+     : ((px) < x0 || (py) < y0 || (px) >= x1 || (py) >= y1)              ? FAR                                                 \
+                                                                          : CELL(px, py))
+
+    for (int y = y0; y < y1; ++y)
+        for (int x = x0; x < x1; ++x)
+            CELL(x, y) = tile_blocks(map, x, y) ? 0 : FAR;
+
+    // Forward pass: left, upper-left, up, upper-right.
+    for (int y = y0; y < y1; ++y)
+    {
+        for (int x = x0; x < x1; ++x)
+        {
+            uint8_t d = CELL(x, y);
+            if (d == 0)
+                continue;
+            uint8_t best = min_u8(min_u8(SAMPLE(x - 1, y), SAMPLE(x - 1, y - 1)), min_u8(SAMPLE(x, y - 1), SAMPLE(x + 1, y - 1)));
+            if (best + 1 < d)
+                CELL(x, y) = (uint8_t)(best + 1);
+        }
+    }
+
+    // Backward pass: right, lower-right, down, lower-left.
+    for (int y = y1 - 1; y >= y0; --y)
+    {
+        for (int x = x1 - 1; x >= x0; --x)
+        {
+            uint8_t d = CELL(x, y);
+            if (d == 0)
+                continue;
+            uint8_t best = min_u8(min_u8(SAMPLE(x + 1, y), SAMPLE(x + 1, y + 1)), min_u8(SAMPLE(x, y + 1), SAMPLE(x - 1, y + 1)));
+            if (best + 1 < d)
+                CELL(x, y) = (uint8_t)(best + 1);
+        }
+    }
+
+#undef SAMPLE
+#undef CELL
+}
+
+void clearance_map_reset(Map* map)
+{
+    if (map)
+        map->clearanceReady = false;
+}
+
+void clearance_map_rebuild(Map* map)
+{
+    if (!map)
+        return;
+
+    uint8_t* scratch = map->clearanceScratch;
+    transform_window(map, 0, 0, map->width, map->height, scratch);
+
+    for (int y = 0; y < map->height; ++y)
+        for (int x = 0; x < map->width; ++x)
+            map->clearance[y][x] = scratch[y * map->width + x];
+
+    map->clearanceReady = true;
+}
+
+bool clearance_map_ready(const Map* map)
+{
+    return map && map->clearanceReady;
+}
+
+void clearance_map_on_rect_changed(Map* map, int x0, int y0, int x1, int y1)
+{
+    if (!clearance_map_ready(map) || x0 >= x1 || y0 >= y1)
+        return;
+
+    // Tiles within CLEARANCE_MAP_MAX of the edit may change; they are exact when
+    // the transform sees CLEARANCE_MAP_MAX further tiles around them.
+    const int R   = CLEARANCE_MAP_MAX;
+    int       ox0 = clamp_coord(x0 - R, map->width);
+    int       oy0 = clamp_coord(y0 - R, map->height);
+    int       ox1 = clamp_coord(x1 + R, map->width);
+    int       oy1 = clamp_coord(y1 + R, map->height);
+    int       wx0 = clamp_coord(x0 - 2 * R, map->width);
+    int       wy0 = clamp_coord(y0 - 2 * R, map->height);
+    int       wx1 = clamp_coord(x1 + 2 * R, map->width);
+    int       wy1 = clamp_coord(y1 + 2 * R, map->height);
+
+    uint8_t* scratch = map->clearanceScratch;
+    transform_window(map, wx0, wy0, wx1, wy1, scratch);
+
+    const int w = wx1 - wx0;
+    for (int y = oy0; y < oy1; ++y)
+        for (int x = ox0; x < ox1; ++x)
+            map->clearance[y][x] = scratch[(y - wy0) * w + (x - wx0)];
+}
+
+void clearance_map_on_tile_changed(Map* map, int tileX, int tileY)
+{
+    clearance_map_on_rect_changed(map, tileX, tileY, tileX + 1, tileY + 1);
+}
+
+uint8_t clearance_map_required(float agentRadius)
+{
+    if (agentRadius < 0.0f)
+        agentRadius = 0.0f;
+
+    // Rings beyond the centre tile touched by the footprint (matches the tile
+    // span tested by entity_position_is_walkable for a centred agent).
+    int rings = (int)floorf((TILE_SIZE * 0.5f + agentRadius) / (float)TILE_SIZE);
+    if (rings >= CLEARANCE_MAP_MAX)
+        rings = CLEARANCE_MAP_MAX - 1;
+    return (uint8_t)(rings + 1);
+}
@@ -0,0 +1,291 @@
+/**
+ * @file climate_field.c
+ * @brief Implements the per-tile climate layers and their blocked parallel update.
+ */
+
+#include "climate_field.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "jobs.h"
+#include "map.h"
+#include "tile.h"
+
+/** Local temperature spread (°C) carried by the worldgen temperature driver. */
+#define CLIMATE_TEMP_ANOMALY 12.0f
+/** Humidity spread carried by the worldgen humidity driver. */
+#define CLIMATE_HUMIDITY_ANOMALY 0.4f
+/** Height above which tiles cool with altitude, and the cooling at the peak. */
+#define CLIMATE_ALTITUDE_START 0.55f
+#define CLIMATE_ALTITUDE_LAPSE 18.0f
+/** Temperature added per unit of heat field, and its cap. */
+#define CLIMATE_HEAT_CELSIUS 4.0f
+#define CLIMATE_HEAT_MAX_CELSIUS 25.0f
+/** Humidity removed per unit of heat field. */
+#define CLIMATE_HEAT_DRYING 0.03f
+/** Fraction of the gap to the target closed per second. */
+#define CLIMATE_RELAX_RATE 0.02f
+/** Fraction of the gap to the neighbour average closed per second. */
+#define CLIMATE_DIFFUSION_RATE 0.05f
+/** Steps run at most per update call (surplus time is dropped). */
+#define CLIMATE_MAX_STEPS_PER_UPDATE 4
+
+#define CLIMATE_BLOCK_TILES (CLIMATE_BLOCK_SIZE * CLIMATE_BLOCK_SIZE)
+
+typedef struct ClimateStepJob
+{
+    Map* map;
+    int  firstBlock;  /**< Round-robin index of the first block in this step. */
+    int  blockCount;  /**< Blocks processed this step. */
+    int  blocksX;     /**< Blocks per map row. */
+    int  totalBlocks; /**< Blocks covering the map. */
+    float relax;      /**< Target blend for this step. */
+    float diffusion;  /**< Neighbour blend for this step. */
+} ClimateStepJob;
+
+// -----------------------------------------------------------------------------
+// Quantisation
+// -----------------------------------------------------------------------------
+
+static inline float unit_from_byte(uint8_t v)
+{
+    return (float)v * (1.0f / 255.0f);
+}
+
+static inline uint8_t byte_from_unit(float v)
+{
+    if (v <= 0.0f)
+        return 0;
+    if (v >= 1.0f)
+        return 255;
+    return (uint8_t)lrintf(v * 255.0f);
+}
+
+static inline float celsius_from_byte(uint8_t v)
+{
+    return CLIMATE_TEMP_MIN + unit_from_byte(v) * (CLIMATE_TEMP_MAX - CLIMATE_TEMP_MIN);
+}
+
+static inline float units_from_celsius(float celsius)
+{
+    return (celsius - CLIMATE_TEMP_MIN) / (CLIMATE_TEMP_MAX - CLIMATE_TEMP_MIN) * 255.0f;
+}
+
+/** Deterministic per-tile dither in [0, 1) so slow drifts survive 8-bit rounding. */
+static inline float dither(int x, int y, uint32_t salt)
+{
+    uint32_t h = (uint32_t)x * 0x9E3779B1u ^ (uint32_t)y * 0x85EBCA77u ^ salt * 0xC2B2AE3Du;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    return (float)(h >> 8) * (1.0f / 16777216.0f);
+}
+
+static inline uint8_t byte_dithered(float units, float noise)
+{
+    float v = floorf(units + noise);
+    if (v <= 0.0f)
+        return 0;
+    if (v >= 255.0f)
+        return 255;
+    return (uint8_t)v;
+}
+
+// -----------------------------------------------------------------------------
+// Targets
+// -----------------------------------------------------------------------------
+
+static float target_temperature(const Map* map, int x, int y)
+{
+    TileTypeID tile = map->tiles[y][x];
+    float      base = (tile >= 0 && tile < TILE_MAX) ? map->tileClimate[tile].temperature : 15.0f;
+
+    float anomaly  = (unit_from_byte(map->climate.baseTemperature[y][x]) - 0.5f) * CLIMATE_TEMP_ANOMALY;
+    float altitude = unit_from_byte(map->climate.height[y][x]) - CLIMATE_ALTITUDE_START;
+    float cooling  = altitude > 0.0f ? altitude / (1.0f - CLIMATE_ALTITUDE_START) * CLIMATE_ALTITUDE_LAPSE : 0.0f;
+    float heat     = fminf(map->heatField[y][x] * CLIMATE_HEAT_CELSIUS, CLIMATE_HEAT_MAX_CELSIUS);
+
+    return base + anomaly - cooling + heat;
+}
+
+static float target_humidity(const Map* map, int x, int y)
+{
+    TileTypeID tile = map->tiles[y][x];
+    float      base = (tile >= 0 && tile < TILE_MAX) ? map->tileClimate[tile].humidity : 0.5f;
+
+    float anomaly = (unit_from_byte(map->climate.baseHumidity[y][x]) - 0.5f) * CLIMATE_HUMIDITY_ANOMALY;
+    float drying  = map->heatField[y][x] * CLIMATE_HEAT_DRYING;
+
+    return fminf(1.0f, fmaxf(0.0f, base + anomaly - drying));
+}
+
+// -----------------------------------------------------------------------------
+// Blocked stencil update
+// -----------------------------------------------------------------------------
+
+static void block_bounds(const ClimateStepJob* job, int slot, int* x0, int* y0, int* x1, int* y1)
+{
+    int block = (job->firstBlock + slot) % job->totalBlocks;
+    *x0       = (block % job->blocksX) * CLIMATE_BLOCK_SIZE;
+    *y0       = (block / job->blocksX) * CLIMATE_BLOCK_SIZE;
+    *x1       = *x0 + CLIMATE_BLOCK_SIZE < job->map->width ? *x0 + CLIMATE_BLOCK_SIZE : job->map->width;
+    *y1       = *y0 + CLIMATE_BLOCK_SIZE < job->map->height ? *y0 + CLIMATE_BLOCK_SIZE : job->map->height;
+}
+
+/** Four-neighbour average, clamped at the map edge. */
+static inline float neighbour_average(const Map* map, uint8_t layer[MAP_HEIGHT][MAP_WIDTH], int x, int y)
+{
+    int xl = x > 0 ? x - 1 : x;
+    int xr = x + 1 < map->width ? x + 1 : x;
+    int yu = y > 0 ? y - 1 : y;
+    int yd = y + 1 < map->height ? y + 1 : y;
+    return ((float)layer[y][xl] + (float)layer[y][xr] + (float)layer[yu][x] + (float)layer[yd][x]) * 0.25f;
+}
+
+static void climate_compute_blocks(void* user, int slotBegin, int slotEnd)
+{
+    const ClimateStepJob* job = (const ClimateStepJob*)user;
+    Map*                  map = job->map;
+
+    for (int slot = slotBegin; slot < slotEnd; ++slot)
+    {
+        int x0, y0, x1, y1;
+        block_bounds(job, slot, &x0, &y0, &x1, &y1);
+
+        uint8_t* outT = map->climateStepper.scratchTemperature[slot];
+        uint8_t* outH = map->climateStepper.scratchHumidity[slot];
+        for (int y = y0; y < y1; ++y)
+        {
+            for (int x = x0; x < x1; ++x)
+            {
+                float curT = (float)map->climate.temperature[y][x];
+                float curH = (float)map->climate.humidity[y][x];
+
+                float nextT = curT + (units_from_celsius(target_temperature(map, x, y)) - curT) * job->relax +
+                              (neighbour_average(map, map->climate.temperature, x, y) - curT) * job->diffusion;
+                float nextH = curH + (target_humidity(map, x, y) * 255.0f - curH) * job->relax +
+                              (neighbour_average(map, map->climate.humidity, x, y) - curH) * job->diffusion;
+
+                int local   = (y - y0) * CLIMATE_BLOCK_SIZE + (x - x0);
+                outT[local] = byte_dithered(nextT, dither(x, y, map->climateStepper.stepIndex));
+                outH[local] = byte_dithered(nextH, dither(x, y, map->climateStepper.stepIndex ^ 0xA5A5A5A5u));
+            }
+        }
+    }
+}
+
+static void climate_commit_blocks(const ClimateStepJob* job)
+{
+    Map*                  map     = job->map;
+    const ClimateStepper* stepper = &map->climateStepper;
+    for (int slot = 0; slot < job->blockCount; ++slot)
+    {
+        int x0, y0, x1, y1;
+        block_bounds(job, slot, &x0, &y0, &x1, &y1);
+        for (int y = y0; y < y1; ++y)
+        {
+            const int local = (y - y0) * CLIMATE_BLOCK_SIZE;
+            memcpy(&map->climate.temperature[y][x0], &stepper->scratchTemperature[slot][local], (size_t)(x1 - x0));
+            memcpy(&map->climate.humidity[y][x0], &stepper->scratchHumidity[slot][local], (size_t)(x1 - x0));
+        }
+        map_note_digest_change(map, x0, y0, x1, y1, MAP_DIGEST_TILES);
+    }
+}
+
+static void climate_step(Map* map)
+{
+    ClimateStepper* stepper = &map->climateStepper;
+    ClimateStepJob  job     = {0};
+    job.map            = map;
+    job.blocksX        = (map->width + CLIMATE_BLOCK_SIZE - 1) / CLIMATE_BLOCK_SIZE;
+    job.totalBlocks    = job.blocksX * ((map->height + CLIMATE_BLOCK_SIZE - 1) / CLIMATE_BLOCK_SIZE);
+    job.firstBlock     = stepper->cursor;
+    job.blockCount     = job.totalBlocks < CLIMATE_BLOCKS_PER_STEP ? job.totalBlocks : CLIMATE_BLOCKS_PER_STEP;
+
+    // Every block is revisited once per sweep, so rates are scaled by the sweep length.
+    int   stepsPerSweep = (job.totalBlocks + job.blockCount - 1) / job.blockCount;
+    float elapsed       = CLIMATE_STEP_SECONDS * (float)stepsPerSweep;
+    job.relax           = 1.0f - expf(-CLIMATE_RELAX_RATE * elapsed);
+    job.diffusion       = fminf(0.25f, CLIMATE_DIFFUSION_RATE * elapsed);
+
+    jobs_parallel_for(job.blockCount, 1, climate_compute_blocks, &job);
+    climate_commit_blocks(&job);
+
+    stepper->cursor = (stepper->cursor + job.blockCount) % job.totalBlocks;
+    stepper->stepIndex++;
+}
+
+// -----------------------------------------------------------------------------
+// Public API
+// -----------------------------------------------------------------------------
+
+void climate_field_capture(Map* map, const float* temperatureMap, const float* humidityMap, const float* heightMap, int width, int height)
+{
+    if (!map)
+        return;
+
+    for (int y = 0; y < map->height; ++y)
+    {
+        for (int x = 0; x < map->width; ++x)
+        {
+            bool inside = temperatureMap && humidityMap && heightMap && x < width && y < height;
+            int  idx    = y * width + x;
+            map->climate.baseTemperature[y][x] = inside ? byte_from_unit(temperatureMap[idx]) : 128;
+            map->climate.baseHumidity[y][x]    = inside ? byte_from_unit(humidityMap[idx]) : 128;
+            map->climate.height[y][x]          = inside ? byte_from_unit(heightMap[idx]) : 0;
+        }
+    }
+    climate_field_reset(map);
+}
+
+void climate_field_reset(Map* map)
+{
+    if (!map)
+        return;
+
+    for (int y = 0; y < map->height; ++y)
+    {
+        for (int x = 0; x < map->width; ++x)
+        {
+            map->climate.temperature[y][x] = byte_from_unit(units_from_celsius(target_temperature(map, x, y)) / 255.0f);
+            map->climate.humidity[y][x]    = byte_from_unit(target_humidity(map, x, y));
+        }
+    }
+    map_note_digest_change(map, 0, 0, map->width, map->height, MAP_DIGEST_TILES);
+    map->climateStepper.cursor      = 0;
+    map->climateStepper.accumulator = 0.0f;
+    map->climateStepper.stepIndex   = 0;
+}
+
+void climate_field_update(Map* map, float deltaSeconds)
+{
+    if (!map || deltaSeconds <= 0.0f)
+        return;
+
+    ClimateStepper* stepper = &map->climateStepper;
+    stepper->accumulator += deltaSeconds;
+    int steps = 0;
+    while (stepper->accumulator >= CLIMATE_STEP_SECONDS && steps < CLIMATE_MAX_STEPS_PER_UPDATE)
+    {
+        climate_step(map);
+        stepper->accumulator -= CLIMATE_STEP_SECONDS;
+        steps++;
+    }
+    if (stepper->accumulator >= CLIMATE_STEP_SECONDS)
+        stepper->accumulator = 0.0f;
+}
+
+float climate_field_temperature_at(const Map* map, int tileX, int tileY)
+{
+    if (!map || tileX < 0 || tileY < 0 || tileX >= map->width || tileY >= map->height)
+        return 0.0f;
+    return celsius_from_byte(map->climate.temperature[tileY][tileX]);
+}
+
+float climate_field_humidity_at(const Map* map, int tileX, int tileY)
+{
+    if (!map || tileX < 0 || tileY < 0 || tileX >= map->width || tileY >= map->height)
+        return 0.0f;
+    return unit_from_byte(map->climate.humidity[tileY][tileX]);
+}
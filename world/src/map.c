@@ -12,6 +12,8 @@
 #include "world_chunk.h"
 #include "input.h"
 #include "building.h"
+#include "tile_stats.h"
+#include "clearance_map.h"
 
 static inline int wrap_x(int x)
 {
@@ -29,12 +31,24 @@ void map_init(Map* map, unsigned int seed)
     map->width  = MAP_WIDTH;
     map->height = MAP_HEIGHT;
     memset(map->tiles, 0, sizeof(map->tiles));
-    memset(map->objects, 0, sizeof(map->objects));
+    memset(map->tileVariants, 0, sizeof(map->tileVariants));
+    memset(map->objectCells, 0, sizeof(map->objectCells));
+    memset(map->objectSlots, 0, sizeof(map->objectSlots));
+    memset(map->clearance, 0, sizeof(map->clearance));
     memset(map->lightField, 0, sizeof(map->lightField));
     memset(map->heatField, 0, sizeof(map->heatField));
+    map->chunks = NULL;
+
+    object_records_init(map);
+
+    // The season starts from the tile definitions; the generator's climate layers read it.
+    for (int i = 0; i < TILE_MAX; ++i)
+        map->tileClimate[i] = (TileClimate){tileTypes[i].fertility, tileTypes[i].humidity, tileTypes[i].temperature};
+    map->climateMean = (TileClimate){0.0f, 0.0f, 0.0f};
 
     // Configure the generation pipeline before creating terrain content.
-    worldgen_seed(seed);
+    worldgen_state_init(&map->worldgen);
+    worldgen_seed(&map->worldgen, seed);
     WorldGenParams cfg = {
         .min_biome_radius           = (MAP_WIDTH + MAP_HEIGHT) / 8,
         .weight_forest              = 1.0f,
@@ -59,15 +73,106 @@ void map_init(Map* map, unsigned int seed)
         .biome_struct_mult_cursed   = 0.8f,
         .biome_struct_mult_hell     = 0.1f,
     };
-    worldgen_config(&cfg);
+    worldgen_config(&map->worldgen, &cfg);
 
-    building_clear_structure_markers();
+    building_system_init(&map->buildings);
+    tile_stats_reset(map);
+    clearance_map_reset(map);
     generate_world(map);
+
+    // Worldgen writes tiles directly; histograms, variants and clearance are built once it is done.
+    tile_stats_rebuild(map);
+    map_refresh_tile_variants(map);
+    clearance_map_rebuild(map);
+    map_note_walkability_change(map, 0, 0, map->width, map->height);
+    map_note_digest_change(map, 0, 0, map->width, map->height, MAP_DIGEST_ALL);
+}
+
+static void map_log_edit(Map* map, int x0, int y0, int x1, int y1, bool door)
+{
+    if (!map)
+        return;
+    MapEditLog* log = &map->edits;
+    log->generation++;
+    log->entries[log->generation % MAP_EDIT_LOG_SIZE] = (MapEdit){log->generation, x0, y0, x1, y1, door};
+}
+
+void map_note_walkability_change(Map* map, int x0, int y0, int x1, int y1)
+{
+    map_log_edit(map, x0, y0, x1, y1, false);
+}
+
+void map_note_door_change(Map* map, int x, int y)
+{
+    map_log_edit(map, x, y, x + 1, y + 1, true);
+}
+
+void map_note_digest_change(Map* map, int x0, int y0, int x1, int y1, uint8_t layers)
+{
+    if (!map || x1 <= x0 || y1 <= y0)
+        return;
+
+    int cx0 = x0 > 0 ? x0 / CHUNK_W : 0;
+    int cy0 = y0 > 0 ? y0 / CHUNK_H : 0;
+    int cx1 = (x1 - 1) / CHUNK_W < MAP_CHUNKS_X ? (x1 - 1) / CHUNK_W : MAP_CHUNKS_X - 1;
+    int cy1 = (y1 - 1) / CHUNK_H < MAP_CHUNKS_Y ? (y1 - 1) / CHUNK_H : MAP_CHUNKS_Y - 1;
+    for (int cy = cy0; cy <= cy1; ++cy)
+        for (int cx = cx0; cx <= cx1; ++cx)
+            map->digest.dirty[cy][cx] |= layers;
+}
+
+unsigned int map_walkability_generation(const Map* map)
+{
+    return map->edits.generation;
+}
+
+bool map_walkability_changed_since(const Map* map, unsigned int generation, int x0, int y0, int x1, int y1, bool ignoreDoors)
+{
+    const MapEditLog* log = &map->edits;
+    if (log->generation - generation >= MAP_EDIT_LOG_SIZE)
+        return log->generation != generation;
+
+    for (unsigned int g = generation + 1; g != log->generation + 1; ++g)
+    {
+        const MapEdit* edit = &log->entries[g % MAP_EDIT_LOG_SIZE];
+        if (ignoreDoors && edit->door)
+            continue;
+        if (edit->x0 < x1 && x0 < edit->x1 && edit->y0 < y1 && y0 < edit->y1)
+            return true;
+    }
+    return false;
+}
+
+void map_refresh_tile_variants(Map* map)
+{
+    if (!map)
+        return;
+
+    for (int y = 0; y < map->height; ++y)
+        for (int x = 0; x < map->width; ++x)
+            map->tileVariants[y][x] = tile_variant_at(get_tile_type(map->tiles[y][x]), x, y);
 }
 
 void map_unload(Map* map)
 {
-    (void)map;
+    if (!map)
+        return;
+
+    // Return every object record to the pool, then free the pool itself.
+    for (int y = 0; y < map->height; ++y)
+    {
+        for (int x = 0; x < map->width; ++x)
+        {
+            Object* obj = object_from_handle(map, map->objectSlots[y][x]);
+            if (obj)
+                object_destroy(map, obj);
+        }
+    }
+    object_records_release(map);
+    building_system_release(&map->buildings);
+    memset(map->objectCells, 0, sizeof(map->objectCells));
+    memset(map->objectSlots, 0, sizeof(map->objectSlots));
+    map_note_digest_change(map, 0, 0, map->width, map->height, MAP_DIGEST_OBJECTS);
 }
 
 TileTypeID map_get_tile(Map* map, int x, int y)
@@ -77,10 +182,35 @@ TileTypeID map_get_tile(Map* map, int x, int y)
 
 void map_set_tile(Map* map, int x, int y, TileTypeID id)
 {
-    map->tiles[wrap_y(y)][wrap_x(x)] = id;
-    // chunkgrid_mark_dirty_tile(gChunks, x, y);
+    int wx = wrap_x(x);
+    int wy = wrap_y(y);
+    tile_stats_on_tile_changed(map, wx, wy, map->tiles[wy][wx], id);
+    map->tiles[wy][wx]        = id;
+    map->tileVariants[wy][wx] = tile_variant_at(get_tile_type(id), wx, wy);
+    clearance_map_on_tile_changed(map, wx, wy);
+    map_note_walkability_change(map, wx, wy, wx + 1, wy + 1);
+    map_note_digest_change(map, wx, wy, wx + 1, wy + 1, MAP_DIGEST_TILES);
+    // chunkgrid_mark_dirty_tile(map->chunks, x, y);
     // Trigger a redraw so cached chunks reflect the new terrain.
-    chunkgrid_redraw_cell(gChunks, map, x, y);
+    chunkgrid_redraw_cell(map->chunks, map, x, y);
+}
+
+/** Drops the object on a wrapped tile, returning its record to the pool. */
+static bool map_clear_object(Map* map, int wx, int wy)
+{
+    if (map->objectCells[wy][wx].type == OBJ_NONE)
+        return false;
+
+    Object* obj = object_from_handle(map, map->objectSlots[wy][wx]);
+    if (obj)
+        object_destroy(map, obj);
+    else
+        object_mark_environment_dirty(map);
+
+    map->objectCells[wy][wx] = (ObjectCell){0};
+    map->objectSlots[wy][wx] = 0;
+    map_note_digest_change(map, wx, wy, wx + 1, wy + 1, MAP_DIGEST_OBJECTS);
+    return true;
 }
 
 void map_place_object(Map* map, ObjectTypeID id, int x, int y)
@@ -88,13 +218,24 @@ void map_place_object(Map* map, ObjectTypeID id, int x, int y)
     int wx = wrap_x(x);
     int wy = wrap_y(y);
 
-    if (map->objects[wy][wx])
-        object_destroy(map->objects[wy][wx]);
-    map->objects[wy][wx] = create_object(id, wx, wy);
+    map_clear_object(map, wx, wy);
+
+    const ObjectType* type = get_object_type(id);
+    if (id > OBJ_NONE && type && type->id > OBJ_NONE)
+    {
+        // Decor is just the packed cell; stateful types get a record straight away.
+        map->objectCells[wy][wx] = (ObjectCell){(uint8_t)type->id, (uint8_t)object_type_pick_variant(type, wx, wy)};
+        if (object_type_needs_record(type))
+            map_object_promote(map, wx, wy);
+        object_mark_environment_dirty(map);
+        map_note_digest_change(map, wx, wy, wx + 1, wy + 1, MAP_DIGEST_OBJECTS);
+    }
+    clearance_map_on_tile_changed(map, wx, wy);
+    map_note_walkability_change(map, wx, wy, wx + 1, wy + 1);
 
-    // chunkgrid_mark_dirty_tile(gChunks, wx, wy);
+    // chunkgrid_mark_dirty_tile(map->chunks, wx, wy);
     // Refresh rendering cache so the new object appears immediately.
-    chunkgrid_redraw_cell(gChunks, map, x, y);
+    chunkgrid_redraw_cell(map->chunks, map, x, y);
 }
 
 void map_remove_object(Map* map, int x, int y)
@@ -102,36 +243,86 @@ void map_remove_object(Map* map, int x, int y)
     int wx = wrap_x(x);
     int wy = wrap_y(y);
 
-    if (map->objects[wy][wx])
+    if (map_clear_object(map, wx, wy))
     {
-        object_destroy(map->objects[wy][wx]);
-        map->objects[wy][wx] = NULL;
-
-        // chunkgrid_mark_dirty_tile(gChunks, wx, wy);
+        clearance_map_on_tile_changed(map, wx, wy);
+        map_note_walkability_change(map, wx, wy, wx + 1, wy + 1);
+        // chunkgrid_mark_dirty_tile(map->chunks, wx, wy);
         // Force a redraw because the tile visuals changed.
-        chunkgrid_mark_dirty_tile(gChunks, x, y);
-        chunkgrid_redraw_cell(gChunks, map, x, y);
+        chunkgrid_mark_dirty_tile(map->chunks, x, y);
+        chunkgrid_redraw_cell(map->chunks, map, x, y);
     }
 }
 
-bool map_toggle_door(Map* map, int x, int y, bool open)
+bool map_has_object(const Map* map, int x, int y)
 {
-    if (!map)
-        return false;
+    return map->objectCells[wrap_y(y)][wrap_x(x)].type != OBJ_NONE;
+}
+
+const ObjectType* map_object_type_at(const Map* map, int x, int y)
+{
+    uint8_t type = map->objectCells[wrap_y(y)][wrap_x(x)].type;
+    return type != OBJ_NONE ? get_object_type((ObjectTypeID)type) : NULL;
+}
+
+Object* map_object_record(const Map* map, int x, int y)
+{
+    return object_from_handle(map, map->objectSlots[wrap_y(y)][wrap_x(x)]);
+}
+
+Object* map_object_promote(Map* map, int x, int y)
+{
+    int wx = wrap_x(x);
+    int wy = wrap_y(y);
+
+    const ObjectCell* cell = &map->objectCells[wy][wx];
+    if (cell->type == OBJ_NONE)
+        return NULL;
+
+    Object* obj = object_from_handle(map, map->objectSlots[wy][wx]);
+    if (obj)
+        return obj;
+
+    obj = create_object(map, (ObjectTypeID)cell->type, wx, wy);
+    if (!obj)
+        return NULL;
+
+    if (!obj->type->activatable)
+        obj->variantFrame = cell->variant;
+    map->objectSlots[wy][wx] = obj->handle;
+    return obj;
+}
 
+bool map_object_walkable_at(const Map* map, int x, int y)
+{
     int wx = wrap_x(x);
     int wy = wrap_y(y);
 
-    Object* obj = map->objects[wy][wx];
+    uint8_t type = map->objectCells[wy][wx].type;
+    if (type == OBJ_NONE)
+        return true;
+
+    const Object* obj = object_from_handle(map, map->objectSlots[wy][wx]);
+    if (obj)
+        return object_is_walkable(obj);
+    return get_object_type((ObjectTypeID)type)->walkable;
+}
+
+bool map_toggle_door(Map* map, int x, int y, bool open)
+{
+    if (!map)
+        return false;
+
+    Object* obj = map_object_record(map, x, y);
     if (!obj || !obj->type || !obj->type->isDoor)
         return false;
 
     if (!object_has_activation(obj))
         return false;
 
-    bool changed = object_set_active(obj, open);
+    bool changed = object_set_active(map, obj, open);
     if (changed)
-        chunkgrid_redraw_cell(gChunks, map, x, y);
+        chunkgrid_redraw_cell(map->chunks, map, x, y);
     return changed;
 }
 
@@ -156,7 +347,7 @@ void draw_map(Map* map, Camera2D* camera)
             TileType* type = get_tile_type(map->tiles[wy][wx]);
             Rectangle rect = {x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE};
 
-            tile_draw(type, wx, wy, rect.x, rect.y);
+            tile_draw(type, map->tileVariants[wy][wx], rect.x, rect.y);
         }
     }
 }
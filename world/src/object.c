@@ -13,14 +13,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <math.h>
 
 // Static and constant global array containing all object type definitions.
 // It uses the ObjectTypeID enumeration (e.g., [OBJ_BED_SMALL]) for indexing.
-static ObjectType G_OBJECT_TYPES[OBJ_COUNT] = {0};
-static Object*    G_DYNAMIC_OBJECTS         = NULL;
-static bool       G_ENVIRONMENT_DIRTY       = true;
+static ObjectType        G_OBJECT_TYPES[OBJ_COUNT]       = {0};
+static const ObjectType* G_OBJECT_TYPES_BY_ID[OBJ_COUNT] = {0};
 
 static void unload_object_sound(Sound* sound);
 
@@ -47,6 +47,99 @@ static int clamp_int(int value, int minimum, int maximum)
     return value;
 }
 
+// -----------------------------------------------------------------------------
+// Record pool
+// -----------------------------------------------------------------------------
+
+static Object* object_pool_acquire(ObjectPool* pool)
+{
+    if (!pool->freeList)
+    {
+        if (pool->blockCount >= OBJECT_POOL_MAX_BLOCKS)
+        {
+            printf("❌ Object pool exhausted (%d records).\n", pool->live);
+            return NULL;
+        }
+
+        Object* block = (Object*)calloc(OBJECT_POOL_BLOCK_SIZE, sizeof(Object));
+        if (!block)
+            return NULL;
+
+        int base = pool->blockCount * OBJECT_POOL_BLOCK_SIZE;
+        pool->blocks[pool->blockCount++] = block;
+
+        // Thread the free list backwards so handles are handed out in order.
+        for (int i = OBJECT_POOL_BLOCK_SIZE - 1; i >= 0; --i)
+        {
+            block[i].handle   = (uint16_t)(base + i + 1);
+            block[i].nextFree = pool->freeList;
+            pool->freeList    = &block[i];
+        }
+    }
+
+    Object*  obj    = pool->freeList;
+    uint16_t handle = obj->handle;
+    pool->freeList  = obj->nextFree;
+
+    memset(obj, 0, sizeof(*obj));
+    obj->handle = handle;
+    pool->live++;
+    return obj;
+}
+
+static void object_pool_release(ObjectPool* pool, Object* obj)
+{
+    uint16_t handle = obj->handle;
+    memset(obj, 0, sizeof(*obj));
+    obj->handle    = handle;
+    obj->nextFree  = pool->freeList;
+    pool->freeList = obj;
+    pool->live--;
+}
+
+Object* object_from_handle(const Map* map, uint16_t handle)
+{
+    if (handle == 0 || !map)
+        return NULL;
+
+    const ObjectPool* pool  = &map->objectPool;
+    int               index = (int)handle - 1;
+    int               block = index / OBJECT_POOL_BLOCK_SIZE;
+    if (block >= pool->blockCount)
+        return NULL;
+
+    Object* obj = &pool->blocks[block][index % OBJECT_POOL_BLOCK_SIZE];
+    return obj->type ? obj : NULL;
+}
+
+int object_record_count(const Map* map)
+{
+    return map ? map->objectPool.live : 0;
+}
+
+int object_record_capacity(const Map* map)
+{
+    return map ? map->objectPool.blockCount * OBJECT_POOL_BLOCK_SIZE : 0;
+}
+
+// -----------------------------------------------------------------------------
+// Environment fields
+// -----------------------------------------------------------------------------
+
+static inline bool object_type_emits(const ObjectType* type)
+{
+    return (type->lightRadius > 0 && type->lightLevel > 0) || (type->heatRadius > 0 && type->warmth > 0);
+}
+
+/** Activation state of the object on a tile; objects without a record are always on. */
+static bool object_active_at(const Map* map, const ObjectType* type, int x, int y)
+{
+    if (!type->activatable)
+        return true;
+    const Object* obj = map_object_record(map, x, y);
+    return obj && obj->isActive;
+}
+
 static void environment_reset(Map* map)
 {
     if (!map)
@@ -59,18 +152,13 @@ static void environment_reset(Map* map)
     }
 }
 
-static void environment_apply_object(Map* map, const Object* obj)
+static void environment_apply_object(Map* map, const ObjectType* type, int tileX, int tileY)
 {
-    if (!map || !obj || !obj->type)
+    if (!map || !type)
         return;
 
-    const ObjectType* type        = obj->type;
-    bool              isActive    = !type->activatable || obj->isActive;
-    int               lightRadius = type->lightRadius;
-    int               heatRadius  = type->heatRadius;
-
-    if (!isActive)
-        return;
+    int lightRadius = type->lightRadius;
+    int heatRadius  = type->heatRadius;
 
     if ((lightRadius <= 0 || type->lightLevel <= 0) && (heatRadius <= 0 || type->warmth <= 0))
         return;
@@ -79,8 +167,8 @@ static void environment_apply_object(Map* map, const Object* obj)
     if (maxRadius <= 0)
         return;
 
-    float centerX = obj->position.x + (float)type->width * 0.5f;
-    float centerY = obj->position.y + (float)type->height * 0.5f;
+    float centerX = (float)tileX + (float)type->width * 0.5f;
+    float centerY = (float)tileY + (float)type->height * 0.5f;
 
     int minX = clamp_int((int)floorf(centerX - (float)maxRadius), 0, map->width - 1);
     int maxX = clamp_int((int)ceilf(centerX + (float)maxRadius), 0, map->width - 1);
@@ -128,22 +216,21 @@ static void rebuild_environment_fields(Map* map)
     {
         for (int x = 0; x < map->width; ++x)
         {
-            Object* obj = map->objects[y][x];
-            if (!obj || (int)obj->position.x != x || (int)obj->position.y != y)
+            const ObjectCell* cell = &map->objectCells[y][x];
+            if (cell->type == OBJ_NONE)
+                continue;
+
+            const ObjectType* type = get_object_type((ObjectTypeID)cell->type);
+            if (!object_type_emits(type) || !object_active_at(map, type, x, y))
                 continue;
-            environment_apply_object(map, obj);
+            environment_apply_object(map, type, x, y);
         }
     }
 }
 
-static void draw_object_environment_effect(const Object* obj, Rectangle viewRect)
+static void draw_object_environment_effect(const ObjectType* type, int tileX, int tileY, Rectangle viewRect)
 {
-    if (!obj || !obj->type)
-        return;
-
-    const ObjectType* type = obj->type;
-
-    if (type->activatable && !obj->isActive)
+    if (!type)
         return;
 
     bool hasLight = (type->lightRadius > 0 && type->lightLevel > 0);
@@ -155,8 +242,8 @@ static void draw_object_environment_effect(const Object* obj, Rectangle viewRect
     if (maxRadius <= 0)
         return;
 
-    float centerX      = (obj->position.x + (float)type->width * 0.5f) * (float)TILE_SIZE;
-    float centerY      = (obj->position.y + (float)type->height * 0.5f) * (float)TILE_SIZE;
+    float centerX      = ((float)tileX + (float)type->width * 0.5f) * (float)TILE_SIZE;
+    float centerY      = ((float)tileY + (float)type->height * 0.5f) * (float)TILE_SIZE;
     float radiusPixels = (float)maxRadius * (float)TILE_SIZE;
 
     Rectangle bounds = {
@@ -186,38 +273,54 @@ static void draw_object_environment_effect(const Object* obj, Rectangle viewRect
     }
 }
 
-Rectangle object_type_frame_rect(const ObjectType* type, int frameIndex)
+/** Computes every frame's source rect once the sprite layout is final. */
+static void build_frame_rects(ObjectType* type)
 {
-    if (!type || type->texture.id == 0)
-        return (Rectangle){0.0f, 0.0f, (float)TILE_SIZE, (float)TILE_SIZE};
+    free(type->frameRects);
+    type->frameRects = NULL;
+
+    if (type->texture.id == 0)
+        return;
 
     int frameCount = type->spriteFrameCount > 0 ? type->spriteFrameCount : 1;
-    if (frameIndex < 0)
-        frameIndex = 0;
-    if (frameIndex >= frameCount)
-        frameIndex = frameCount - 1;
 
     int columns = type->spriteColumns > 0 ? type->spriteColumns : frameCount;
     if (columns <= 0)
         columns = 1;
 
-    int rows = type->spriteRows > 0 ? type->spriteRows : ((frameCount + columns - 1) / columns);
-    if (rows <= 0)
-        rows = 1;
-
     int frameWidth  = type->spriteFrameWidth > 0 ? type->spriteFrameWidth : type->texture.width;
     int frameHeight = type->spriteFrameHeight > 0 ? type->spriteFrameHeight : type->texture.height;
 
     int spacingX = type->spriteSpacingX;
     int spacingY = type->spriteSpacingY;
 
-    int col = frameIndex % columns;
-    int row = frameIndex / columns;
+    type->frameRects = (Rectangle*)malloc((size_t)frameCount * sizeof(Rectangle));
+    if (!type->frameRects)
+        return;
 
-    float srcX = (float)col * (float)(frameWidth + spacingX);
-    float srcY = (float)row * (float)(frameHeight + spacingY);
+    for (int frame = 0; frame < frameCount; ++frame)
+    {
+        int col = frame % columns;
+        int row = frame / columns;
 
-    return (Rectangle){srcX, srcY, (float)frameWidth, (float)frameHeight};
+        float srcX              = (float)col * (float)(frameWidth + spacingX);
+        float srcY              = (float)row * (float)(frameHeight + spacingY);
+        type->frameRects[frame] = (Rectangle){srcX, srcY, (float)frameWidth, (float)frameHeight};
+    }
+}
+
+Rectangle object_type_frame_rect(const ObjectType* type, int frameIndex)
+{
+    if (!type || type->texture.id == 0 || !type->frameRects)
+        return (Rectangle){0.0f, 0.0f, (float)TILE_SIZE, (float)TILE_SIZE};
+
+    int frameCount = type->spriteFrameCount > 0 ? type->spriteFrameCount : 1;
+    if (frameIndex < 0)
+        frameIndex = 0;
+    if (frameIndex >= frameCount)
+        frameIndex = frameCount - 1;
+
+    return type->frameRects[frameIndex];
 }
 
 static int object_state_frame(const ObjectType* type, bool active)
@@ -240,9 +343,16 @@ Vector2 object_frame_draw_position(const Object* obj, int frameWidth, int frameH
     if (!obj || !obj->type)
         return (Vector2){0.0f, 0.0f};
 
-    const ObjectType* type        = obj->type;
-    float             widthTiles  = type->width > 0 ? (float)type->width : 1.0f;
-    float             heightTiles = type->height > 0 ? (float)type->height : 1.0f;
+    return object_type_draw_position(obj->type, (int)obj->position.x, (int)obj->position.y, frameWidth, frameHeight);
+}
+
+Vector2 object_type_draw_position(const ObjectType* type, int tileX, int tileY, int frameWidth, int frameHeight)
+{
+    if (!type)
+        return (Vector2){0.0f, 0.0f};
+
+    float widthTiles  = type->width > 0 ? (float)type->width : 1.0f;
+    float heightTiles = type->height > 0 ? (float)type->height : 1.0f;
 
     float destX;
     if (frameWidth <= 0)
@@ -250,12 +360,12 @@ Vector2 object_frame_draw_position(const Object* obj, int frameWidth, int frameH
 
     if (frameWidth <= TILE_SIZE)
     {
-        float tileLeft = obj->position.x * (float)TILE_SIZE;
+        float tileLeft = (float)tileX * (float)TILE_SIZE;
         destX          = tileLeft + ((float)TILE_SIZE - (float)frameWidth) * 0.5f;
     }
     else
     {
-        float baseCenterX = (obj->position.x + widthTiles * 0.5f) * (float)TILE_SIZE;
+        float baseCenterX = ((float)tileX + widthTiles * 0.5f) * (float)TILE_SIZE;
         destX             = baseCenterX - (float)frameWidth * 0.5f;
     }
 
@@ -265,19 +375,19 @@ Vector2 object_frame_draw_position(const Object* obj, int frameWidth, int frameH
 
     if (frameHeight <= TILE_SIZE)
     {
-        float tileTop = obj->position.y * (float)TILE_SIZE;
+        float tileTop = (float)tileY * (float)TILE_SIZE;
         destY         = tileTop + ((float)TILE_SIZE - (float)frameHeight) * 0.5f;
     }
     else
     {
-        float anchorBottom = (obj->position.y + heightTiles) * (float)TILE_SIZE;
+        float anchorBottom = ((float)tileY + heightTiles) * (float)TILE_SIZE;
         destY              = anchorBottom - (float)frameHeight;
     }
 
     return (Vector2){destX, destY};
 }
 
-static int object_pick_variant_frame(const ObjectType* type, int tileX, int tileY)
+int object_type_pick_variant(const ObjectType* type, int tileX, int tileY)
 {
     if (!type)
         return 0;
@@ -290,7 +400,65 @@ static int object_pick_variant_frame(const ObjectType* type, int tileX, int tile
     return (int)(hash % (uint32_t)frameCount);
 }
 
-static void object_start_animation(Object* obj)
+// -----------------------------------------------------------------------------
+// Dynamic object sets
+// -----------------------------------------------------------------------------
+
+/** Appends @p obj and stores its index in @p slot. */
+static bool ptr_list_push(ObjectPtrList* list, Object* obj, int* slot)
+{
+    if (list->count == list->capacity)
+    {
+        int      capacity = list->capacity ? list->capacity * 2 : 16;
+        Object** grown    = (Object**)realloc(list->items, (size_t)capacity * sizeof(Object*));
+        if (!grown)
+            return false;
+        list->items    = grown;
+        list->capacity = capacity;
+    }
+    *slot                      = list->count;
+    list->items[list->count++] = obj;
+    return true;
+}
+
+/** Swap-removes entry @p index and patches the moved object's slot field. */
+static void ptr_list_remove(ObjectPtrList* list, int index, size_t slotOffset)
+{
+    if (index < 0 || index >= list->count)
+        return;
+
+    Object* last = list->items[--list->count];
+    if (index < list->count)
+    {
+        list->items[index]                         = last;
+        *(int*)((unsigned char*)last + slotOffset) = index;
+    }
+}
+
+static ObjectPtrList* object_chunk_list(ObjectDynamics* sets, const Object* obj)
+{
+    int cx = (int)obj->position.x / CHUNK_W;
+    int cy = (int)obj->position.y / CHUNK_H;
+    if (cx < 0 || cy < 0 || cx >= OBJECT_DRAW_CHUNKS_X || cy >= OBJECT_DRAW_CHUNKS_Y)
+        return NULL;
+    return &sets->chunks[cy][cx];
+}
+
+static void animating_add(ObjectDynamics* sets, Object* obj)
+{
+    if (obj->animSlot >= 0)
+        return;
+    if (!ptr_list_push(&sets->animating, obj, &obj->animSlot))
+    {
+        // Cannot track it: jump straight to the final frame instead.
+        obj->animation.currentFrame = obj->animation.targetFrame;
+        obj->animation.playing      = false;
+        obj->variantFrame           = obj->animation.currentFrame;
+        obj->animSlot               = -1;
+    }
+}
+
+static void object_start_animation(ObjectDynamics* sets, Object* obj)
 {
     if (!obj || !obj->type || !obj->type->activatable)
         return;
@@ -312,37 +480,55 @@ static void object_start_animation(Object* obj)
     obj->animation.forward     = (obj->animation.currentFrame < targetFrame);
     obj->animation.playing     = true;
     obj->animation.accumulator = 0.0f;
+    animating_add(sets, obj);
 }
 
-static void dynamic_list_add(Object* obj)
+static void dynamic_list_add(ObjectDynamics* sets, Object* obj)
 {
     if (!obj)
         return;
-    obj->nextDynamic  = G_DYNAMIC_OBJECTS;
-    G_DYNAMIC_OBJECTS = obj;
+
+    ObjectPtrList* list = object_chunk_list(sets, obj);
+    if (!list || !ptr_list_push(list, obj, &obj->drawSlot))
+        printf("⚠️ Dynamic object at (%.0f, %.0f) could not be listed for drawing.\n", obj->position.x, obj->position.y);
 }
 
-static void dynamic_list_remove(Object* obj)
+static void dynamic_list_remove(ObjectDynamics* sets, Object* obj)
 {
     if (!obj)
         return;
 
-    if (G_DYNAMIC_OBJECTS == obj)
-    {
-        G_DYNAMIC_OBJECTS = obj->nextDynamic;
-        obj->nextDynamic  = NULL;
-        return;
-    }
+    if (obj->animSlot >= 0)
+        ptr_list_remove(&sets->animating, obj->animSlot, offsetof(Object, animSlot));
+    obj->animSlot = -1;
 
-    Object* cursor = G_DYNAMIC_OBJECTS;
-    while (cursor && cursor->nextDynamic != obj)
-        cursor = cursor->nextDynamic;
+    ObjectPtrList* list = object_chunk_list(sets, obj);
+    if (list && obj->drawSlot >= 0)
+        ptr_list_remove(list, obj->drawSlot, offsetof(Object, drawSlot));
+    obj->drawSlot = -1;
+}
 
-    if (cursor && cursor->nextDynamic == obj)
-    {
-        cursor->nextDynamic = obj->nextDynamic;
-        obj->nextDynamic    = NULL;
-    }
+void object_records_init(Map* map)
+{
+    if (!map)
+        return;
+    memset(&map->objectPool, 0, sizeof(map->objectPool));
+    memset(&map->objectSets, 0, sizeof(map->objectSets));
+    map->objectSets.environmentDirty = true;
+}
+
+void object_records_release(Map* map)
+{
+    if (!map)
+        return;
+    ObjectDynamics* sets = &map->objectSets;
+    free(sets->animating.items);
+    for (int cy = 0; cy < OBJECT_DRAW_CHUNKS_Y; ++cy)
+        for (int cx = 0; cx < OBJECT_DRAW_CHUNKS_X; ++cx)
+            free(sets->chunks[cy][cx].items);
+    for (int b = 0; b < map->objectPool.blockCount; ++b)
+        free(map->objectPool.blocks[b]);
+    object_records_init(map);
 }
 
 static void finalize_sprite_info(ObjectType* type)
@@ -463,8 +649,7 @@ static void unload_object_sound(Sound* sound)
 
 void init_objects(void)
 {
-    G_DYNAMIC_OBJECTS = NULL;
-    int objCount      = load_objects_from_stv("data/objects.stv", G_OBJECT_TYPES, OBJ_COUNT);
+    int objCount = load_objects_from_stv("data/objects.stv", G_OBJECT_TYPES, OBJ_COUNT);
 
     for (int i = 0; i < OBJ_COUNT; ++i)
     {
@@ -475,6 +660,15 @@ void init_objects(void)
         if (G_OBJECT_TYPES[i].activationSoundOffPath && !G_OBJECT_TYPES[i].activationSoundOff.stream.buffer)
             load_object_sound(&G_OBJECT_TYPES[i], G_OBJECT_TYPES[i].activationSoundOffPath, &G_OBJECT_TYPES[i].activationSoundOff);
         finalize_sprite_info(&G_OBJECT_TYPES[i]);
+        build_frame_rects(&G_OBJECT_TYPES[i]);
+    }
+
+    memset(G_OBJECT_TYPES_BY_ID, 0, sizeof(G_OBJECT_TYPES_BY_ID));
+    for (int i = 0; i < objCount && i < OBJ_COUNT; ++i)
+    {
+        ObjectTypeID id = G_OBJECT_TYPES[i].id;
+        if (id > OBJ_NONE && id < OBJ_COUNT && !G_OBJECT_TYPES_BY_ID[id])
+            G_OBJECT_TYPES_BY_ID[id] = &G_OBJECT_TYPES[i];
     }
     debug_print_objects(G_OBJECT_TYPES, OBJ_COUNT);
 }
@@ -487,8 +681,9 @@ void unload_object_textures(void)
             UnloadTexture(G_OBJECT_TYPES[i].texture);
         unload_object_sound(&G_OBJECT_TYPES[i].activationSoundOn);
         unload_object_sound(&G_OBJECT_TYPES[i].activationSoundOff);
+        free(G_OBJECT_TYPES[i].frameRects);
+        G_OBJECT_TYPES[i].frameRects = NULL;
     }
-    G_DYNAMIC_OBJECTS = NULL;
 }
 
 const ObjectType* get_object_type(ObjectTypeID id)
@@ -497,6 +692,10 @@ const ObjectType* get_object_type(ObjectTypeID id)
     if (id <= OBJ_NONE)
         return &G_OBJECT_TYPES[0]; // fallback on [OBJ_NONE]
 
+    // Direct lookup once init_objects() indexed the definitions
+    if (id < OBJ_COUNT && G_OBJECT_TYPES_BY_ID[id])
+        return G_OBJECT_TYPES_BY_ID[id];
+
     // Linear search (IDs are not guaranteed to be sequential anymore)
     for (int i = 0; i < OBJ_COUNT; ++i)
     {
@@ -549,7 +748,7 @@ const StructureDef* analyze_building_type(const Building* b)
             printf("[ANALYZE] Checking requirement: %s, min: %d\n", reqObj ? reqObj->name : "(unknown)", req->minCount);
             for (int k = 0; k < b->objectCount; k++)
             {
-                if (b->objects[k]->type->id == req->objectId)
+                if (b->objectTypes[k] == req->objectId)
                     count++;
             }
 
@@ -566,15 +765,15 @@ const StructureDef* analyze_building_type(const Building* b)
     return NULL;
 }
 
-Object* create_object(ObjectTypeID id, int x, int y)
+Object* create_object(Map* map, ObjectTypeID id, int x, int y)
 {
-    Object*           obj  = malloc(sizeof(Object));
     const ObjectType* type = get_object_type(id);
-    if (!obj || !type)
-    {
-        free(obj);
+    if (!type || !map)
+        return NULL;
+
+    Object* obj = object_pool_acquire(&map->objectPool);
+    if (!obj)
         return NULL;
-    }
 
     obj->type     = type;
     obj->position = (Vector2){(float)x, (float)y};
@@ -586,26 +785,39 @@ Object* create_object(ObjectTypeID id, int x, int y)
     obj->animation.accumulator  = 0.0f;
     obj->animation.playing      = false;
     obj->animation.forward      = true;
-    obj->variantFrame           = type->activatable ? obj->animation.currentFrame : object_pick_variant_frame(type, x, y);
-    obj->nextDynamic            = NULL;
+    obj->variantFrame           = type->activatable ? obj->animation.currentFrame : object_type_pick_variant(type, x, y);
+    obj->nextFree               = NULL;
+    obj->animSlot               = -1;
+    obj->drawSlot               = -1;
 
     if (object_type_is_dynamic(type))
-        dynamic_list_add(obj);
+        dynamic_list_add(&map->objectSets, obj);
 
-    G_ENVIRONMENT_DIRTY = true;
+    map->objectSets.environmentDirty = true;
     return obj;
 }
 
-void object_destroy(Object* obj)
+void object_destroy(Map* map, Object* obj)
 {
-    if (!obj)
+    if (!obj || !map)
         return;
 
     if (object_type_is_dynamic(obj->type))
-        dynamic_list_remove(obj);
+        dynamic_list_remove(&map->objectSets, obj);
 
-    G_ENVIRONMENT_DIRTY = true;
-    free(obj);
+    map->objectSets.environmentDirty = true;
+    object_pool_release(&map->objectPool, obj);
+}
+
+void object_mark_environment_dirty(Map* map)
+{
+    if (map)
+        map->objectSets.environmentDirty = true;
+}
+
+bool object_type_needs_record(const ObjectType* type)
+{
+    return object_type_is_dynamic(type);
 }
 
 bool object_has_activation(const Object* obj)
@@ -613,16 +825,16 @@ bool object_has_activation(const Object* obj)
     return obj && obj->type && obj->type->activatable;
 }
 
-bool object_set_active(Object* obj, bool active)
+bool object_set_active(Map* map, Object* obj, bool active)
 {
-    if (!object_has_activation(obj))
+    if (!map || !object_has_activation(obj))
         return false;
 
     if (obj->isActive == active)
         return false;
 
     obj->isActive = active;
-    object_start_animation(obj);
+    object_start_animation(&map->objectSets, obj);
     if (obj->type)
     {
         const Sound* sound = active ? &obj->type->activationSoundOn : &obj->type->activationSoundOff;
@@ -641,15 +853,26 @@ bool object_set_active(Object* obj, bool active)
                 PlaySoundMulti(*sound);
         }
     }
-    G_ENVIRONMENT_DIRTY = true;
+    // Doors and other non-emitters do not touch the light/heat fields.
+    if (obj->type && object_type_emits(obj->type))
+        map->objectSets.environmentDirty = true;
+    if (obj->type && obj->type->activationWalkableOn != obj->type->activationWalkableOff)
+    {
+        int tx = (int)obj->position.x;
+        int ty = (int)obj->position.y;
+        if (obj->type->isDoor)
+            map_note_door_change(map, tx, ty);
+        else
+            map_note_walkability_change(map, tx, ty, tx + 1, ty + 1);
+    }
     return true;
 }
 
-bool object_toggle(Object* obj)
+bool object_toggle(Map* map, Object* obj)
 {
     if (!object_has_activation(obj))
         return false;
-    return object_set_active(obj, !obj->isActive);
+    return object_set_active(map, obj, !obj->isActive);
 }
 
 bool object_is_walkable(const Object* obj)
@@ -693,11 +916,18 @@ int object_static_frame(const Object* obj)
 
 void object_update_system(Map* map, float dt)
 {
+    if (!map)
+        return;
+    ObjectDynamics* sets = &map->objectSets;
     if (dt <= 0.0f)
         dt = 0.0f;
 
-    for (Object* obj = G_DYNAMIC_OBJECTS; obj; obj = obj->nextDynamic)
+    // Only objects with a running animation are visited; finished ones leave
+    // the set (iterating backwards keeps swap-removal safe).
+    for (int i = sets->animating.count - 1; i >= 0; --i)
     {
+        Object* obj = sets->animating.items[i];
+
         if (!obj->animation.playing || !obj->type || obj->type->activationFrameTime <= 0.0f)
         {
             if (obj->animation.playing)
@@ -707,6 +937,8 @@ void object_update_system(Map* map, float dt)
                 obj->animation.accumulator  = 0.0f;
                 obj->variantFrame           = obj->animation.currentFrame;
             }
+            ptr_list_remove(&sets->animating, i, offsetof(Object, animSlot));
+            obj->animSlot = -1;
             continue;
         }
 
@@ -738,19 +970,24 @@ void object_update_system(Map* map, float dt)
 
             obj->variantFrame = obj->animation.currentFrame;
         }
+
+        if (!obj->animation.playing)
+        {
+            ptr_list_remove(&sets->animating, i, offsetof(Object, animSlot));
+            obj->animSlot = -1;
+        }
     }
 
-    if (map && G_ENVIRONMENT_DIRTY)
+    if (sets->environmentDirty)
     {
         rebuild_environment_fields(map);
-        G_ENVIRONMENT_DIRTY = false;
+        sets->environmentDirty = false;
     }
 }
 
 void object_draw_dynamic(const Map* map, const Camera2D* camera)
 {
-    (void)map;
-    if (!camera)
+    if (!camera || !map)
         return;
 
     float     invZoom = 1.0f / camera->zoom;
@@ -761,31 +998,48 @@ void object_draw_dynamic(const Map* map, const Camera2D* camera)
            .height = GetScreenHeight() * invZoom,
     };
 
-    for (Object* obj = G_DYNAMIC_OBJECTS; obj; obj = obj->nextDynamic)
-    {
-        if (!obj->type)
-            continue;
-
-        if (obj->type->texture.id != 0)
-        {
-            Rectangle src     = object_type_frame_rect(obj->type, obj->animation.currentFrame);
-            Vector2   drawPos = object_frame_draw_position(obj, (int)src.width, (int)src.height);
-            Rectangle bounds  = {.x = drawPos.x, .y = drawPos.y, .width = src.width, .height = src.height};
+    // Visit the chunks overlapping the view plus a one-chunk margin for
+    // sprites that extend past their anchor tile.
+    const float chunkPxW = (float)(CHUNK_W * TILE_SIZE);
+    const float chunkPxH = (float)(CHUNK_H * TILE_SIZE);
+    int         cx0      = clamp_int((int)floorf(view.x / chunkPxW) - 1, 0, OBJECT_DRAW_CHUNKS_X - 1);
+    int         cy0      = clamp_int((int)floorf(view.y / chunkPxH) - 1, 0, OBJECT_DRAW_CHUNKS_Y - 1);
+    int         cx1      = clamp_int((int)floorf((view.x + view.width) / chunkPxW) + 1, 0, OBJECT_DRAW_CHUNKS_X - 1);
+    int         cy1      = clamp_int((int)floorf((view.y + view.height) / chunkPxH) + 1, 0, OBJECT_DRAW_CHUNKS_Y - 1);
 
-            if (!CheckCollisionRecs(view, bounds))
-                continue;
-
-            DrawTextureRec(obj->type->texture, src, drawPos, WHITE);
-        }
-        else
+    for (int cy = cy0; cy <= cy1; ++cy)
+    {
+        for (int cx = cx0; cx <= cx1; ++cx)
         {
-            Vector2   drawPos = object_frame_draw_position(obj, TILE_SIZE, TILE_SIZE);
-            Rectangle bounds  = {.x = drawPos.x, .y = drawPos.y, .width = (float)TILE_SIZE, .height = (float)TILE_SIZE};
-
-            if (!CheckCollisionRecs(view, bounds))
-                continue;
-
-            DrawRectangle(drawPos.x + 2.0f, drawPos.y + 2.0f, bounds.width - 4.0f, bounds.height - 4.0f, obj->type->color);
+            const ObjectPtrList* list = &map->objectSets.chunks[cy][cx];
+            for (int i = 0; i < list->count; ++i)
+            {
+                const Object* obj = list->items[i];
+                if (!obj->type)
+                    continue;
+
+                if (obj->type->texture.id != 0)
+                {
+                    Rectangle src     = object_type_frame_rect(obj->type, obj->animation.currentFrame);
+                    Vector2   drawPos = object_frame_draw_position(obj, (int)src.width, (int)src.height);
+                    Rectangle bounds  = {.x = drawPos.x, .y = drawPos.y, .width = src.width, .height = src.height};
+
+                    if (!CheckCollisionRecs(view, bounds))
+                        continue;
+
+                    DrawTextureRec(obj->type->texture, src, drawPos, WHITE);
+                }
+                else
+                {
+                    Vector2   drawPos = object_frame_draw_position(obj, TILE_SIZE, TILE_SIZE);
+                    Rectangle bounds  = {.x = drawPos.x, .y = drawPos.y, .width = (float)TILE_SIZE, .height = (float)TILE_SIZE};
+
+                    if (!CheckCollisionRecs(view, bounds))
+                        continue;
+
+                    DrawRectangle(drawPos.x + 2.0f, drawPos.y + 2.0f, bounds.width - 4.0f, bounds.height - 4.0f, obj->type->color);
+                }
+            }
         }
     }
 }
@@ -821,13 +1075,15 @@ void object_draw_environment(const Map* map, const Camera2D* camera)
             int wx = (x % map->width + map->width) % map->width;
             int wy = (y % map->height + map->height) % map->height;
 
-            Object* obj = map->objects[wy][wx];
-            if (!obj || !obj->type)
+            const ObjectCell* cell = &map->objectCells[wy][wx];
+            if (cell->type == OBJ_NONE)
                 continue;
-            if ((int)obj->position.x != wx || (int)obj->position.y != wy)
+
+            const ObjectType* type = get_object_type((ObjectTypeID)cell->type);
+            if (!object_type_emits(type) || !object_active_at(map, type, wx, wy))
                 continue;
 
-            draw_object_environment_effect(obj, pixelView);
+            draw_object_environment_effect(type, wx, wy, pixelView);
         }
     }
     EndBlendMode();
@@ -855,28 +1111,25 @@ void draw_objects(Map* map, Camera2D* camera)
             int wx = (x % map->width + map->width) % map->width;
             int wy = (y % map->height + map->height) % map->height;
 
-            Object* obj = map->objects[wy][wx];
-            if (!obj)
-                continue;
-
-            const ObjectType* type = obj->type;
-            if (!type)
+            const ObjectCell* cell = &map->objectCells[wy][wx];
+            if (cell->type == OBJ_NONE)
                 continue;
 
+            const ObjectType* type = get_object_type((ObjectTypeID)cell->type);
             if (object_type_is_dynamic(type))
                 continue; // drawn separately
 
             // --- If object had a texture ---
             if (type->texture.id != 0)
             {
-                Rectangle src     = object_type_frame_rect(type, object_static_frame(obj));
-                Vector2   drawPos = object_frame_draw_position(obj, (int)src.width, (int)src.height);
+                Rectangle src     = object_type_frame_rect(type, cell->variant);
+                Vector2   drawPos = object_type_draw_position(type, wx, wy, (int)src.width, (int)src.height);
                 DrawTextureRec(type->texture, src, drawPos, WHITE);
             }
             else
             {
                 // --- otherwise colored rectangle ---
-                Vector2 drawPos = object_frame_draw_position(obj, TILE_SIZE, TILE_SIZE);
+                Vector2 drawPos = object_type_draw_position(type, wx, wy, TILE_SIZE, TILE_SIZE);
                 float   size    = TILE_SIZE * 0.6f; // plus petit que la tuile
                 float   offsetX = ((float)TILE_SIZE - size) * 0.5f;
                 float   offsetY = ((float)TILE_SIZE - size) * 0.5f;
@@ -5,35 +5,32 @@
 
 #include "world.h"
 
-static Pantry gPantries[MAX_BUILDINGS];
-static int    gPantryCount = 0;
-
-static Pantry* pantry_find(int buildingId)
+static Pantry* pantry_find(PantryRegistry* reg, int buildingId)
 {
-    if (buildingId < 0)
+    if (!reg || buildingId < 0)
         return NULL;
-    for (int i = 0; i < gPantryCount; ++i)
+    for (int i = 0; i < reg->count; ++i)
     {
-        if (gPantries[i].buildingId == buildingId)
-            return &gPantries[i];
+        if (reg->entries[i].buildingId == buildingId)
+            return &reg->entries[i];
     }
     return NULL;
 }
 
-void pantry_system_reset(void)
+void pantry_system_reset(PantryRegistry* reg)
 {
-    memset(gPantries, 0, sizeof(gPantries));
-    gPantryCount = 0;
+    if (reg)
+        memset(reg, 0, sizeof(*reg));
 }
 
-Pantry* pantry_get_for_building(int buildingId)
+Pantry* pantry_get_for_building(PantryRegistry* reg, int buildingId)
 {
-    return pantry_find(buildingId);
+    return pantry_find(reg, buildingId);
 }
 
-Pantry* pantry_create_or_get(int buildingId, int capacity)
+Pantry* pantry_create_or_get(PantryRegistry* reg, int buildingId, int capacity)
 {
-    Pantry* existing = pantry_find(buildingId);
+    Pantry* existing = pantry_find(reg, buildingId);
     if (existing)
     {
         if (capacity > 0)
@@ -41,12 +38,12 @@ Pantry* pantry_create_or_get(int buildingId, int capacity)
         return existing;
     }
 
-    if (gPantryCount >= MAX_BUILDINGS)
+    if (!reg || reg->count >= MAX_BUILDINGS)
         return NULL;
 
-    Pantry* pantry = &gPantries[gPantryCount++];
+    Pantry* pantry = &reg->entries[reg->count++];
     memset(pantry, 0, sizeof(*pantry));
-    pantry->id         = gPantryCount;
+    pantry->id         = reg->count;
     pantry->buildingId = buildingId;
     pantry->capacity   = (capacity > 0) ? capacity : 0;
     return pantry;
@@ -87,15 +84,17 @@ int pantry_withdraw(Pantry* pantry, PantryItemType type, int quantity)
     return taken;
 }
 
-void pantry_remove(int buildingId)
+void pantry_remove(PantryRegistry* reg, int buildingId)
 {
-    for (int i = 0; i < gPantryCount; ++i)
+    if (!reg)
+        return;
+    for (int i = 0; i < reg->count; ++i)
     {
-        if (gPantries[i].buildingId == buildingId)
+        if (reg->entries[i].buildingId == buildingId)
         {
-            if (i < gPantryCount - 1)
-                memmove(&gPantries[i], &gPantries[i + 1], (size_t)(gPantryCount - i - 1) * sizeof(Pantry));
-            --gPantryCount;
+            if (i < reg->count - 1)
+                memmove(&reg->entries[i], &reg->entries[i + 1], (size_t)(reg->count - i - 1) * sizeof(Pantry));
+            --reg->count;
             return;
         }
     }
@@ -8,6 +8,7 @@
 #include "tiles_loader.h"
 #include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
 
 TileType tileTypes[TILE_MAX] = {0};
 
@@ -20,6 +21,55 @@ static uint32_t tile_hash_coords(int x, int y, TileTypeID id)
     return hx ^ hy ^ hi;
 }
 
+/** Computes the source rect of every variation once the grid is known. */
+static void build_variation_rects(TileType* type)
+{
+    free(type->variationRects);
+    type->variationRects = NULL;
+
+    if (type->texture.id == 0)
+        return;
+
+    int   variations = type->textureVariations > 0 ? type->textureVariations : 1;
+    float frameW     = (type->variationFrameWidth > 0) ? (float)type->variationFrameWidth : 0.0f;
+    float frameH     = (type->variationFrameHeight > 0) ? (float)type->variationFrameHeight : 0.0f;
+
+    if (variations <= 1 || frameW <= 0.0f || frameH <= 0.0f)
+    {
+        // Whole texture: a single entry, and every tile uses variant 0.
+        type->textureVariations = 1;
+        type->variationRects    = (Rectangle*)malloc(sizeof(Rectangle));
+        if (type->variationRects)
+            type->variationRects[0] = (Rectangle){0.0f, 0.0f, (float)type->texture.width, (float)type->texture.height};
+        return;
+    }
+
+    if (variations > TILE_MAX_VARIATIONS)
+    {
+        printf("⚠️  Tile '%s' has %d variations, only the first %d are used.\n",
+               type->name ? type->name : "(unnamed)",
+               variations,
+               TILE_MAX_VARIATIONS);
+        variations              = TILE_MAX_VARIATIONS;
+        type->textureVariations = variations;
+    }
+
+    int columns = type->variationColumns > 0 ? type->variationColumns : variations;
+    if (columns <= 0)
+        columns = 1;
+
+    type->variationRects = (Rectangle*)malloc((size_t)variations * sizeof(Rectangle));
+    if (!type->variationRects)
+        return;
+
+    for (int v = 0; v < variations; ++v)
+    {
+        int col                 = v % columns;
+        int row                 = v / columns;
+        type->variationRects[v] = (Rectangle){frameW * (float)col, frameH * (float)row, frameW, frameH};
+    }
+}
+
 void init_tile_types(void)
 {
     // Load tile metadata from disk before uploading textures.
@@ -107,6 +157,8 @@ void init_tile_types(void)
             tileTypes[i].variationFrameWidth = 0;
             tileTypes[i].variationFrameHeight = 0;
         }
+
+        build_variation_rects(&tileTypes[i]);
     }
 }
 
@@ -120,6 +172,8 @@ void unload_tile_types(void)
             UnloadTexture(tileTypes[i].texture);
             tileTypes[i].texture.id = 0;
         }
+        free(tileTypes[i].variationRects);
+        tileTypes[i].variationRects = NULL;
     }
 }
 
@@ -132,47 +186,38 @@ TileType* get_tile_type(TileTypeID id)
     return NULL;
 }
 
-Rectangle tile_get_source_rect(const TileType* type, int tileX, int tileY)
+uint8_t tile_variant_at(const TileType* type, int tileX, int tileY)
 {
-    if (!type || type->texture.id == 0)
-        return (Rectangle){0, 0, 0, 0};
-
-    int variations = type->textureVariations > 0 ? type->textureVariations : 1;
-    float frameW   = (type->variationFrameWidth > 0) ? (float)type->variationFrameWidth : 0.0f;
-    float frameH   = (type->variationFrameHeight > 0) ? (float)type->variationFrameHeight : 0.0f;
-
-    if (variations <= 1 || frameW <= 0.0f || frameH <= 0.0f)
-    {
-        return (Rectangle){0.0f, 0.0f, (float)type->texture.width, (float)type->texture.height};
-    }
+    if (!type || type->textureVariations <= 1)
+        return 0;
 
-    uint32_t hash    = tile_hash_coords(tileX, tileY, type->id);
-    int      variant = (int)(hash % (uint32_t)variations);
-
-    int columns = type->variationColumns > 0 ? type->variationColumns : variations;
-    int rows    = type->variationRows > 0 ? type->variationRows : 1;
-    if (columns <= 0)
-        columns = 1;
-    if (rows <= 0)
-        rows = (variations + columns - 1) / columns;
+    uint32_t hash = tile_hash_coords(tileX, tileY, type->id);
+    return (uint8_t)(hash % (uint32_t)type->textureVariations);
+}
 
-    int col = variant % columns;
-    int row = variant / columns;
+Rectangle tile_variant_rect(const TileType* type, int variant)
+{
+    if (!type || type->texture.id == 0 || !type->variationRects)
+        return (Rectangle){0, 0, 0, 0};
 
-    float srcX = frameW * (float)col;
-    float srcY = frameH * (float)row;
+    if (variant < 0 || variant >= type->textureVariations)
+        variant = 0;
+    return type->variationRects[variant];
+}
 
-    return (Rectangle){srcX, srcY, frameW, frameH};
+Rectangle tile_get_source_rect(const TileType* type, int tileX, int tileY)
+{
+    return tile_variant_rect(type, tile_variant_at(type, tileX, tileY));
 }
 
-void tile_draw(const TileType* type, int tileX, int tileY, float destX, float destY)
+void tile_draw(const TileType* type, int variant, float destX, float destY)
 {
     if (!type)
         return;
 
     if (type->texture.id != 0)
     {
-        Rectangle src  = tile_get_source_rect(type, tileX, tileY);
+        Rectangle src  = tile_variant_rect(type, variant);
         Rectangle dest = {destX, destY, (float)TILE_SIZE, (float)TILE_SIZE};
         Vector2   origin = {0.0f, 0.0f};
         DrawTexturePro(type->texture, src, dest, origin, 0.0f, WHITE);
@@ -0,0 +1,225 @@
+/**
+ * @file tile_stats.c
+ * @brief Implements the per-chunk tile histograms and their area queries.
+ */
+
+#include "tile_stats.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "tile.h"
+
+static inline bool tile_valid(TileTypeID tile)
+{
+    return tile >= 0 && tile < TILE_MAX;
+}
+
+static inline int clamp_chunk(int v, int maxExclusive)
+{
+    if (v < 0)
+        return 0;
+    if (v >= maxExclusive)
+        return maxExclusive - 1;
+    return v;
+}
+
+static void summary_add_tiles(TileStatsSummary* s, TileTypeID tile, int delta)
+{
+    s->tileCounts[tile] += delta;
+    s->totalTiles += delta;
+    BiomeKind biome = tile_stats_biome_of(tile);
+    if (biome >= 0 && biome < BIO_MAX)
+        s->biomeCounts[biome] += delta;
+}
+
+// -----------------------------------------------------------------------------
+// Maintenance
+// -----------------------------------------------------------------------------
+
+void tile_stats_reset(Map* map)
+{
+    if (!map)
+        return;
+    memset(&map->tileStats, 0, sizeof(map->tileStats));
+}
+
+void tile_stats_rebuild(Map* map)
+{
+    tile_stats_reset(map);
+    if (!map)
+        return;
+
+    TileStats* stats = &map->tileStats;
+
+    for (int y = 0; y < map->height; ++y)
+    {
+        uint16_t(*rowCounts)[TILE_MAX] = stats->chunkCounts[y / CHUNK_H];
+        for (int x = 0; x < map->width; ++x)
+        {
+            TileTypeID tile = map->tiles[y][x];
+            if (!tile_valid(tile))
+                continue;
+            rowCounts[x / CHUNK_W][tile]++;
+        }
+    }
+
+    stats->global.chunkCount = MAP_CHUNKS_X * MAP_CHUNKS_Y;
+    for (int cy = 0; cy < MAP_CHUNKS_Y; ++cy)
+        for (int cx = 0; cx < MAP_CHUNKS_X; ++cx)
+            for (int t = 0; t < TILE_MAX; ++t)
+                if (stats->chunkCounts[cy][cx][t])
+                    summary_add_tiles(&stats->global, (TileTypeID)t, stats->chunkCounts[cy][cx][t]);
+
+    stats->ready = true;
+}
+
+bool tile_stats_ready(const Map* map)
+{
+    return map && map->tileStats.ready;
+}
+
+void tile_stats_on_tile_changed(Map* map, int tileX, int tileY, TileTypeID before, TileTypeID after)
+{
+    if (!tile_stats_ready(map) || before == after)
+        return;
+    if (tileX < 0 || tileY < 0 || tileX >= MAP_WIDTH || tileY >= MAP_HEIGHT)
+        return;
+
+    TileStats* stats  = &map->tileStats;
+    uint16_t*  counts = stats->chunkCounts[tileY / CHUNK_H][tileX / CHUNK_W];
+    if (tile_valid(before) && counts[before] > 0)
+    {
+        counts[before]--;
+        summary_add_tiles(&stats->global, before, -1);
+    }
+    if (tile_valid(after))
+    {
+        counts[after]++;
+        summary_add_tiles(&stats->global, after, 1);
+    }
+}
+
+BiomeKind tile_stats_biome_of(TileTypeID tile)
+{
+    switch (tile)
+    {
+        case TILE_FOREST:
+            return BIO_FOREST;
+        case TILE_GRASS:
+        case TILE_PLAIN:
+            return BIO_PLAIN;
+        case TILE_SAVANNA:
+            return BIO_SAVANNA;
+        case TILE_TUNDRA:
+        case TILE_TUNDRA_2:
+            return BIO_TUNDRA;
+        case TILE_DESERT:
+            return BIO_DESERT;
+        case TILE_SWAMP:
+            return BIO_SWAMP;
+        case TILE_MOUNTAIN:
+            return BIO_MOUNTAIN;
+        case TILE_CURSED_FOREST:
+        case TILE_POISON:
+            return BIO_CURSED;
+        case TILE_HELL:
+        case TILE_LAVA:
+            return BIO_HELL;
+        case TILE_WATER:
+            return BIO_PLAIN;
+        default:
+            return BIO_PLAIN;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Queries
+// -----------------------------------------------------------------------------
+
+const TileStatsSummary* tile_stats_global(const Map* map)
+{
+    return &map->tileStats.global;
+}
+
+void tile_stats_query_chunks(const Map* map, int chunkX0, int chunkY0, int chunkX1, int chunkY1, TileStatsSummary* out)
+{
+    if (!out)
+        return;
+    memset(out, 0, sizeof(*out));
+    if (!tile_stats_ready(map) || chunkX1 < 0 || chunkY1 < 0 || chunkX0 >= MAP_CHUNKS_X || chunkY0 >= MAP_CHUNKS_Y)
+        return;
+
+    chunkX0 = clamp_chunk(chunkX0, MAP_CHUNKS_X);
+    chunkY0 = clamp_chunk(chunkY0, MAP_CHUNKS_Y);
+    chunkX1 = clamp_chunk(chunkX1, MAP_CHUNKS_X);
+    chunkY1 = clamp_chunk(chunkY1, MAP_CHUNKS_Y);
+
+    for (int cy = chunkY0; cy <= chunkY1; ++cy)
+    {
+        for (int cx = chunkX0; cx <= chunkX1; ++cx)
+        {
+            const uint16_t* counts = map->tileStats.chunkCounts[cy][cx];
+            for (int t = 0; t < TILE_MAX; ++t)
+                if (counts[t])
+                    summary_add_tiles(out, (TileTypeID)t, counts[t]);
+            out->chunkCount++;
+        }
+    }
+}
+
+void tile_stats_query_rect(const Map* map, Rectangle worldRect, TileStatsSummary* out)
+{
+    const float chunkW = (float)(CHUNK_W * TILE_SIZE);
+    const float chunkH = (float)(CHUNK_H * TILE_SIZE);
+    int         cx0    = (int)floorf(worldRect.x / chunkW);
+    int         cy0    = (int)floorf(worldRect.y / chunkH);
+    int         cx1    = (int)floorf((worldRect.x + worldRect.width) / chunkW);
+    int         cy1    = (int)floorf((worldRect.y + worldRect.height) / chunkH);
+    tile_stats_query_chunks(map, cx0, cy0, cx1, cy1, out);
+}
+
+void tile_stats_query_radius(const Map* map, int tileX, int tileY, int radius, TileStatsSummary* out)
+{
+    if (radius < 0)
+        radius = 0;
+    int minX = tileX - radius;
+    int minY = tileY - radius;
+    int maxX = tileX + radius;
+    int maxY = tileY + radius;
+    tile_stats_query_chunks(map, (int)floorf((float)minX / CHUNK_W), (int)floorf((float)minY / CHUNK_H), maxX / CHUNK_W, maxY / CHUNK_H, out);
+}
+
+int tile_stats_climate_means(const Map* map, const TileStatsSummary* stats, BiomeKind biome, float* fertility, float* humidity, float* temperature)
+{
+    double sumF  = 0.0;
+    double sumH  = 0.0;
+    double sumT  = 0.0;
+    int    tiles = 0;
+
+    if (map && stats)
+    {
+        for (int t = 0; t < TILE_MAX; ++t)
+        {
+            int count = stats->tileCounts[t];
+            if (count <= 0)
+                continue;
+            if (biome != BIO_MAX && tile_stats_biome_of((TileTypeID)t) != biome)
+                continue;
+
+            const TileClimate* climate = &map->tileClimate[t];
+            sumF += (double)climate->fertility * count;
+            sumH += (double)climate->humidity * count;
+            sumT += (double)climate->temperature * count;
+            tiles += count;
+        }
+    }
+
+    if (fertility)
+        *fertility = tiles > 0 ? (float)(sumF / tiles) : 0.0f;
+    if (humidity)
+        *humidity = tiles > 0 ? (float)(sumH / tiles) : 0.0f;
+    if (temperature)
+        *temperature = tiles > 0 ? (float)(sumT / tiles) : 0.0f;
+    return tiles;
+}
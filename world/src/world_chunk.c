@@ -6,18 +6,44 @@
 #include "world_chunk.h"
 #include "tile.h"
 #include "object.h"
+#include "frame_budget.h"
+#include "jobs.h"
+#include "profiler.h"
+#include "tunables.h"
+#include "camera.h"
 #include "raymath.h"
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
-ChunkGrid* gChunks = NULL;
-
 static inline int clampi(int v, int lo, int hi)
 {
     return v < lo ? lo : (v > hi ? hi : v);
 }
 
+/** Most chunks rebuilt in one batch (the rebuild budget is clamped to it). */
+#define CHUNK_BATCH_MAX 32
+/** Points sampled along the predicted camera path when ordering prefetches. */
+#define CHUNK_PREFETCH_SAMPLES 4
+/** One record per tile plus at most one per static object. */
+#define CHUNK_DRAW_RECORDS_MAX (CHUNK_W * CHUNK_H * 2)
+
+typedef struct ChunkDrawRecord
+{
+    const Texture2D* texture; // NULL: solid fill of dst with tint
+    Rectangle        src;
+    Rectangle        dst;     // chunk-local pixels
+    Color            tint;
+} ChunkDrawRecord;
+
+typedef struct ChunkDrawList
+{
+    MapChunk*        chunk;
+    int              count;
+    ChunkDrawRecord* records; // CHUNK_DRAW_RECORDS_MAX entries, allocated once
+} ChunkDrawList;
+
 // ---------------------------------------------------------------
 //  Creation / destruction
 // ---------------------------------------------------------------
@@ -28,6 +54,7 @@ ChunkGrid* chunkgrid_create(Map* map)
     cg->chunksX   = (map->width + CHUNK_W - 1) / CHUNK_W;
     cg->chunksY   = (map->height + CHUNK_H - 1) / CHUNK_H;
     cg->chunks    = calloc((size_t)cg->chunksX * cg->chunksY, sizeof(MapChunk));
+    cg->drawLists = calloc(CHUNK_BATCH_MAX, sizeof(ChunkDrawList));
 
     for (int cy = 0; cy < cg->chunksY; ++cy)
         for (int cx = 0; cx < cg->chunksX; ++cx)
@@ -51,7 +78,11 @@ void chunkgrid_destroy(ChunkGrid* cg)
     for (int i = 0; i < cg->chunksX * cg->chunksY; ++i)
         if (cg->chunks[i].rt.id != 0)
             UnloadRenderTexture(cg->chunks[i].rt);
+    if (cg->drawLists)
+        for (int i = 0; i < CHUNK_BATCH_MAX; ++i)
+            free(cg->drawLists[i].records);
 
+    free(cg->drawLists);
     free(cg->chunks);
     free(cg);
 }
@@ -84,26 +115,26 @@ void chunkgrid_redraw_cell(ChunkGrid* cg, Map* map, int x, int y)
     const int originPixelX     = originTileX * TILE_SIZE;
     const int originPixelY     = originTileY * TILE_SIZE;
 
-    Object*   o              = map->objects[y][x];
-    bool      drawObject     = false;
-    Rectangle objectSrc      = {0};
-    Vector2   objectLocalPos = {0};
+    const ObjectCell  cell           = map->objectCells[y][x];
+    const ObjectType* objType        = cell.type != OBJ_NONE ? get_object_type((ObjectTypeID)cell.type) : NULL;
+    bool              drawObject     = false;
+    Rectangle         objectSrc      = {0};
+    Vector2           objectLocalPos = {0};
 
-    if (o && o->type && !o->type->activatable)
+    if (objType && !objType->activatable)
     {
         drawObject = true;
 
-        int frameIndex = object_static_frame(o);
-        if (o->type->texture.id != 0)
-            objectSrc = object_type_frame_rect(o->type, frameIndex);
+        if (objType->texture.id != 0)
+            objectSrc = object_type_frame_rect(objType, cell.variant);
         else
         {
-            float fw  = (float)(o->type->spriteFrameWidth > 0 ? o->type->spriteFrameWidth : TILE_SIZE);
-            float fh  = (float)(o->type->spriteFrameHeight > 0 ? o->type->spriteFrameHeight : TILE_SIZE);
+            float fw  = (float)(objType->spriteFrameWidth > 0 ? objType->spriteFrameWidth : TILE_SIZE);
+            float fh  = (float)(objType->spriteFrameHeight > 0 ? objType->spriteFrameHeight : TILE_SIZE);
             objectSrc = (Rectangle){0.0f, 0.0f, fw, fh};
         }
 
-        Vector2 drawPos = object_frame_draw_position(o, (int)objectSrc.width, (int)objectSrc.height);
+        Vector2 drawPos = object_type_draw_position(objType, x, y, (int)objectSrc.width, (int)objectSrc.height);
         objectLocalPos  = (Vector2){drawPos.x - originPixelX, drawPos.y - originPixelY};
 
         if (objectLocalPos.x < -1.0f || objectLocalPos.y < -1.0f || objectLocalPos.x + objectSrc.width > (float)chunkPixelWidth + 1.0f || objectLocalPos.y + objectSrc.height > (float)chunkPixelHeight + 1.0f)
@@ -112,7 +143,7 @@ void chunkgrid_redraw_cell(ChunkGrid* cg, Map* map, int x, int y)
             return;
         }
     }
-    else if (o && o->type && o->type->activatable)
+    else if (objType && objType->activatable)
     {
         drawObject = false;
     }
@@ -131,14 +162,14 @@ void chunkgrid_redraw_cell(ChunkGrid* cg, Map* map, int x, int y)
     // --- Redessine la tuile ---
     const TileType* tt = get_tile_type(map->tiles[y][x]);
     if (tt)
-        tile_draw(tt, x, y, (float)localX, (float)localY);
+        tile_draw(tt, map->tileVariants[y][x], (float)localX, (float)localY);
 
     // --- Redessine l’objet éventuel ---
     if (drawObject)
     {
         // On redessine normalement, mais tout ce qui dépasse la tuile sera "coupé"
-        if (o->type->texture.id)
-            DrawTextureRec(o->type->texture, objectSrc, objectLocalPos, WHITE);
+        if (objType->texture.id)
+            DrawTextureRec(objType->texture, objectSrc, objectLocalPos, WHITE);
         else
         {
             Rectangle fill = {
@@ -147,7 +178,7 @@ void chunkgrid_redraw_cell(ChunkGrid* cg, Map* map, int x, int y)
                 .width  = objectSrc.width - 4.0f,
                 .height = objectSrc.height - 4.0f,
             };
-            DrawRectangleRec(fill, o->type->color);
+            DrawRectangleRec(fill, objType->color);
         }
     }
 
@@ -206,19 +237,32 @@ void chunkgrid_mark_dirty_tile(ChunkGrid* cg, int x, int y)
 }
 
 // ---------------------------------------------------------------
-//  Internal: draw a tile/object chunk into its RenderTexture
+//  Internal: two-stage chunk rebuild
+//
+//  Stage 1 (worker threads) resolves every tile and static object of a
+//  chunk into flat draw records; stage 2 (main thread, GL context) only
+//  replays them into the chunk's RenderTexture.
 // ---------------------------------------------------------------
 
-static void rebuild_chunk(MapChunk* c, Map* map)
+typedef struct ChunkPrepJob
 {
-    const int x0 = c->cx * CHUNK_W;
-    const int y0 = c->cy * CHUNK_H;
+    const Map*     map;
+    ChunkDrawList* lists;
+} ChunkPrepJob;
 
-    // Render into a temporary texture first
-    RenderTexture2D temp = LoadRenderTexture(CHUNK_W * TILE_SIZE, CHUNK_H * TILE_SIZE);
+static inline void draw_list_push(ChunkDrawList* list, const Texture2D* texture, Rectangle src, Rectangle dst, Color tint)
+{
+    if (list->count < CHUNK_DRAW_RECORDS_MAX)
+        list->records[list->count++] = (ChunkDrawRecord){texture, src, dst, tint};
+}
 
-    BeginTextureMode(temp);
-    ClearBackground(BLANK);
+static void prepare_chunk(ChunkDrawList* list, const Map* map)
+{
+    const MapChunk* c  = list->chunk;
+    const int       x0 = c->cx * CHUNK_W;
+    const int       y0 = c->cy * CHUNK_H;
+
+    list->count = 0;
 
     // --- Tiles ---
     for (int ty = 0; ty < CHUNK_H; ++ty)
@@ -234,10 +278,14 @@ static void rebuild_chunk(MapChunk* c, Map* map)
                 break;
 
             const TileType* tt = get_tile_type(map->tiles[y][x]);
-            int             px = tx * TILE_SIZE;
-            int             py = ty * TILE_SIZE;
+            if (!tt)
+                continue;
 
-            tile_draw(tt, x, y, (float)px, (float)py);
+            Rectangle dst = {(float)(tx * TILE_SIZE), (float)(ty * TILE_SIZE), (float)TILE_SIZE, (float)TILE_SIZE};
+            if (tt->texture.id != 0)
+                draw_list_push(list, &tt->texture, tile_variant_rect(tt, map->tileVariants[y][x]), dst, WHITE);
+            else
+                draw_list_push(list, NULL, (Rectangle){0}, dst, tt->color);
         }
     }
 
@@ -254,29 +302,33 @@ static void rebuild_chunk(MapChunk* c, Map* map)
             if (x >= map->width)
                 break;
 
-            Object* o = map->objects[y][x];
-            if (!o || !o->type || o->type->activatable)
+            const ObjectCell cell = map->objectCells[y][x];
+            if (cell.type == OBJ_NONE)
+                continue;
+
+            // Static decor is fully described by its packed cell.
+            const ObjectType* type = get_object_type((ObjectTypeID)cell.type);
+            if (type->activatable)
                 continue;
 
-            int       frameIndex = object_static_frame(o);
             Rectangle src;
-            if (o->type->texture.id)
-                src = object_type_frame_rect(o->type, frameIndex);
+            if (type->texture.id)
+                src = object_type_frame_rect(type, cell.variant);
             else
             {
-                float fw = (float)(o->type->spriteFrameWidth > 0 ? o->type->spriteFrameWidth : TILE_SIZE);
-                float fh = (float)(o->type->spriteFrameHeight > 0 ? o->type->spriteFrameHeight : TILE_SIZE);
+                float fw = (float)(type->spriteFrameWidth > 0 ? type->spriteFrameWidth : TILE_SIZE);
+                float fh = (float)(type->spriteFrameHeight > 0 ? type->spriteFrameHeight : TILE_SIZE);
                 src      = (Rectangle){0.0f, 0.0f, fw, fh};
             }
 
-            Vector2 drawPos  = object_frame_draw_position(o, (int)src.width, (int)src.height);
+            Vector2 drawPos  = object_type_draw_position(type, x, y, (int)src.width, (int)src.height);
             Vector2 localPos = {
                 drawPos.x - (float)(x0 * TILE_SIZE),
                 drawPos.y - (float)(y0 * TILE_SIZE),
             };
 
-            if (o->type->texture.id)
-                DrawTextureRec(o->type->texture, src, localPos, WHITE);
+            if (type->texture.id)
+                draw_list_push(list, &type->texture, src, (Rectangle){localPos.x, localPos.y, src.width, src.height}, WHITE);
             else
             {
                 Rectangle fill = {
@@ -285,10 +337,37 @@ static void rebuild_chunk(MapChunk* c, Map* map)
                     .width  = src.width - 4.0f,
                     .height = src.height - 4.0f,
                 };
-                DrawRectangleRec(fill, o->type->color);
+                draw_list_push(list, NULL, (Rectangle){0}, fill, type->color);
             }
         }
     }
+}
+
+static void prepare_chunk_range(void* user, int begin, int end)
+{
+    const ChunkPrepJob* job = (const ChunkPrepJob*)user;
+    for (int i = begin; i < end; ++i)
+        prepare_chunk(&job->lists[i], job->map);
+}
+
+static void submit_chunk(const ChunkDrawList* list)
+{
+    MapChunk* c = list->chunk;
+
+    // Render into a temporary texture first
+    RenderTexture2D temp = LoadRenderTexture(CHUNK_W * TILE_SIZE, CHUNK_H * TILE_SIZE);
+
+    BeginTextureMode(temp);
+    ClearBackground(BLANK);
+
+    for (int i = 0; i < list->count; ++i)
+    {
+        const ChunkDrawRecord* r = &list->records[i];
+        if (r->texture)
+            DrawTexturePro(*r->texture, r->src, r->dst, (Vector2){0.0f, 0.0f}, 0.0f, r->tint);
+        else
+            DrawRectangleRec(r->dst, r->tint);
+    }
 
     EndTextureMode();
 
@@ -301,50 +380,192 @@ static void rebuild_chunk(MapChunk* c, Map* map)
     c->buildTimer = 0.0001f; // used for fade-in animation
 }
 
+/** Prepares a batch of chunks in parallel, then uploads them in order. */
+static void rebuild_chunks(ChunkGrid* cg, MapChunk** chunks, int count, const Map* map)
+{
+    if (!cg->drawLists)
+        return;
+
+    int ready = 0;
+    for (int i = 0; i < count && i < CHUNK_BATCH_MAX; ++i)
+    {
+        ChunkDrawList* list = &cg->drawLists[ready];
+        if (!list->records)
+            list->records = (ChunkDrawRecord*)malloc(CHUNK_DRAW_RECORDS_MAX * sizeof(ChunkDrawRecord));
+        if (!list->records)
+            break;
+        list->chunk = chunks[i];
+        ready++;
+    }
+
+    ChunkPrepJob job = {map, cg->drawLists};
+    jobs_parallel_for(ready, 1, prepare_chunk_range, &job);
+
+    for (int i = 0; i < ready; ++i)
+        submit_chunk(&cg->drawLists[i]);
+}
+
+// ---------------------------------------------------------------
+//  Prefetch ordering
+// ---------------------------------------------------------------
+
+typedef struct ChunkRange
+{
+    int x0, y0, x1, y1; // inclusive, clamped to the grid
+} ChunkRange;
+
+typedef struct PrefetchCandidate
+{
+    MapChunk* chunk;
+    float     score; // lower = expected on screen sooner
+} PrefetchCandidate;
+
+static ChunkRange chunk_range_for_view(const ChunkGrid* cg, Rectangle view, int margin)
+{
+    const float chunkPxW = (float)(CHUNK_W * TILE_SIZE);
+    const float chunkPxH = (float)(CHUNK_H * TILE_SIZE);
+    return (ChunkRange){
+        clampi((int)floorf(view.x / chunkPxW) - margin, 0, cg->chunksX - 1),
+        clampi((int)floorf(view.y / chunkPxH) - margin, 0, cg->chunksY - 1),
+        clampi((int)ceilf((view.x + view.width) / chunkPxW) + margin, 0, cg->chunksX - 1),
+        clampi((int)ceilf((view.y + view.height) / chunkPxH) + margin, 0, cg->chunksY - 1),
+    };
+}
+
+static inline bool chunk_range_contains(const ChunkRange* r, int cx, int cy)
+{
+    return cx >= r->x0 && cx <= r->x1 && cy >= r->y0 && cy <= r->y1;
+}
+
+/** Keeps the @p capacity best-scored candidates sorted in @p best; returns the new count. */
+static int prefetch_insert(PrefetchCandidate* best, int count, int capacity, PrefetchCandidate candidate)
+{
+    if (count == capacity && candidate.score >= best[count - 1].score)
+        return count;
+
+    int i = (count < capacity) ? count++ : count - 1;
+    while (i > 0 && best[i - 1].score > candidate.score)
+    {
+        best[i] = best[i - 1];
+        --i;
+    }
+    best[i] = candidate;
+    return count;
+}
+
+/**
+ * Picks up to @p capacity missing/dirty chunks outside the visible range,
+ * soonest-needed first. The camera path is sampled CHUNK_PREFETCH_SAMPLES
+ * times over the prefetch horizon; a chunk scores the first sample whose view
+ * reaches it, so the budget follows pans and zooms. The static preload ring
+ * comes after every chunk on the path, nearest to the predicted focus first.
+ */
+static int chunkgrid_collect_prefetch(ChunkGrid* cg, const Camera2D* cam, const CameraMotion* motion, const ChunkRange* visible, int drawMargin, bool useRing, MapChunk** out, int capacity)
+{
+    const int   preloadMargin = tunable_get_int(TUNABLE_CHUNK_PRELOAD_MARGIN);
+    const float horizon       = tunable_get(TUNABLE_CAMERA_PREFETCH_SECONDS);
+    const float chunkPxW      = (float)(CHUNK_W * TILE_SIZE);
+    const float chunkPxH      = (float)(CHUNK_H * TILE_SIZE);
+    Rectangle   view          = camera_view_rect(cam);
+    Vector2     aheadCenter   = camera_predict(cam, motion, horizon).target;
+
+    ChunkRange ring   = chunk_range_for_view(cg, view, useRing ? preloadMargin : drawMargin);
+    ChunkRange bounds = ring;
+    ChunkRange path[CHUNK_PREFETCH_SAMPLES];
+    int        samples = horizon > 0.0f ? CHUNK_PREFETCH_SAMPLES : 0;
+    for (int s = 0; s < samples; ++s)
+    {
+        Camera2D ahead = camera_predict(cam, motion, horizon * (float)(s + 1) / (float)samples);
+        path[s]        = chunk_range_for_view(cg, camera_view_rect(&ahead), drawMargin);
+        bounds.x0      = path[s].x0 < bounds.x0 ? path[s].x0 : bounds.x0;
+        bounds.y0      = path[s].y0 < bounds.y0 ? path[s].y0 : bounds.y0;
+        bounds.x1      = path[s].x1 > bounds.x1 ? path[s].x1 : bounds.x1;
+        bounds.y1      = path[s].y1 > bounds.y1 ? path[s].y1 : bounds.y1;
+    }
+
+    PrefetchCandidate best[CHUNK_BATCH_MAX];
+    int               count = 0;
+    if (capacity > CHUNK_BATCH_MAX)
+        capacity = CHUNK_BATCH_MAX;
+
+    for (int cy = bounds.y0; cy <= bounds.y1; ++cy)
+    {
+        for (int cx = bounds.x0; cx <= bounds.x1; ++cx)
+        {
+            if (chunk_range_contains(visible, cx, cy))
+                continue;
+            MapChunk* c = &cg->chunks[cy * cg->chunksX + cx];
+            if (c->rt.id != 0 && !c->dirty)
+                continue;
+
+            float rank = -1.0f;
+            for (int s = 0; s < samples && rank < 0.0f; ++s)
+                if (chunk_range_contains(&path[s], cx, cy))
+                    rank = (float)s;
+            if (rank < 0.0f)
+            {
+                if (!useRing || !chunk_range_contains(&ring, cx, cy))
+                    continue;
+                rank = (float)samples;
+            }
+
+            // Within a rank, chunks nearer the predicted focus first (distance in
+            // chunks, squashed below one rank), so the ring leans into the pan.
+            float dx       = ((float)cx + 0.5f) * chunkPxW - aheadCenter.x;
+            float dy       = ((float)cy + 0.5f) * chunkPxH - aheadCenter.y;
+            float distance = sqrtf(dx * dx + dy * dy) / chunkPxW;
+            count          = prefetch_insert(best, count, capacity, (PrefetchCandidate){c, rank + distance / (distance + 1.0f)});
+        }
+    }
+
+    for (int i = 0; i < count; ++i)
+        out[i] = best[i].chunk;
+    return count;
+}
+
 // ---------------------------------------------------------------
 //  Cull + rebuild visible chunks only
 // ---------------------------------------------------------------
 
-void chunkgrid_draw_visible(ChunkGrid* cg, Map* map, Camera2D* cam)
+void chunkgrid_draw_visible(ChunkGrid* cg, Map* map, Camera2D* cam, const CameraMotion* motion)
 {
     if (!cg)
         return;
 
-    const float invZoom = 1.0f / cam->zoom;
-    Rectangle   view    = {cam->target.x - cam->offset.x * invZoom, cam->target.y - cam->offset.y * invZoom, GetScreenWidth() * invZoom, GetScreenHeight() * invZoom};
-
-    // Increase preload margin to prepare chunks off-screen
-    const int preloadMargin = 2; // 2 chunks around viewport
-    int       x0            = clampi((int)floorf(view.x / (CHUNK_W * TILE_SIZE)) - preloadMargin, 0, cg->chunksX - 1);
-    int       y0            = clampi((int)floorf(view.y / (CHUNK_H * TILE_SIZE)) - preloadMargin, 0, cg->chunksY - 1);
-    int       x1            = clampi((int)ceilf((view.x + view.width) / (CHUNK_W * TILE_SIZE)) + preloadMargin, 0, cg->chunksX - 1);
-    int       y1            = clampi((int)ceilf((view.y + view.height) / (CHUNK_H * TILE_SIZE)) + preloadMargin, 0, cg->chunksY - 1);
+    // Chunks that are (about to be) on screen
+    const int  drawMargin = 1; // actual visible area
+    ChunkRange visible    = chunk_range_for_view(cg, camera_view_rect(cam), drawMargin);
+    const int  x0         = visible.x0;
+    const int  y0         = visible.y0;
+    const int  x1         = visible.x1;
+    const int  y1         = visible.y1;
 
     // Only rebuild a few chunks per frame to avoid stutter
-    const int rebuildBudget = 3;
-    int       rebuilt       = 0;
+    const int rebuildBudget = clampi(tunable_get_int(TUNABLE_CHUNK_REBUILD_BUDGET), 1, CHUNK_BATCH_MAX);
+    MapChunk* batch[CHUNK_BATCH_MAX];
+    int       rebuilt = 0;
 
-    // PASS 1 – rebuild missing/dirty chunks (off-screen work)
+    // PASS 1a – rebuild missing/dirty visible chunks (never deferred)
     for (int cy = y0; cy <= y1 && rebuilt < rebuildBudget; ++cy)
     {
         for (int cx = x0; cx <= x1 && rebuilt < rebuildBudget; ++cx)
         {
             MapChunk* c = &cg->chunks[cy * cg->chunksX + cx];
-            if ((c->rt.id == 0 || c->dirty) && rebuilt < rebuildBudget)
-            {
-                rebuild_chunk(c, map);
-                rebuilt++;
-            }
+            if (c->rt.id == 0 || c->dirty)
+                batch[rebuilt++] = c;
         }
     }
 
-    // PASS 2 – draw only chunks that have a valid texture
-    const int drawMargin = 1; // actual visible area
-    x0                   = clampi((int)floorf(view.x / (CHUNK_W * TILE_SIZE)) - drawMargin, 0, cg->chunksX - 1);
-    y0                   = clampi((int)floorf(view.y / (CHUNK_H * TILE_SIZE)) - drawMargin, 0, cg->chunksY - 1);
-    x1                   = clampi((int)ceilf((view.x + view.width) / (CHUNK_W * TILE_SIZE)) + drawMargin, 0, cg->chunksX - 1);
-    y1                   = clampi((int)ceilf((view.y + view.height) / (CHUNK_H * TILE_SIZE)) + drawMargin, 0, cg->chunksY - 1);
+    // PASS 1b – spend what is left on the predicted camera path, then the
+    // preload ring, unless the frame governor defers it
+    const int preloadMargin = tunable_get_int(TUNABLE_CHUNK_PRELOAD_MARGIN);
+    if (rebuilt < rebuildBudget && frame_budget_allow(FRAME_TASK_CHUNK_PREWARM))
+        rebuilt += chunkgrid_collect_prefetch(cg, cam, motion, &visible, drawMargin, preloadMargin > drawMargin, batch + rebuilt, rebuildBudget - rebuilt);
+    if (rebuilt > 0)
+        rebuild_chunks(cg, batch, rebuilt, map);
+    profiler_count(PROFILER_COUNT_CHUNK_REBUILDS, rebuilt);
 
+    // PASS 2 – draw only chunks that have a valid texture
     for (int cy = y0; cy <= y1; ++cy)
     {
         for (int cx = x0; cx <= x1; ++cx)
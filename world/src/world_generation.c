@@ -13,22 +13,18 @@
 #include "road_planner.h"
 #include "entity.h"
 #include "building.h"
+#include "climate_field.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <limits.h>
 
-// If you want parallel generation, compile with -DWORLDGEN_USE_OPENMP -fopenmp
-#if defined(WORLDGEN_USE_OPENMP)
-#include <omp.h>
-#endif
+#include "jobs.h"
 
 // ----------------------------------------------------------------------------------
 // Deterministic RNG (splitmix64)
 // ----------------------------------------------------------------------------------
-static uint64_t g_seed64 = 0x12345678ABCDEF01ull;
-
 static uint64_t splitmix64_next(uint64_t* x)
 {
     uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
@@ -41,21 +37,12 @@ static float rng01(uint64_t* s)
     // 56-bit fraction → [0,1)
     return (splitmix64_next(s) >> 8) * (1.0f / (float)(1ull << 56));
 }
+// Every draw comes from the world's own stream; without one the result is fixed.
 static float random01(uint64_t* rng)
 {
-    if (rng)
-        return rng01(rng);
-    return (float)rand() / ((float)RAND_MAX + 1.0f);
+    return rng ? rng01(rng) : 0.0f;
 }
 
-// Pointers exposed to custom structure routines (e.g., cannibal villages).
-static PlacedStructure* g_worldgenPlaced          = NULL;
-static int*             g_worldgenPlacedCount     = NULL;
-static int              g_worldgenPlacedCap       = 0;
-static int*             g_worldgenStructureCounts = NULL;
-static uint64_t*        g_worldgenRng             = NULL;
-static int              g_nextVillageId           = 1;
-
 static const VillageBuildingSlot CANNIBAL_VILLAGE_SLOTS[] = {
     {STRUCT_CANNIBAL_LONGHOUSE, 1, 1, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f},      {STRUCT_HUT_CANNIBAL, 3, 6, 9.0f, 13.0f, 0.0f, 360.0f, 18.0f},         {STRUCT_CANNIBAL_COOK_TENT, 1, 3, 6.0f, 8.0f, 15.0f, 360.0f, 22.0f},
     {STRUCT_CANNIBAL_SHAMAN_HUT, 1, 1, 7.5f, 9.5f, 45.0f, 360.0f, 30.0f}, {STRUCT_CANNIBAL_BONE_PIT, 0, 1, 10.0f, 12.5f, -25.0f, 120.0f, 18.0f},
@@ -77,12 +64,10 @@ static int random_offset(uint64_t* rng, int radius)
 {
     if (radius <= 0)
         return 0;
-    if (rng)
-    {
-        uint64_t roll = splitmix64_next(rng);
-        return (int)(roll % (uint64_t)(radius * 2 + 1)) - radius;
-    }
-    return (rand() % (radius * 2 + 1)) - radius;
+    if (!rng)
+        return 0;
+    uint64_t roll = splitmix64_next(rng);
+    return (int)(roll % (uint64_t)(radius * 2 + 1)) - radius;
 }
 // ----------------------------------------------------------------------------------
 // Small utils
@@ -147,7 +132,7 @@ static float warped2D(float x, float y, uint32_t salt)
 // ----------------------------------------------------------------------------------
 // Parameters (kept compatible with your WorldGenParams)
 // ----------------------------------------------------------------------------------
-static WorldGenParams g_cfg = {
+static const WorldGenParams WORLDGEN_DEFAULT_PARAMS = {
     .min_biome_radius           = (MAP_WIDTH + MAP_HEIGHT) / 16,
     .weight_forest              = 1.0f,
     .weight_plain               = 1.0f,
@@ -172,14 +157,34 @@ static WorldGenParams g_cfg = {
     .biome_struct_mult_hell     = 0.2f,
 };
 
-void worldgen_seed(uint64_t seed)
+void worldgen_load_definitions(void)
+{
+    load_structure_metadata("data/structures.stv");
+    load_biome_definitions("data/biomes.stv");
+}
+
+void worldgen_state_init(WorldGenState* state)
+{
+    if (!state)
+        return;
+    *state               = (WorldGenState){0};
+    state->seed64        = 0x12345678ABCDEF01ull;
+    state->cfg           = WORLDGEN_DEFAULT_PARAMS;
+    state->nextVillageId = 1;
+}
+
+
+void worldgen_seed(WorldGenState* state, uint64_t seed)
 {
-    g_seed64 = seed ? seed : 0xDEADBEEFCAFEBEEFull;
+    if (!state)
+        return;
+    state->seed64        = seed ? seed : 0xDEADBEEFCAFEBEEFull;
+    state->nextVillageId = 1;
 }
-void worldgen_config(const WorldGenParams* params)
+void worldgen_config(WorldGenState* state, const WorldGenParams* params)
 {
-    if (params)
-        g_cfg = *params;
+    if (params && state)
+        state->cfg = *params;
 }
 
 // ----------------------------------------------------------------------------------
@@ -206,18 +211,21 @@ typedef struct Climate
     float* height;      // [H*W], normalized [0..1]
 } Climate;
 
-static void climate_build(Climate* c, int W, int H, uint64_t seed)
+typedef struct ClimateJob
 {
-    (void)seed;
-    c->temperature = (float*)malloc((size_t)W * H * sizeof(float));
-    c->humidity    = (float*)malloc((size_t)W * H * sizeof(float));
-    c->height      = (float*)malloc((size_t)W * H * sizeof(float));
+    Climate* climate;
+    int      width;
+    int      height;
+} ClimateJob;
 
-    // Coherent fBm; temperature has a latitudinal gradient (colder north, warmer south)
-#if defined(WORLDGEN_USE_OPENMP)
-#pragma omp parallel for
-#endif
-    for (int y = 0; y < H; ++y)
+static void climate_build_rows(void* user, int rowBegin, int rowEnd)
+{
+    const ClimateJob* job = (const ClimateJob*)user;
+    Climate*          c   = job->climate;
+    const int         W   = job->width;
+    const int         H   = job->height;
+
+    for (int y = rowBegin; y < rowEnd; ++y)
     {
         float lat = (float)y / (float)H; // 0 north → 1 south
         for (int x = 0; x < W; ++x)
@@ -237,6 +245,18 @@ static void climate_build(Climate* c, int W, int H, uint64_t seed)
     }
 }
 
+static void climate_build(Climate* c, int W, int H, uint64_t seed)
+{
+    (void)seed;
+    c->temperature = (float*)malloc((size_t)W * H * sizeof(float));
+    c->humidity    = (float*)malloc((size_t)W * H * sizeof(float));
+    c->height      = (float*)malloc((size_t)W * H * sizeof(float));
+
+    // Coherent fBm; temperature has a latitudinal gradient (colder north, warmer south)
+    ClimateJob job = {c, W, H};
+    jobs_parallel_for(H, 8, climate_build_rows, &job);
+}
+
 // Free allocated maps
 static void climate_free(Climate* c)
 {
@@ -505,19 +525,6 @@ static int spawn_biome_centers(BiomeCenter* out, int maxN, int W, int H, int min
     return n;
 }
 
-// ----------------------------------------------------------------------------------
-// Object placement helper
-// ----------------------------------------------------------------------------------
-static void maybe_place_object(Map* map, int x, int y, ObjectTypeID oid, float prob, uint64_t* rs)
-{
-    if (!in_bounds(x, y, map->width, map->height))
-        return;
-    if (map->objects[y][x] != NULL)
-        return;
-    if (rng01(rs) < prob)
-        map_place_object(map, oid, x, y);
-}
-
 // ----------------------------------------------------------------------------------
 // Terrain-aware lakes (water in basins, lava in hot/dry or hellish areas)
 // ----------------------------------------------------------------------------------
@@ -730,8 +737,8 @@ static void generate_lakes(Map* map, const Climate* C, uint64_t* rng)
                     if (gx < 0 || gx >= W)
                         continue;
 
-                    map->tiles[gy][gx]   = fill;
-                    map->objects[gy][gx] = NULL;
+                    map->tiles[gy][gx] = fill;
+                    map_remove_object(map, gx, gy);
                 }
             }
         }
@@ -752,8 +759,8 @@ static void generate_lakes(Map* map, const Climate* C, uint64_t* rng)
                     float dy = (float)(y - cy) / (float)ry;
                     if (dx * dx + dy * dy <= 1.0f)
                     {
-                        map->tiles[y][x]   = fill;
-                        map->objects[y][x] = NULL;
+                        map->tiles[y][x] = fill;
+                        map_remove_object(map, x, y);
                     }
                 }
             }
@@ -868,17 +875,10 @@ static void spawn_cluster_members(Map* map, const StructureDef* anchor, int base
         }
 
         int toSpawn = minCount;
-        if (maxCount > minCount)
+        if (maxCount > minCount && rng)
         {
-            if (rng)
-            {
-                uint64_t roll = splitmix64_next(rng);
-                toSpawn += (int)(roll % (uint64_t)(maxCount - minCount + 1));
-            }
-            else
-            {
-                toSpawn += rand() % (maxCount - minCount + 1);
-            }
+            uint64_t roll = splitmix64_next(rng);
+            toSpawn += (int)(roll % (uint64_t)(maxCount - minCount + 1));
         }
 
         plannedCounts[m] = toSpawn;
@@ -1217,7 +1217,7 @@ static void structure_clear_objects(Map* map, int startX, int startY, int width,
         {
             if (x < 0 || x >= W)
                 continue;
-            if (map->objects[y][x])
+            if (map_has_object(map, x, y))
                 map_remove_object(map, x, y);
         }
     }
@@ -1298,8 +1298,8 @@ static bool find_structure_door(const Map* map, int startX, int startY, int widt
         {
             if (!in_bounds(x, y, map->width, map->height))
                 continue;
-            Object* obj = map->objects[y][x];
-            if (obj && obj->type && obj->type->isDoor)
+            const ObjectType* obj = map_object_type_at(map, x, y);
+            if (obj && obj->isDoor)
             {
                 foundX = x;
                 foundY = y;
@@ -1410,12 +1410,12 @@ static void apply_road_step(Map* map, int x, int y, const PlacedStructure* place
     if (occupant && !(x == occupant->doorX && y == occupant->doorY))
         return;
 
-    Object* obj = map->objects[y][x];
-    if (obj && obj->type)
+    const ObjectType* obj = map_object_type_at(map, x, y);
+    if (obj)
     {
-        if (obj->type->isWall)
+        if (obj->isWall)
             return;
-        if (!obj->type->isDoor)
+        if (!obj->isDoor)
             map_remove_object(map, x, y);
     }
 
@@ -1889,7 +1889,7 @@ static bool worldgen_place_structure(Map* map, const StructureDef* def, int star
         return false;
 
     structure_clear_objects(map, startX, startY, width, height);
-    def->build(map, startX, startY, g_worldgenRng);
+    def->build(map, startX, startY, map->worldgen.rng);
 
     int doorX = -1;
     int doorY = -1;
@@ -1897,12 +1897,12 @@ static bool worldgen_place_structure(Map* map, const StructureDef* def, int star
     if (doorX >= 0 && doorY >= 0)
         compute_door_exit(map, doorX, doorY, &doorX, &doorY);
 
-    if (g_worldgenStructureCounts)
-        g_worldgenStructureCounts[def->kind]++;
+    if (map->worldgen.structureCounts)
+        map->worldgen.structureCounts[def->kind]++;
 
-    if (g_worldgenPlaced && g_worldgenPlacedCount && *g_worldgenPlacedCount < g_worldgenPlacedCap)
+    if (map->worldgen.placed && map->worldgen.placedCount && *map->worldgen.placedCount < map->worldgen.placedCap)
     {
-        PlacedStructure* ps = &g_worldgenPlaced[*g_worldgenPlacedCount];
+        PlacedStructure* ps = &map->worldgen.placed[*map->worldgen.placedCount];
         ps->x               = startX + width / 2;
         ps->y               = startY + height / 2;
         ps->kind            = def->kind;
@@ -1914,7 +1914,7 @@ static bool worldgen_place_structure(Map* map, const StructureDef* def, int star
         ps->boundsH         = height;
         ps->speciesId       = 0;
         ps->villageId       = -1;
-        (*g_worldgenPlacedCount)++;
+        (*map->worldgen.placedCount)++;
     }
 
     return true;
@@ -1945,7 +1945,7 @@ static bool worldgen_plan_structure(Map* map, const StructureDef* def, int ancho
     int startX = clampi(anchorX - width / 2, 2, map->width - width - 2);
     int startY = clampi(anchorY - height / 2, 2, map->height - height - 2);
 
-    if (bounds_overlap_existing(startX, startY, width, height, g_worldgenPlaced, g_worldgenPlacedCount ? *g_worldgenPlacedCount : 0, 2))
+    if (bounds_overlap_existing(startX, startY, width, height, map->worldgen.placed, map->worldgen.placedCount ? *map->worldgen.placedCount : 0, 2))
     {
         VILLAGE_LOG("    plan_structure: overlaps existing at %d,%d kind=%d", startX, startY, def->kind);
         return false;
@@ -2011,7 +2011,7 @@ static bool village_plan_with_jitter(Map* map,
 
     if (dirLen < 0.25f)
     {
-        float angle = random01(g_worldgenRng) * TWO_PI;
+        float angle = random01(map->worldgen.rng) * TWO_PI;
         dirX        = cosf(angle);
         dirY        = sinf(angle);
         dirLen      = 1.0f;
@@ -2037,8 +2037,8 @@ static bool village_plan_with_jitter(Map* map,
 
         if (jitterR > 0)
         {
-            testX += random_offset(g_worldgenRng, jitterR);
-            testY += random_offset(g_worldgenRng, jitterR);
+            testX += random_offset(map->worldgen.rng, jitterR);
+            testY += random_offset(map->worldgen.rng, jitterR);
         }
 
         if (worldgen_plan_structure(map, def, testX, testY, planned, plannedCount, maxPlanned))
@@ -2052,7 +2052,7 @@ static bool village_plan_with_jitter(Map* map,
     for (int sweep = 0; sweep < 16; ++sweep)
     {
         float radial = baseReach + halfDiag + 3.0f + 1.5f * (float)sweep;
-        float angle  = random01(g_worldgenRng) * TWO_PI;
+        float angle  = random01(map->worldgen.rng) * TWO_PI;
         int   testX  = centerX + (int)roundf(cosf(angle) * radial);
         int   testY  = centerY + (int)roundf(sinf(angle) * radial);
 
@@ -2074,9 +2074,9 @@ static bool village_plan_and_place(Map* map, const VillageTemplate* templateDef,
 
     VILLAGE_LOG("  plan_and_place speciesId=%d center=(%d,%d)", speciesId, centerX, centerY);
 
-    if (g_worldgenPlaced && g_worldgenPlacedCount)
+    if (map->worldgen.placed && map->worldgen.placedCount)
     {
-        if (!structure_spacing_ok((float)centerX, (float)centerY, g_worldgenPlaced, *g_worldgenPlacedCount, templateDef->minSpacing))
+        if (!structure_spacing_ok((float)centerX, (float)centerY, map->worldgen.placed, *map->worldgen.placedCount, templateDef->minSpacing))
         {
             VILLAGE_LOG("    spacing check failed at center");
             return false;
@@ -2106,7 +2106,7 @@ static bool village_plan_and_place(Map* map, const VillageTemplate* templateDef,
         int count = minCount;
         if (maxCount > minCount)
         {
-            float roll = random01(g_worldgenRng);
+            float roll = random01(map->worldgen.rng);
             count      = minCount + (int)(roll * (float)(maxCount - minCount + 1));
         }
 
@@ -2141,12 +2141,12 @@ static bool village_plan_and_place(Map* map, const VillageTemplate* templateDef,
             else
                 angleDeg = startDeg + step * ((float)i + 0.5f);
 
-            float jitterDeg = slot->angleJitterDeg > 0.0f ? slot->angleJitterDeg * (random01(g_worldgenRng) * 2.0f - 1.0f) : 0.0f;
+            float jitterDeg = slot->angleJitterDeg > 0.0f ? slot->angleJitterDeg * (random01(map->worldgen.rng) * 2.0f - 1.0f) : 0.0f;
             float angleRad  = (angleDeg + jitterDeg) * (PI / 180.0f);
 
             float radius = radiusMin;
             if (radiusMax > radiusMin)
-                radius = radiusMin + random01(g_worldgenRng) * (radiusMax - radiusMin);
+                radius = radiusMin + random01(map->worldgen.rng) * (radiusMax - radiusMin);
 
             int anchorX = centerX + (int)roundf(cosf(angleRad) * radius);
             int anchorY = centerY + (int)roundf(sinf(angleRad) * radius);
@@ -2165,12 +2165,12 @@ static bool village_plan_and_place(Map* map, const VillageTemplate* templateDef,
         return false;
     }
 
-    int  villageId   = g_nextVillageId++;
+    int  villageId   = map->worldgen.nextVillageId++;
     bool placementOk = true;
 
     for (int i = 0; i < plannedCount && placementOk; ++i)
     {
-        int before = (g_worldgenPlaced && g_worldgenPlacedCount) ? *g_worldgenPlacedCount : 0;
+        int before = (map->worldgen.placed && map->worldgen.placedCount) ? *map->worldgen.placedCount : 0;
         if (!worldgen_place_structure(map, planned[i].def, planned[i].startX, planned[i].startY))
         {
             int loggedKind = planned[i].def ? (int)planned[i].def->kind : -1;
@@ -2187,9 +2187,9 @@ static bool village_plan_and_place(Map* map, const VillageTemplate* templateDef,
         };
         register_building_with_metadata(map, bounds, planned[i].def->kind, speciesId, villageId);
 
-        if (g_worldgenPlaced && g_worldgenPlacedCount && before < *g_worldgenPlacedCount)
+        if (map->worldgen.placed && map->worldgen.placedCount && before < *map->worldgen.placedCount)
         {
-            PlacedStructure* ps = &g_worldgenPlaced[before];
+            PlacedStructure* ps = &map->worldgen.placed[before];
             ps->speciesId       = speciesId;
             ps->villageId       = villageId;
         }
@@ -2238,8 +2238,8 @@ void world_generate_village(const char* species, const VillageTemplate* template
 
         for (int attempt = 0; attempt < 80 && !placedVillage; ++attempt)
         {
-            int centerX = margin + (int)(random01(g_worldgenRng) * (float)(map->width - margin * 2));
-            int centerY = margin + (int)(random01(g_worldgenRng) * (float)(map->height - margin * 2));
+            int centerX = margin + (int)(random01(map->worldgen.rng) * (float)(map->width - margin * 2));
+            int centerY = margin + (int)(random01(map->worldgen.rng) * (float)(map->height - margin * 2));
 
             bool  coverageValid = false;
             float coverage      = village_tile_coverage(map, centerX, centerY, templateDef->surveyRadius, templateDef->requiredTile, &coverageValid);
@@ -2247,9 +2247,9 @@ void world_generate_village(const char* species, const VillageTemplate* template
             if (!coverageValid)
                 continue;
 
-            if (g_worldgenPlaced && g_worldgenPlacedCount)
+            if (map->worldgen.placed && map->worldgen.placedCount)
             {
-                if (!structure_spacing_ok((float)centerX, (float)centerY, g_worldgenPlaced, *g_worldgenPlacedCount, templateDef->minSpacing))
+                if (!structure_spacing_ok((float)centerX, (float)centerY, map->worldgen.placed, *map->worldgen.placedCount, templateDef->minSpacing))
                 {
                     continue;
                 }
@@ -2304,9 +2304,9 @@ void world_generate_village(const char* species, const VillageTemplate* template
                     if (!coverageValid)
                         continue;
 
-                    if (g_worldgenPlaced && g_worldgenPlacedCount)
+                    if (map->worldgen.placed && map->worldgen.placedCount)
                     {
-                        if (!structure_spacing_ok((float)sx, (float)sy, g_worldgenPlaced, *g_worldgenPlacedCount, templateDef->minSpacing))
+                        if (!structure_spacing_ok((float)sx, (float)sy, map->worldgen.placed, *map->worldgen.placedCount, templateDef->minSpacing))
                             continue;
                     }
 
@@ -2351,8 +2351,8 @@ void world_generate_village(const char* species, const VillageTemplate* template
             VILLAGE_LOG(" !! failed to place village #%d", v);
     }
 
-    if (templateDef->connectRoads && g_worldgenPlaced && g_worldgenPlacedCount)
-        connect_village_structures(templateDef, speciesId, map, g_worldgenPlaced, *g_worldgenPlacedCount);
+    if (templateDef->connectRoads && map->worldgen.placed && map->worldgen.placedCount)
+        connect_village_structures(templateDef, speciesId, map, map->worldgen.placed, *map->worldgen.placedCount);
 }
 
 static bool place_cluster_member_instance(Map* map, const StructureDef* def, float anchorCenterX, float anchorCenterY, float halfWidth, float halfHeight, uint64_t* rng, PlacedStructure* placed, int* placedCount,
@@ -2409,7 +2409,7 @@ static bool attempt_spawn_structure(Map* map, const StructureDef* def, int ancho
     if (maxX < minX || maxY < minY)
         return false;
 
-    float baseSpacing = (float)g_cfg.structure_min_spacing;
+    float baseSpacing = (float)map->worldgen.cfg.structure_min_spacing;
     if (baseSpacing <= 0.0f)
         baseSpacing = (float)(widthMax + heightMax);
 
@@ -2570,76 +2570,71 @@ static void pick_two_centers_from_neighbors(int* outBest1, int* outBest2, int x,
 }
 
 // ----------------------------------------------------------------------------------
-// Main generation
+// Parallel generation passes (run through the job system)
 // ----------------------------------------------------------------------------------
-void generate_world(Map* map)
+typedef struct MacroCellJob
 {
-    if (!map)
-        return;
-    const int W = map->width, H = map->height;
-
-    load_structure_metadata("data/structures.stv");
-    load_biome_definitions("data/biomes.stv");
-    // 1) Build climate maps (coherent drivers)
-    Climate C = {0};
-    climate_build(&C, W, H, g_seed64);
-
-    // 2) Spawn biome centers (Poisson-like) using climate & config
-    const int   MAXC = 1024;
-    BiomeCenter centers[MAXC];
-    uint64_t    rs   = g_seed64;
-    int         minR = g_cfg.min_biome_radius;
-    int         nC   = spawn_biome_centers(centers, MAXC, W, H, minR, &rs, &C);
-    printf("=== Spawned %d biome centers ===\n", nC);
-    for (int i = 0; i < nC; i++)
-    {
-        const BiomeCenter* c = &centers[i];
-        printf("[%3d] %s  pos=(%3d,%3d)\n", i, biome_kind_to_string(c->kind), c->x, c->y);
-    }
-
-    // 3) Macro-cell Voronoi assignment (fast). Each macro-cell selects its nearest center,
-    //    then we fill tiles in the cell from that result. This avoids O(W*H*nC).
-    const int MC     = 16; // macro-cell size in tiles; tweak 8..32 for quality vs speed
-    const int cellsX = (W + MC - 1) / MC;
-    const int cellsY = (H + MC - 1) / MC;
-
-    // Precompute nearest center per macro-cell
-    int* cellCenterIdx = (int*)malloc((size_t)cellsX * cellsY * sizeof(int));
+    const BiomeCenter* centers;
+    int                centerCount;
+    int                cellSize;
+    int                width;
+    int                height;
+    int                cellsX;
+    int*               cellCenterIdx;
+} MacroCellJob;
+
+static void macro_cells_assign(void* user, int begin, int end)
+{
+    const MacroCellJob* job = (const MacroCellJob*)user;
+    const int           MC  = job->cellSize;
 
-// Parallelizable loop (optional OpenMP)
-#if defined(WORLDGEN_USE_OPENMP)
-#pragma omp parallel for collapse(2)
-#endif
-    for (int cy = 0; cy < cellsY; ++cy)
+    for (int i = begin; i < end; ++i)
     {
-        for (int cx = 0; cx < cellsX; ++cx)
-        {
-            int x = cx * MC + MC / 2;
-            int y = cy * MC + MC / 2;
-            if (x >= W)
-                x = W - 1;
-            if (y >= H)
-                y = H - 1;
-
-            float wx = x + (fbm2D(x, y, 2, 2.0f, 0.5f, 0.01f, 4242u) - 0.5f) * 40.0f;
-            float wy = y + (fbm2D(x + 1000, y - 1000, 2, 2.0f, 0.5f, 0.01f, 4242u) - 0.5f) * 40.0f;
+        int cx = i % job->cellsX;
+        int cy = i / job->cellsX;
+        int x  = cx * MC + MC / 2;
+        int y  = cy * MC + MC / 2;
+        if (x >= job->width)
+            x = job->width - 1;
+        if (y >= job->height)
+            y = job->height - 1;
 
-            int ci = nearest_center(centers, nC, (int)wx, (int)wy);
+        float wx = x + (fbm2D(x, y, 2, 2.0f, 0.5f, 0.01f, 4242u) - 0.5f) * 40.0f;
+        float wy = y + (fbm2D(x + 1000, y - 1000, 2, 2.0f, 0.5f, 0.01f, 4242u) - 0.5f) * 40.0f;
 
-            // int ci                          = nearest_center(centers, nC, x, y);
-            cellCenterIdx[cy * cellsX + cx] = ci;
-        }
+        job->cellCenterIdx[i] = nearest_center(job->centers, job->centerCount, (int)wx, (int)wy);
     }
+}
+
+typedef struct TilePaintJob
+{
+    Map*               map;
+    const Climate*     climate;
+    const BiomeCenter* centers;
+    const int*         cellCenterIdx;
+    int                cellSize;
+    int                cellsX;
+    int                cellsY;
+} TilePaintJob;
+
+static void paint_tile_rows(void* user, int rowBegin, int rowEnd)
+{
+    const TilePaintJob* job           = (const TilePaintJob*)user;
+    Map*                map           = job->map;
+    const Climate*      C             = job->climate;
+    const BiomeCenter*  centers       = job->centers;
+    const int*          cellCenterIdx = job->cellCenterIdx;
+    const int           MC            = job->cellSize;
+    const int           cellsX        = job->cellsX;
+    const int           cellsY        = job->cellsY;
+    const int           W             = map->width;
+    const int           H             = map->height;
 
-    // 4) Paint tiles with soft biome blending and organic micro-variation
     const float warpFreq   = 0.004f; // cross-biome warping
     const float featherMin = 0.30f;  // inner blend edge
     const float featherMax = 0.70f;  // outer blend edge
 
-#if defined(WORLDGEN_USE_OPENMP)
-#pragma omp parallel for
-#endif
-    for (int y = 0; y < H; ++y)
+    for (int y = rowBegin; y < rowEnd; ++y)
     {
         const int cy = y / MC;
         for (int x = 0; x < W; ++x)
@@ -2647,17 +2642,17 @@ void generate_world(Map* map)
             const int cx = x / MC;
 
             // Continents & extremes via height
-            float h = C.height[y * W + x];
+            float h = C->height[y * W + x];
             if (h < 0.06f)
             {
-                map->tiles[y][x]   = TILE_WATER;
-                map->objects[y][x] = NULL;
+                map->tiles[y][x]       = TILE_WATER;
+                map->objectCells[y][x] = (ObjectCell){0};
                 continue;
             }
             if (h > 0.97f)
             {
-                map->tiles[y][x]   = TILE_LAVA;
-                map->objects[y][x] = NULL;
+                map->tiles[y][x]       = TILE_LAVA;
+                map->objectCells[y][x] = (ObjectCell){0};
                 continue;
             }
 
@@ -2744,8 +2739,8 @@ void generate_world(Map* map)
             else if (mix > 1.0f)
                 mix = 1.0f;
 
-            map->tiles[y][x]   = (mix < 0.5f) ? tileA : tileB;
-            map->objects[y][x] = NULL;
+            map->tiles[y][x]       = (mix < 0.5f) ? tileA : tileB;
+            map->objectCells[y][x] = (ObjectCell){0};
 
 #if 0 // optional debug sample output
         if (x % 50 == 0 && y % 50 == 0)
@@ -2758,13 +2753,43 @@ void generate_world(Map* map)
         }
     }
 
-// 5) Decor pass — probabilities modulated by climate & biome profile
-//    (separate loop helps cache; also easier to tune)
-#if defined(WORLDGEN_USE_OPENMP)
-#pragma omp parallel for
-#endif
-    for (int y = 0; y < H; ++y)
-    {
+}
+
+typedef struct DecorJob
+{
+    const Map*         map;
+    const Climate*     climate;
+    const BiomeCenter* centers;
+    const int*         cellCenterIdx;
+    int                cellSize;
+    int                cellsX;
+    uint64_t           seed;
+    ObjectTypeID*      out; /**< [H*W] object chosen per tile (OBJ_NONE if empty). */
+} DecorJob;
+
+/** Rolls one decor candidate for a tile, keeping the first object chosen there. */
+static void decor_pick(ObjectTypeID* cell, ObjectTypeID oid, float prob, uint64_t* rs)
+{
+    if (*cell != OBJ_NONE)
+        return;
+    if (rng01(rs) < prob)
+        *cell = oid;
+}
+
+static void decor_pick_rows(void* user, int rowBegin, int rowEnd)
+{
+    const DecorJob*    job           = (const DecorJob*)user;
+    const Map*         map           = job->map;
+    const Climate*     C             = job->climate;
+    const BiomeCenter* centers       = job->centers;
+    const int*         cellCenterIdx = job->cellCenterIdx;
+    const int          MC            = job->cellSize;
+    const int          cellsX        = job->cellsX;
+    const int          W             = map->width;
+
+    for (int y = rowBegin; y < rowEnd; ++y)
+    {
+        uint64_t rowRng = job->seed ^ ((uint64_t)(y + 1) * 0xD1B54A32D192ED03ull);
         for (int x = 0; x < W; ++x)
         {
             // Skip liquids/hazard hard-tiles
@@ -2776,11 +2801,11 @@ void generate_world(Map* map)
             const BiomeDef* bp = get_biome_def(centers[ci].kind);
 
             // Climate influence
-            float temp = C.temperature[y * W + x];
-            float hum  = C.humidity[y * W + x];
-            float h    = C.height[y * W + x];
+            float temp = C->temperature[y * W + x];
+            float hum  = C->humidity[y * W + x];
+            float h    = C->height[y * W + x];
             (void)temp;
-            float fd = g_cfg.feature_density;
+            float fd = map->worldgen.cfg.feature_density;
 
             // Trees prefer wet & lower alt (avoid deserts, peaks)
             float treeProb = fd * bp->treeMul * (0.2f + hum * 1.2f) * (h < 0.8f ? 1.0f : 0.3f);
@@ -2796,32 +2821,32 @@ void generate_world(Map* map)
             {
                 case BIO_FOREST:
                 case BIO_SWAMP:
-                    maybe_place_object(map, x, y, OBJ_TREE, treeProb, &rs);
-                    maybe_place_object(map, x, y, OBJ_STDBUSH, bushProb, &rs);
+                    decor_pick(&job->out[y * W + x], OBJ_TREE, treeProb, &rowRng);
+                    decor_pick(&job->out[y * W + x], OBJ_STDBUSH, bushProb, &rowRng);
                     break;
                 case BIO_PLAIN:
-                    maybe_place_object(map, x, y, OBJ_STDBUSH, bushProb * 0.6f, &rs);
+                    decor_pick(&job->out[y * W + x], OBJ_STDBUSH, bushProb * 0.6f, &rowRng);
                     break;
                 case BIO_SAVANNA:
-                    maybe_place_object(map, x, y, OBJ_STDBUSH_DRY, bushProb * 1.1f, &rs);
-                    maybe_place_object(map, x, y, OBJ_ROCK, rockProb * 0.6f, &rs);
+                    decor_pick(&job->out[y * W + x], OBJ_STDBUSH_DRY, bushProb * 1.1f, &rowRng);
+                    decor_pick(&job->out[y * W + x], OBJ_ROCK, rockProb * 0.6f, &rowRng);
                     break;
                 case BIO_TUNDRA:
-                    maybe_place_object(map, x, y, OBJ_DEAD_TREE, treeProb * 0.6f, &rs);
-                    maybe_place_object(map, x, y, OBJ_ROCK, rockProb * 0.8f, &rs);
+                    decor_pick(&job->out[y * W + x], OBJ_DEAD_TREE, treeProb * 0.6f, &rowRng);
+                    decor_pick(&job->out[y * W + x], OBJ_ROCK, rockProb * 0.8f, &rowRng);
                     break;
                 case BIO_DESERT:
-                    maybe_place_object(map, x, y, OBJ_ROCK, rockProb * 1.2f, &rs);
+                    decor_pick(&job->out[y * W + x], OBJ_ROCK, rockProb * 1.2f, &rowRng);
                     break;
                 case BIO_MOUNTAIN:
-                    maybe_place_object(map, x, y, OBJ_ROCK, rockProb * 1.5f, &rs);
+                    decor_pick(&job->out[y * W + x], OBJ_ROCK, rockProb * 1.5f, &rowRng);
                     break;
                 case BIO_CURSED:
-                    maybe_place_object(map, x, y, OBJ_DEAD_TREE, treeProb * 1.0f, &rs);
-                    maybe_place_object(map, x, y, OBJ_BONE_PILE, fd * 0.08f, &rs);
+                    decor_pick(&job->out[y * W + x], OBJ_DEAD_TREE, treeProb * 1.0f, &rowRng);
+                    decor_pick(&job->out[y * W + x], OBJ_BONE_PILE, fd * 0.08f, &rowRng);
                     break;
                 case BIO_HELL:
-                    maybe_place_object(map, x, y, OBJ_SULFUR_VENT, fd * 0.05f, &rs);
+                    decor_pick(&job->out[y * W + x], OBJ_SULFUR_VENT, fd * 0.05f, &rowRng);
                     break;
                 case BIO_MAX:
                     break;
@@ -2829,6 +2854,78 @@ void generate_world(Map* map)
         }
     }
 
+}
+
+// ----------------------------------------------------------------------------------
+// Main generation
+// ----------------------------------------------------------------------------------
+void generate_world(Map* map)
+{
+    if (!map)
+    {
+        printf("❌ generate_world needs a map\n");
+        return;
+    }
+    const int W = map->width, H = map->height;
+
+    StructureSamplers* samplers = structure_samplers_create();
+    // 1) Build climate maps (coherent drivers)
+    Climate C = {0};
+    climate_build(&C, W, H, map->worldgen.seed64);
+
+    // 2) Spawn biome centers (Poisson-like) using climate & config
+    const int   MAXC = 1024;
+    BiomeCenter centers[MAXC];
+    uint64_t    rs   = map->worldgen.seed64;
+    int         minR = map->worldgen.cfg.min_biome_radius;
+    int         nC   = spawn_biome_centers(centers, MAXC, W, H, minR, &rs, &C);
+    printf("=== Spawned %d biome centers ===\n", nC);
+    for (int i = 0; i < nC; i++)
+    {
+        const BiomeCenter* c = &centers[i];
+        printf("[%3d] %s  pos=(%3d,%3d)\n", i, biome_kind_to_string(c->kind), c->x, c->y);
+    }
+
+    // 3) Macro-cell Voronoi assignment (fast). Each macro-cell selects its nearest center,
+    //    then we fill tiles in the cell from that result. This avoids O(W*H*nC).
+    const int MC     = 16; // macro-cell size in tiles; tweak 8..32 for quality vs speed
+    const int cellsX = (W + MC - 1) / MC;
+    const int cellsY = (H + MC - 1) / MC;
+
+    // Precompute nearest center per macro-cell
+    int* cellCenterIdx = (int*)malloc((size_t)cellsX * cellsY * sizeof(int));
+
+    MacroCellJob cellJob = {centers, nC, MC, W, H, cellsX, cellCenterIdx};
+    jobs_parallel_for(cellsX * cellsY, 16, macro_cells_assign, &cellJob);
+
+    // 4) Paint tiles with soft biome blending and organic micro-variation
+    TilePaintJob paintJob = {map, &C, centers, cellCenterIdx, MC, cellsX, cellsY};
+    jobs_parallel_for(H, 4, paint_tile_rows, &paintJob);
+
+// 5) Decor pass — probabilities modulated by climate & biome profile
+//    (separate loop helps cache; also easier to tune)
+//    Each row draws from its own stream derived from a single seed so the
+//    result does not depend on how rows are split across threads. Rows only
+//    decide what goes where; objects are created serially afterwards because
+//    object creation touches shared lists.
+    const uint64_t decorSeed = splitmix64_next(&rs);
+    ObjectTypeID*  decor     = (ObjectTypeID*)calloc((size_t)W * H, sizeof(ObjectTypeID));
+    if (decor)
+    {
+        DecorJob decorJob = {map, &C, centers, cellCenterIdx, MC, cellsX, decorSeed, decor};
+        jobs_parallel_for(H, 4, decor_pick_rows, &decorJob);
+        for (int y = 0; y < H; ++y)
+        {
+            for (int x = 0; x < W; ++x)
+            {
+                ObjectTypeID oid = decor[y * W + x];
+                if (oid != OBJ_NONE && !map_has_object(map, x, y))
+                    map_place_object(map, oid, x, y);
+            }
+        }
+        free(decor);
+    }
+
     // 6) Lakes after base terrain to carve coherent patches (terrain-aware)
     generate_lakes(map, &C, &rs);
 
@@ -2852,40 +2949,40 @@ void generate_world(Map* map)
             switch (kind)
             {
                 case BIO_FOREST:
-                    biomeMult = g_cfg.biome_struct_mult_forest;
+                    biomeMult = map->worldgen.cfg.biome_struct_mult_forest;
                     break;
                 case BIO_PLAIN:
-                    biomeMult = g_cfg.biome_struct_mult_plain;
+                    biomeMult = map->worldgen.cfg.biome_struct_mult_plain;
                     break;
                 case BIO_SAVANNA:
-                    biomeMult = g_cfg.biome_struct_mult_savanna;
+                    biomeMult = map->worldgen.cfg.biome_struct_mult_savanna;
                     break;
                 case BIO_TUNDRA:
-                    biomeMult = g_cfg.biome_struct_mult_tundra;
+                    biomeMult = map->worldgen.cfg.biome_struct_mult_tundra;
                     break;
                 case BIO_DESERT:
-                    biomeMult = g_cfg.biome_struct_mult_desert;
+                    biomeMult = map->worldgen.cfg.biome_struct_mult_desert;
                     break;
                 case BIO_SWAMP:
-                    biomeMult = g_cfg.biome_struct_mult_swamp;
+                    biomeMult = map->worldgen.cfg.biome_struct_mult_swamp;
                     break;
                 case BIO_MOUNTAIN:
-                    biomeMult = g_cfg.biome_struct_mult_mountain;
+                    biomeMult = map->worldgen.cfg.biome_struct_mult_mountain;
                     break;
                 case BIO_CURSED:
-                    biomeMult = g_cfg.biome_struct_mult_cursed;
+                    biomeMult = map->worldgen.cfg.biome_struct_mult_cursed;
                     break;
                 case BIO_HELL:
-                    biomeMult = g_cfg.biome_struct_mult_hell;
+                    biomeMult = map->worldgen.cfg.biome_struct_mult_hell;
                     break;
                 case BIO_MAX:
                     break;
             }
 
-            float finalChance = g_cfg.structure_chance * biomeMult;
+            float finalChance = map->worldgen.cfg.structure_chance * biomeMult;
             if (rng01(&rs) < finalChance)
             {
-                const StructureDef* def = pick_structure_for_biome(kind, &rs, structureCounts);
+                const StructureDef* def = pick_structure_for_biome(samplers, kind, &rs, structureCounts);
                 if (def)
                 {
                     if (structure_reserved_for_villages(def->kind))
@@ -2968,21 +3065,25 @@ void generate_world(Map* map)
         }
     }
 
-    g_worldgenPlaced          = placed;
-    g_worldgenPlacedCount     = &placedCount;
-    g_worldgenPlacedCap       = placedCap;
-    g_worldgenStructureCounts = structureCounts;
-    g_worldgenRng             = &rs;
+    map->worldgen.placed          = placed;
+    map->worldgen.placedCount     = &placedCount;
+    map->worldgen.placedCap       = placedCap;
+    map->worldgen.structureCounts = structureCounts;
+    map->worldgen.rng             = &rs;
 
     world_generate_village("cannibal", &CANNIBAL_VILLAGE_TEMPLATE, map);
 
-    g_worldgenPlaced          = NULL;
-    g_worldgenPlacedCount     = NULL;
-    g_worldgenPlacedCap       = 0;
-    g_worldgenStructureCounts = NULL;
-    g_worldgenRng             = NULL;
+    map->worldgen.placed          = NULL;
+    map->worldgen.placedCount     = NULL;
+    map->worldgen.placedCap       = 0;
+    map->worldgen.structureCounts = NULL;
+    map->worldgen.rng             = NULL;
+
+    // Keep the climate drivers as per-tile layers before releasing the float maps.
+    climate_field_capture(map, C.temperature, C.humidity, C.height, W, H);
 
     // Cleanup
+    structure_samplers_destroy(samplers);
     free(cellCenterIdx);
     climate_free(&C);
 }
@@ -15,6 +15,8 @@
 #include <strings.h>
 #include "world_chunk.h"
 #include "biome_loader.h"
+#include "alias_table.h"
+#include "counter_rng.h"
 
 static void trim_inplace(char* s)
 {
@@ -382,8 +384,25 @@ static BiomeKind parse_biome_token(const char* token, bool* outIsWildcard)
     return BIO_MAX;
 }
 
+/** Next 64 bits of the worldgen splitmix64 stream. */
+static uint64_t worldgen_draw(uint64_t* rng)
+{
+    return counter_rng_mix(*rng += 0x9E3779B97F4A7C15ull);
+}
+
+// Builders draw from the world's stream, never from the process-wide rand().
+static int structure_rand(uint64_t* rng, int n)
+{
+    return (rng && n > 0) ? (int)(worldgen_draw(rng) % (uint64_t)n) : 0;
+}
+
+static float structure_rand01(uint64_t* rng)
+{
+    return rng ? (float)(worldgen_draw(rng) >> 40) * (1.0f / 16777216.0f) : 0.0f;
+}
+
 // --- helper murs/porte rectangle ---
-static void rect_walls(Map* map, int x, int y, int w, int h, ObjectTypeID wall, ObjectTypeID door)
+static void rect_walls(Map* map, int x, int y, int w, int h, ObjectTypeID wall, ObjectTypeID door, uint64_t* rng)
 {
     (void)door;
 
@@ -400,9 +419,9 @@ static void rect_walls(Map* map, int x, int y, int w, int h, ObjectTypeID wall,
     }
 
     // Porte sur un côté aléatoire
-    int side = rand() % 4;
-    int px   = x + 1 + rand() % (w - 2);
-    int py   = y + 1 + rand() % (h - 2);
+    int side = structure_rand(rng, 4);
+    int px   = x + 1 + structure_rand(rng, w - 2);
+    int py   = y + 1 + structure_rand(rng, h - 2);
     if (side == 0)
         py = y;
     else if (side == 1)
@@ -438,11 +457,10 @@ static void fill_tiles(Map* map, int startX, int startY, int width, int height,
 
 void build_hut_cannibal(Map* map, int x, int y, uint64_t* rng)
 {
-    int w = 4 + rand() % 3; // 4..6
-    int h = 4 + rand() % 3;
+    int w = 4 + structure_rand(rng, 3); // 4..6
+    int h = 4 + structure_rand(rng, 3);
 
-    (void)rng;
-    rect_walls(map, x, y, w, h, OBJ_WALL_WOOD, OBJ_DOOR_WOOD);
+    rect_walls(map, x, y, w, h, OBJ_WALL_WOOD, OBJ_DOOR_WOOD, rng);
     fill_tiles(map, x + 1, y + 1, w - 2, h - 2, TILE_STRAW_FLOOR);
 
     int innerX0 = x + 1;
@@ -469,7 +487,7 @@ void build_hut_cannibal(Map* map, int x, int y, uint64_t* rng)
             if ((i == centerX && j == centerY) || (i == crateX && j == crateY) || (i == boneX && j == boneY))
                 continue;
 
-            float r = (float)rand() / RAND_MAX;
+            float r = structure_rand01(rng);
             if (r < 0.06f)
                 map_place_object(map, OBJ_BONE_PILE, i, j);
             else if (r < 0.10f)
@@ -480,16 +498,15 @@ void build_hut_cannibal(Map* map, int x, int y, uint64_t* rng)
     // Liaison auto au système de rooms (bounds = extérieur des murs)
     Rectangle bounds = {(float)x, (float)y, (float)w, (float)h};
     register_building_from_bounds(map, bounds, STRUCT_HUT_CANNIBAL); // détecte et nomme via classification intégrée
-    // chunkgrid_mark_dirty_rect(gChunks, (Rectangle){(float)x, (float)y, (float)w, (float)h});
+    // chunkgrid_mark_dirty_rect(map->chunks, (Rectangle){(float)x, (float)y, (float)w, (float)h});
 }
 
 void build_cannibal_longhouse(Map* map, int x, int y, uint64_t* rng)
 {
-    int w = 7 + rand() % 2; // 7..8
-    int h = 6 + rand() % 2; // 6..7
+    int w = 7 + structure_rand(rng, 2); // 7..8
+    int h = 6 + structure_rand(rng, 2); // 6..7
 
-    (void)rng;
-    rect_walls(map, x, y, w, h, OBJ_WALL_WOOD, OBJ_DOOR_WOOD);
+    rect_walls(map, x, y, w, h, OBJ_WALL_WOOD, OBJ_DOOR_WOOD, rng);
     fill_tiles(map, x + 1, y + 1, w - 2, h - 2, TILE_WOOD_FLOOR);
 
     int centerX = x + w / 2;
@@ -507,11 +524,10 @@ void build_cannibal_longhouse(Map* map, int x, int y, uint64_t* rng)
 
 void build_cannibal_cook_tent(Map* map, int x, int y, uint64_t* rng)
 {
-    int w = 5 + rand() % 2;
-    int h = 5 + rand() % 2;
+    int w = 5 + structure_rand(rng, 2);
+    int h = 5 + structure_rand(rng, 2);
 
-    (void)rng;
-    rect_walls(map, x, y, w, h, OBJ_WALL_WOOD, OBJ_DOOR_WOOD);
+    rect_walls(map, x, y, w, h, OBJ_WALL_WOOD, OBJ_DOOR_WOOD, rng);
     fill_tiles(map, x + 1, y + 1, w - 2, h - 2, TILE_STONE_FLOOR);
 
     int centerX = x + w / 2;
@@ -521,9 +537,9 @@ void build_cannibal_cook_tent(Map* map, int x, int y, uint64_t* rng)
 
     for (int i = x + 1; i < x + w - 1; ++i)
     {
-        if (rand() % 2)
+        if (structure_rand(rng, 2))
             map_place_object(map, OBJ_MEAT_HOOK, i, y + 1);
-        if (rand() % 2)
+        if (structure_rand(rng, 2))
             map_place_object(map, OBJ_MEAT_HOOK, i, y + h - 2);
     }
 
@@ -533,11 +549,10 @@ void build_cannibal_cook_tent(Map* map, int x, int y, uint64_t* rng)
 
 void build_cannibal_shaman_hut(Map* map, int x, int y, uint64_t* rng)
 {
-    int w = 5 + rand() % 2;
-    int h = 5 + rand() % 2;
+    int w = 5 + structure_rand(rng, 2);
+    int h = 5 + structure_rand(rng, 2);
 
-    (void)rng;
-    rect_walls(map, x, y, w, h, OBJ_WALL_WOOD, OBJ_DOOR_WOOD);
+    rect_walls(map, x, y, w, h, OBJ_WALL_WOOD, OBJ_DOOR_WOOD, rng);
     fill_tiles(map, x + 1, y + 1, w - 2, h - 2, TILE_STONE_FLOOR);
 
     int centerX = x + w / 2;
@@ -553,18 +568,17 @@ void build_cannibal_shaman_hut(Map* map, int x, int y, uint64_t* rng)
 
 void build_cannibal_bone_pit(Map* map, int x, int y, uint64_t* rng)
 {
-    int w = 6 + rand() % 2;
-    int h = 6 + rand() % 2;
+    int w = 6 + structure_rand(rng, 2);
+    int h = 6 + structure_rand(rng, 2);
 
-    (void)rng;
-    rect_walls(map, x, y, w, h, OBJ_WALL_STONE, OBJ_DOOR_WOOD);
+    rect_walls(map, x, y, w, h, OBJ_WALL_STONE, OBJ_DOOR_WOOD, rng);
     fill_tiles(map, x + 1, y + 1, w - 2, h - 2, TILE_STONE_FLOOR);
 
     for (int j = y + 1; j < y + h - 1; ++j)
     {
         for (int i = x + 1; i < x + w - 1; ++i)
         {
-            if (rand() % 3 == 0)
+            if (structure_rand(rng, 3) == 0)
                 map_place_object(map, OBJ_BONE_PILE, i, j);
         }
     }
@@ -578,12 +592,11 @@ void build_cannibal_bone_pit(Map* map, int x, int y, uint64_t* rng)
 
 void build_crypt(Map* map, int x, int y, uint64_t* rng)
 {
-    int w = 5 + rand() % 4; // 5..8
-    int h = 5 + rand() % 4;
+    int w = 5 + structure_rand(rng, 4); // 5..8
+    int h = 5 + structure_rand(rng, 4);
 
-    (void)rng;
 
-    rect_walls(map, x, y, w, h, OBJ_WALL_STONE, OBJ_DOOR_WOOD);
+    rect_walls(map, x, y, w, h, OBJ_WALL_STONE, OBJ_DOOR_WOOD, rng);
 
     int cx = x + w / 2, cy = y + h / 2;
     map_place_object(map, OBJ_ALTAR, cx, cy);
@@ -595,35 +608,33 @@ void build_crypt(Map* map, int x, int y, uint64_t* rng)
 
     Rectangle bounds = {(float)x, (float)y, (float)w, (float)h};
     register_building_from_bounds(map, bounds, STRUCT_CRYPT);
-    // chunkgrid_mark_dirty_rect(gChunks, (Rectangle){(float)x, (float)y, (float)w, (float)h});
+    // chunkgrid_mark_dirty_rect(map->chunks, (Rectangle){(float)x, (float)y, (float)w, (float)h});
 }
 
 void build_ruin(Map* map, int x, int y, uint64_t* rng)
 {
-    int w = 3 + rand() % 3; // 3..5
-    int h = 3 + rand() % 3;
+    int w = 3 + structure_rand(rng, 3); // 3..5
+    int h = 3 + structure_rand(rng, 3);
 
-    (void)rng;
 
-    rect_walls(map, x, y, w, h, OBJ_WALL_STONE, OBJ_DOOR_WOOD);
+    rect_walls(map, x, y, w, h, OBJ_WALL_STONE, OBJ_DOOR_WOOD, rng);
 
     // murs “brisés”
-    if (rand() % 2)
+    if (structure_rand(rng, 2))
         map_place_object(map, OBJ_BONE_PILE, x + 1, y + 1);
 
     Rectangle bounds = {(float)x, (float)y, (float)w, (float)h};
     register_building_from_bounds(map, bounds, STRUCT_RUIN);
 
-    // chunkgrid_mark_dirty_rect(gChunks, (Rectangle){(float)x, (float)y, (float)w, (float)h});
+    // chunkgrid_mark_dirty_rect(map->chunks, (Rectangle){(float)x, (float)y, (float)w, (float)h});
 }
 
 void build_village_house(Map* map, int x, int y, uint64_t* rng)
 {
-    int w = 4 + rand() % 2; // 4..5
-    int h = 4 + rand() % 2;
+    int w = 4 + structure_rand(rng, 2); // 4..5
+    int h = 4 + structure_rand(rng, 2);
 
-    (void)rng;
-    rect_walls(map, x, y, w, h, OBJ_WALL_WOOD, OBJ_DOOR_WOOD);
+    rect_walls(map, x, y, w, h, OBJ_WALL_WOOD, OBJ_DOOR_WOOD, rng);
 
     map_place_object(map, OBJ_TABLE_WOOD, x + 1, y + 1);
     map_place_object(map, OBJ_CHAIR_WOOD, x + 2, y + 1);
@@ -632,17 +643,16 @@ void build_village_house(Map* map, int x, int y, uint64_t* rng)
     Rectangle bounds = {(float)x, (float)y, (float)w, (float)h};
     register_building_from_bounds(map, bounds, STRUCT_VILLAGE_HOUSE);
 
-    // chunkgrid_mark_dirty_rect(gChunks, (Rectangle){(float)x, (float)y, (float)w, (float)h});
+    // chunkgrid_mark_dirty_rect(map->chunks, (Rectangle){(float)x, (float)y, (float)w, (float)h});
 }
 
 void build_temple(Map* map, int x, int y, uint64_t* rng)
 {
-    int w = 6 + rand() % 4; // 6..9
-    int h = 6 + rand() % 4;
+    int w = 6 + structure_rand(rng, 4); // 6..9
+    int h = 6 + structure_rand(rng, 4);
 
-    (void)rng;
 
-    rect_walls(map, x, y, w, h, OBJ_WALL_STONE, OBJ_DOOR_WOOD);
+    rect_walls(map, x, y, w, h, OBJ_WALL_STONE, OBJ_DOOR_WOOD, rng);
 
     map_place_object(map, OBJ_ALTAR, x + w / 2, y + h / 2);
     map_place_object(map, OBJ_TORCH_WALL, x + 1, y + 1);
@@ -650,17 +660,16 @@ void build_temple(Map* map, int x, int y, uint64_t* rng)
 
     Rectangle bounds = {(float)x, (float)y, (float)w, (float)h};
     register_building_from_bounds(map, bounds, STRUCT_TEMPLE);
-    // chunkgrid_mark_dirty_rect(gChunks, (Rectangle){(float)x, (float)y, (float)w, (float)h});
+    // chunkgrid_mark_dirty_rect(map->chunks, (Rectangle){(float)x, (float)y, (float)w, (float)h});
 }
 
 void build_witch_hovel(Map* map, int x, int y, uint64_t* rng)
 {
-    int w = 5 + rand() % 2; // 5..6
-    int h = 5 + rand() % 2;
+    int w = 5 + structure_rand(rng, 2); // 5..6
+    int h = 5 + structure_rand(rng, 2);
 
-    (void)rng;
 
-    rect_walls(map, x, y, w, h, OBJ_WALL_WOOD, OBJ_DOOR_WOOD);
+    rect_walls(map, x, y, w, h, OBJ_WALL_WOOD, OBJ_DOOR_WOOD, rng);
 
     int cx = x + w / 2;
     int cy = y + h / 2;
@@ -668,9 +677,9 @@ void build_witch_hovel(Map* map, int x, int y, uint64_t* rng)
     map_place_object(map, OBJ_TOTEM_BLOOD, x + 1, y + 1);
     map_place_object(map, OBJ_TOTEM_BLOOD, x + w - 2, y + h - 2);
 
-    if (rand() % 2)
+    if (structure_rand(rng, 2))
         map_place_object(map, OBJ_BONE_PILE, cx - 1, cy);
-    if (rand() % 2)
+    if (structure_rand(rng, 2))
         map_place_object(map, OBJ_FIREPIT, cx, cy - 1);
 
     Rectangle bounds = {(float)x, (float)y, (float)w, (float)h};
@@ -679,12 +688,11 @@ void build_witch_hovel(Map* map, int x, int y, uint64_t* rng)
 
 void build_gallows(Map* map, int x, int y, uint64_t* rng)
 {
-    int w = 5 + rand() % 2; // 5..6
-    int h = 6 + rand() % 2; // 6..7
+    int w = 5 + structure_rand(rng, 2); // 5..6
+    int h = 6 + structure_rand(rng, 2); // 6..7
 
-    (void)rng;
 
-    rect_walls(map, x, y, w, h, OBJ_WALL_WOOD, OBJ_DOOR_WOOD);
+    rect_walls(map, x, y, w, h, OBJ_WALL_WOOD, OBJ_DOOR_WOOD, rng);
 
     int centerX = x + w / 2;
     int centerY = y + h / 2;
@@ -698,12 +706,11 @@ void build_gallows(Map* map, int x, int y, uint64_t* rng)
 
 void build_blood_garden(Map* map, int x, int y, uint64_t* rng)
 {
-    int w = 6 + rand() % 3; // 6..8
-    int h = 6 + rand() % 3;
+    int w = 6 + structure_rand(rng, 3); // 6..8
+    int h = 6 + structure_rand(rng, 3);
 
-    (void)rng;
 
-    rect_walls(map, x, y, w, h, OBJ_WALL_STONE, OBJ_DOOR_WOOD);
+    rect_walls(map, x, y, w, h, OBJ_WALL_STONE, OBJ_DOOR_WOOD, rng);
 
     int cx = x + w / 2;
     int cy = y + h / 2;
@@ -720,12 +727,11 @@ void build_blood_garden(Map* map, int x, int y, uint64_t* rng)
 
 void build_flesh_pit(Map* map, int x, int y, uint64_t* rng)
 {
-    int w = 6 + rand() % 3; // 6..8
-    int h = 6 + rand() % 3;
+    int w = 6 + structure_rand(rng, 3); // 6..8
+    int h = 6 + structure_rand(rng, 3);
 
-    (void)rng;
 
-    rect_walls(map, x, y, w, h, OBJ_WALL_STONE, OBJ_DOOR_WOOD);
+    rect_walls(map, x, y, w, h, OBJ_WALL_STONE, OBJ_DOOR_WOOD, rng);
 
     int cx = x + w / 2;
     int cy = y + h / 2;
@@ -733,16 +739,16 @@ void build_flesh_pit(Map* map, int x, int y, uint64_t* rng)
 
     for (int i = x + 1; i < x + w - 1; ++i)
     {
-        if (rand() % 3 == 0)
+        if (structure_rand(rng, 3) == 0)
             map_place_object(map, OBJ_MEAT_HOOK, i, y + 1);
-        if (rand() % 3 == 0)
+        if (structure_rand(rng, 3) == 0)
             map_place_object(map, OBJ_MEAT_HOOK, i, y + h - 2);
     }
     for (int j = y + 2; j < y + h - 2; ++j)
     {
-        if (rand() % 3 == 0)
+        if (structure_rand(rng, 3) == 0)
             map_place_object(map, OBJ_MEAT_HOOK, x + 1, j);
-        if (rand() % 3 == 0)
+        if (structure_rand(rng, 3) == 0)
             map_place_object(map, OBJ_MEAT_HOOK, x + w - 2, j);
     }
 
@@ -753,7 +759,7 @@ void build_flesh_pit(Map* map, int x, int y, uint64_t* rng)
             if (i == cx && j == cy)
                 continue;
 
-            float r = (float)rand() / (float)RAND_MAX;
+            float r = structure_rand01(rng);
             if (r < 0.14f)
                 map_place_object(map, OBJ_BONE_PILE, i, j);
             else if (r < 0.19f)
@@ -767,12 +773,11 @@ void build_flesh_pit(Map* map, int x, int y, uint64_t* rng)
 
 void build_void_obelisk(Map* map, int x, int y, uint64_t* rng)
 {
-    int w = 5 + rand() % 3; // 5..7
-    int h = 5 + rand() % 3;
+    int w = 5 + structure_rand(rng, 3); // 5..7
+    int h = 5 + structure_rand(rng, 3);
 
-    (void)rng;
 
-    rect_walls(map, x, y, w, h, OBJ_WALL_STONE, OBJ_DOOR_WOOD);
+    rect_walls(map, x, y, w, h, OBJ_WALL_STONE, OBJ_DOOR_WOOD, rng);
 
     int cx = x + w / 2;
     int cy = y + h / 2;
@@ -798,12 +803,11 @@ void build_void_obelisk(Map* map, int x, int y, uint64_t* rng)
 
 void build_plague_nursery(Map* map, int x, int y, uint64_t* rng)
 {
-    int w = 5 + rand() % 3; // 5..7
-    int h = 5 + rand() % 3;
+    int w = 5 + structure_rand(rng, 3); // 5..7
+    int h = 5 + structure_rand(rng, 3);
 
-    (void)rng;
 
-    rect_walls(map, x, y, w, h, OBJ_WALL_WOOD, OBJ_DOOR_WOOD);
+    rect_walls(map, x, y, w, h, OBJ_WALL_WOOD, OBJ_DOOR_WOOD, rng);
 
     int cx = x + w / 2;
     int cy = y + h / 2;
@@ -816,7 +820,7 @@ void build_plague_nursery(Map* map, int x, int y, uint64_t* rng)
             if (i == cx && j == cy)
                 continue;
 
-            float r = (float)rand() / (float)RAND_MAX;
+            float r = structure_rand01(rng);
             if (r < 0.25f)
                 map_place_object(map, OBJ_PLAGUE_POD, i, j);
             else if (r < 0.3f)
@@ -1754,75 +1758,102 @@ void load_structure_metadata(const char* path)
     fclose(f);
 }
 
-const StructureDef* pick_structure_for_biome(BiomeKind biome, uint64_t* rng, const int* structureCounts)
+// -----------------------------------------------------------------------------
+// Weighted structure picks (one alias table per biome)
+// -----------------------------------------------------------------------------
+
+typedef struct BiomeStructureSampler
 {
-    (void)rng;
-    const BiomeDef* def = get_biome_def(biome);
-    if (!def || def->structureCount <= 0 || !def->structures)
-        return NULL;
+    AliasTable table;     /**< Columns follow BiomeDef::structures. */
+    bool       built;
+    bool       exhausted; /**< Nothing may spawn any more; picks return NULL without a rebuild. */
+} BiomeStructureSampler;
 
-    float totalWeight = 0.0f;
-    uint32_t biomeMask = 1u << biome;
-    for (int i = 0; i < def->structureCount; ++i)
-    {
-        const BiomeStructureEntry* entry = &def->structures[i];
-        const StructureDef*        sDef  = get_structure_def(entry->kind);
-        if (!sDef)
-            continue;
+struct StructureSamplers
+{
+    BiomeStructureSampler biomes[BIO_MAX];
+};
 
-        if (sDef->allowedBiomesMask != 0 && (sDef->allowedBiomesMask & biomeMask) == 0)
-            continue;
+static bool structure_capped(const StructureDef* sDef, const int* structureCounts)
+{
+    return structureCounts && sDef->maxInstances > 0 && structureCounts[sDef->kind] >= sDef->maxInstances;
+}
 
-        if (structureCounts && sDef->maxInstances > 0 && structureCounts[sDef->kind] >= sDef->maxInstances)
-            continue;
+/** Effective weight of a biome entry: entry weight times rarity, 0 when it may not spawn. */
+static float structure_entry_weight(BiomeKind biome, const BiomeStructureEntry* entry, const int* structureCounts)
+{
+    const StructureDef* sDef = get_structure_def(entry->kind);
+    if (!sDef || entry->weight <= 0.0f)
+        return 0.0f;
+    if (sDef->allowedBiomesMask != 0 && (sDef->allowedBiomesMask & (1u << biome)) == 0)
+        return 0.0f;
+    if (structure_capped(sDef, structureCounts))
+        return 0.0f;
+    return entry->weight * (sDef->rarity > 0.0f ? sDef->rarity : 1.0f);
+}
 
-        float w = entry->weight;
-        if (w <= 0.0f)
-            continue;
+static void structure_sampler_build(StructureSamplers* samplers, BiomeKind biome, const int* structureCounts)
+{
+    BiomeStructureSampler* sampler = &samplers->biomes[biome];
+    const BiomeDef*        def     = get_biome_def(biome);
+    int                    count   = (def && def->structures) ? def->structureCount : 0;
+    float*                 weights = count > 0 ? (float*)malloc((size_t)count * sizeof(float)) : NULL;
 
-        totalWeight += w * (sDef->rarity > 0.0f ? sDef->rarity : 1.0f);
-    }
+    for (int i = 0; i < count && weights; ++i)
+        weights[i] = structure_entry_weight(biome, &def->structures[i], structureCounts);
+
+    sampler->exhausted = !alias_table_build(&sampler->table, weights, weights ? count : 0);
+    sampler->built     = true;
+    free(weights);
+}
 
-    if (totalWeight <= 0.0f)
+StructureSamplers* structure_samplers_create(void)
+{
+    StructureSamplers* samplers = (StructureSamplers*)calloc(1, sizeof(StructureSamplers));
+    if (!samplers)
         return NULL;
+    for (int b = 0; b < BIO_MAX; ++b)
+        structure_sampler_build(samplers, (BiomeKind)b, NULL);
+    return samplers;
+}
 
-    float pick = ((float)rand() / (float)RAND_MAX) * totalWeight;
-    float acc  = 0.0f;
+void structure_samplers_destroy(StructureSamplers* samplers)
+{
+    if (!samplers)
+        return;
+    for (int b = 0; b < BIO_MAX; ++b)
+        alias_table_free(&samplers->biomes[b].table);
+    free(samplers);
+}
 
-    for (int i = 0; i < def->structureCount; ++i)
-    {
-        const BiomeStructureEntry* entry = &def->structures[i];
-        const StructureDef*        sDef  = get_structure_def(entry->kind);
-        if (!sDef)
-            continue;
+const StructureDef* pick_structure_for_biome(StructureSamplers* samplers, BiomeKind biome, uint64_t* rng, const int* structureCounts)
+{
+    if (!samplers || (int)biome < 0 || biome >= BIO_MAX || !rng)
+        return NULL;
 
-        if (sDef->allowedBiomesMask != 0 && (sDef->allowedBiomesMask & biomeMask) == 0)
-            continue;
+    const BiomeDef* def = get_biome_def(biome);
+    if (!def || def->structureCount <= 0 || !def->structures)
+        return NULL;
 
-        if (structureCounts && sDef->maxInstances > 0 && structureCounts[sDef->kind] >= sDef->maxInstances)
-            continue;
+    BiomeStructureSampler* sampler = &samplers->biomes[biome];
+    if (!sampler->built || (!sampler->exhausted && sampler->table.count != def->structureCount))
+        structure_sampler_build(samplers, biome, structureCounts);
 
-        float w = entry->weight;
-        if (w <= 0.0f)
-            continue;
+    // Caps only grow during a generation, so an exhausted biome stays so for
+    // the rest of it.
+    while (!sampler->exhausted)
+    {
+        int index = alias_table_sample(&sampler->table, worldgen_draw(rng));
+        if (index < 0)
+            return NULL;
 
-        float effective = w * (sDef->rarity > 0.0f ? sDef->rarity : 1.0f);
-        acc += effective;
-        if (pick <= acc)
+        const StructureDef* sDef = get_structure_def(def->structures[index].kind);
+        if (!structure_capped(sDef, structureCounts))
             return sDef;
-    }
 
-    for (int i = def->structureCount - 1; i >= 0; --i)
-    {
-        const StructureDef* sDef = get_structure_def(def->structures[i].kind);
-        if (!sDef)
-            continue;
-        if (sDef->allowedBiomesMask != 0 && (sDef->allowedBiomesMask & biomeMask) == 0)
-            continue;
-        if (structureCounts && sDef->maxInstances > 0 && structureCounts[sDef->kind] >= sDef->maxInstances)
-            continue;
-        if (sDef)
-            return sDef;
+        // A kind hit maxInstances since the table was built: drop every capped
+        // kind and draw again. Each rebuild removes at least one outcome.
+        structure_sampler_build(samplers, biome, structureCounts);
     }
     return NULL;
 }
@@ -1,42 +1,25 @@
 /**
  * @file world_time.c
- * @brief Implements the global time-of-day and seasonal simulation.
+ * @brief Implements the per-world time-of-day and seasonal simulation.
  */
 
 #include "world_time.h"
 
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "raylib.h"
 
 #include "biome_loader.h"
+#include "climate_field.h"
+#include "tile_stats.h"
 #include "tile.h"
 #include "ui_theme.h"
 
 static const float s_timeWarpMultipliers[] = {1.0f, 6.0f, 24.0f, 72.0f};
 static const int   s_timeWarpCount         = (int)(sizeof(s_timeWarpMultipliers) / sizeof(s_timeWarpMultipliers[0]));
 
-static float      s_baseFertility[TILE_MAX];
-static float      s_baseHumidity[TILE_MAX];
-static float      s_baseTemperature[TILE_MAX];
-static bool       s_baselineCaptured = false;
-static int        s_tileCounts[TILE_MAX];
-static int        s_totalTiles       = 0;
-static bool       s_countsReady      = false;
-static float      s_avgFertility     = 0.0f;
-static float      s_avgHumidity      = 0.0f;
-static float      s_avgTemperature   = 0.0f;
-static float      s_currentDarkness  = 0.0f;
-static int        s_biomeTileCounts[BIO_MAX];
-static float      s_biomeAvgFertility[BIO_MAX];
-static float      s_biomeAvgHumidity[BIO_MAX];
-static float      s_biomeAvgTemperature[BIO_MAX];
-static int        s_currentDayIndex     = 1;
-static float      s_currentTimeOfDay    = 0.0f;
-static float      s_currentSecondsPerDay = 600.0f;
-static float      s_lastStepSeconds     = 0.0f;
-
 static const char* season_to_string(SeasonKind season)
 {
     switch (season)
@@ -59,39 +42,6 @@ static SeasonKind season_next(SeasonKind s)
     return (SeasonKind)(((int)s + 1) % 4);
 }
 
-static BiomeKind biome_from_tile(TileTypeID id)
-{
-    switch (id)
-    {
-        case TILE_FOREST:
-            return BIO_FOREST;
-        case TILE_GRASS:
-        case TILE_PLAIN:
-            return BIO_PLAIN;
-        case TILE_SAVANNA:
-            return BIO_SAVANNA;
-        case TILE_TUNDRA:
-        case TILE_TUNDRA_2:
-            return BIO_TUNDRA;
-        case TILE_DESERT:
-            return BIO_DESERT;
-        case TILE_SWAMP:
-            return BIO_SWAMP;
-        case TILE_MOUNTAIN:
-            return BIO_MOUNTAIN;
-        case TILE_CURSED_FOREST:
-        case TILE_POISON:
-            return BIO_CURSED;
-        case TILE_HELL:
-        case TILE_LAVA:
-            return BIO_HELL;
-        case TILE_WATER:
-            return BIO_PLAIN;
-        default:
-            return BIO_PLAIN;
-    }
-}
-
 static float season_daylight_fraction(SeasonKind season)
 {
     switch (season)
@@ -163,102 +113,10 @@ static float compute_darkness(const WorldTime* t)
     return 1.0f;
 }
 
-static void capture_baseline(void)
-{
-    if (s_baselineCaptured)
-        return;
-
-    for (int i = 0; i < TILE_MAX; ++i)
-    {
-        s_baseFertility[i]   = tileTypes[i].fertility;
-        s_baseHumidity[i]    = tileTypes[i].humidity;
-        s_baseTemperature[i] = tileTypes[i].temperature;
-        tileTypes[i].darkness = 0.0f;
-    }
-    s_baselineCaptured = true;
-}
-
-static void ensure_tile_counts(Map* map)
+static void update_averages(Map* map)
 {
-    if (s_countsReady || !map)
-        return;
-
-    s_totalTiles = 0;
-    for (int i = 0; i < TILE_MAX; ++i)
-        s_tileCounts[i] = 0;
-    for (int i = 0; i < BIO_MAX; ++i)
-        s_biomeTileCounts[i] = 0;
-
-    for (int y = 0; y < map->height; ++y)
-        for (int x = 0; x < map->width; ++x)
-        {
-            TileTypeID id = map->tiles[y][x];
-            if (id >= 0 && id < TILE_MAX)
-            {
-                s_tileCounts[id]++;
-                s_totalTiles++;
-                BiomeKind biome = biome_from_tile(id);
-                if (biome >= 0 && biome < BIO_MAX)
-                    s_biomeTileCounts[biome]++;
-            }
-        }
-
-    s_countsReady = (s_totalTiles > 0);
-}
-
-static void update_averages(void)
-{
-    if (!s_countsReady || s_totalTiles <= 0)
-        return;
-
-    double sumF = 0.0;
-    double sumH = 0.0;
-    double sumT = 0.0;
-    double biomeSumF[BIO_MAX] = {0.0};
-    double biomeSumH[BIO_MAX] = {0.0};
-    double biomeSumT[BIO_MAX] = {0.0};
-
-    for (int i = 0; i < TILE_MAX; ++i)
-    {
-        if (s_tileCounts[i] == 0)
-            continue;
-
-        double weightedF = (double)tileTypes[i].fertility * (double)s_tileCounts[i];
-        double weightedH = (double)tileTypes[i].humidity * (double)s_tileCounts[i];
-        double weightedT = (double)tileTypes[i].temperature * (double)s_tileCounts[i];
-
-        sumF += weightedF;
-        sumH += weightedH;
-        sumT += weightedT;
-
-        BiomeKind biome = biome_from_tile((TileTypeID)i);
-        if (biome >= 0 && biome < BIO_MAX)
-        {
-            biomeSumF[biome] += weightedF;
-            biomeSumH[biome] += weightedH;
-            biomeSumT[biome] += weightedT;
-        }
-    }
-
-    s_avgFertility   = (float)(sumF / s_totalTiles);
-    s_avgHumidity    = (float)(sumH / s_totalTiles);
-    s_avgTemperature = (float)(sumT / s_totalTiles);
-
-    for (int i = 0; i < BIO_MAX; ++i)
-    {
-        if (s_biomeTileCounts[i] > 0)
-        {
-            s_biomeAvgFertility[i]   = (float)(biomeSumF[i] / (double)s_biomeTileCounts[i]);
-            s_biomeAvgHumidity[i]    = (float)(biomeSumH[i] / (double)s_biomeTileCounts[i]);
-            s_biomeAvgTemperature[i] = (float)(biomeSumT[i] / (double)s_biomeTileCounts[i]);
-        }
-        else
-        {
-            s_biomeAvgFertility[i]   = 0.0f;
-            s_biomeAvgHumidity[i]    = 0.0f;
-            s_biomeAvgTemperature[i] = 0.0f;
-        }
-    }
+    TileClimate* mean = &map->climateMean;
+    tile_stats_climate_means(map, tile_stats_global(map), BIO_MAX, &mean->fertility, &mean->humidity, &mean->temperature);
 }
 
 void world_time_init(WorldTime* t)
@@ -266,31 +124,13 @@ void world_time_init(WorldTime* t)
     if (!t)
         return;
 
-    capture_baseline();
-
     t->secondsPerDay   = 600.0f;
     t->timeOfDay       = 0.0f;
     t->currentDay      = 1;
     t->season          = SEASON_SPRING;
-   t->timeWarpIndex   = 0;
-   t->lastDeltaSeconds = 0.0f;
-
-    s_currentDarkness = 0.0f;
-    s_currentDayIndex     = t->currentDay;
-    s_currentTimeOfDay    = t->timeOfDay;
-    s_currentSecondsPerDay = t->secondsPerDay;
-    s_lastStepSeconds     = 0.0f;
-    s_countsReady     = false;
-    s_avgFertility    = 0.0f;
-    s_avgHumidity     = 0.0f;
-    s_avgTemperature  = 0.0f;
-    for (int i = 0; i < BIO_MAX; ++i)
-    {
-        s_biomeTileCounts[i]    = 0;
-        s_biomeAvgFertility[i]  = 0.0f;
-        s_biomeAvgHumidity[i]   = 0.0f;
-        s_biomeAvgTemperature[i]= 0.0f;
-    }
+    t->timeWarpIndex    = 0;
+    t->lastDeltaSeconds = 0.0f;
+    t->darkness         = 0.0f;
 }
 
 void world_time_cycle_timewarp(WorldTime* t)
@@ -322,7 +162,6 @@ void world_time_update(WorldTime* t, float deltaTime)
     float timeScale = world_time_get_timewarp_multiplier(t);
     float scaledDelta  = deltaTime * timeScale;
     t->lastDeltaSeconds = scaledDelta;
-    s_lastStepSeconds   = scaledDelta;
 
     if (t->secondsPerDay <= 0.0f)
         t->secondsPerDay = 600.0f;
@@ -340,22 +179,14 @@ void world_time_update(WorldTime* t, float deltaTime)
     if (t->timeOfDay < 0.0f)
         t->timeOfDay += 1.0f;
 
-    s_currentDarkness    = compute_darkness(t);
-    s_currentDayIndex     = t->currentDay;
-    s_currentTimeOfDay    = t->timeOfDay;
-    s_currentSecondsPerDay = t->secondsPerDay;
-
-    for (int i = 0; i < TILE_MAX; ++i)
-        tileTypes[i].darkness = s_currentDarkness;
+    t->darkness = compute_darkness(t);
 }
 
 void world_apply_season_effects(Map* map, const WorldTime* t)
 {
-    if (!t)
+    if (!map || !t)
         return;
 
-    ensure_tile_counts(map);
-
     typedef struct
     {
         float fertilityOffset;
@@ -377,9 +208,9 @@ void world_apply_season_effects(Map* map, const WorldTime* t)
 
     for (int i = 0; i < TILE_MAX; ++i)
     {
-        float targetF = s_baseFertility[i] + active.fertilityOffset;
-        float targetH = s_baseHumidity[i] + active.humidityOffset;
-        float targetT = s_baseTemperature[i] + active.temperatureOffset;
+        float targetF = tileTypes[i].fertility + active.fertilityOffset;
+        float targetH = tileTypes[i].humidity + active.humidityOffset;
+        float targetT = tileTypes[i].temperature + active.temperatureOffset;
 
         if (targetF < 0.0f)
             targetF = 0.0f;
@@ -391,37 +222,41 @@ void world_apply_season_effects(Map* map, const WorldTime* t)
         if (targetH > 1.0f)
             targetH = 1.0f;
 
-        tileTypes[i].fertility += (targetF - tileTypes[i].fertility) * blend;
-        tileTypes[i].humidity += (targetH - tileTypes[i].humidity) * blend;
-        tileTypes[i].temperature += (targetT - tileTypes[i].temperature) * blend;
+        TileClimate* climate = &map->tileClimate[i];
+        climate->fertility += (targetF - climate->fertility) * blend;
+        climate->humidity += (targetH - climate->humidity) * blend;
+        climate->temperature += (targetT - climate->temperature) * blend;
     }
 
-    update_averages();
+    update_averages(map);
+
+    // Local layers chase the seasonal tile values at their own fixed rate.
+    climate_field_update(map, t->lastDeltaSeconds);
 }
 
-float world_time_get_darkness(void)
+float world_time_get_darkness(const WorldTime* t)
 {
-    return s_currentDarkness;
+    return t ? t->darkness : 0.0f;
 }
 
-int world_time_get_current_day(void)
+int world_time_get_current_day(const WorldTime* t)
 {
-    return s_currentDayIndex;
+    return t ? t->currentDay : 0;
 }
 
-float world_time_get_time_of_day(void)
+float world_time_get_time_of_day(const WorldTime* t)
 {
-    return s_currentTimeOfDay;
+    return t ? t->timeOfDay : 0.0f;
 }
 
-float world_time_get_seconds_per_day(void)
+float world_time_get_seconds_per_day(const WorldTime* t)
 {
-    return s_currentSecondsPerDay;
+    return t ? t->secondsPerDay : 0.0f;
 }
 
-float world_time_get_last_step_seconds(void)
+float world_time_get_last_step_seconds(const WorldTime* t)
 {
-    return s_lastStepSeconds;
+    return t ? t->lastDeltaSeconds : 0.0f;
 }
 
 void world_time_draw_ui(const WorldTime* t, const Map* map, const Camera2D* camera)
@@ -451,16 +286,18 @@ void world_time_draw_ui(const WorldTime* t, const Map* map, const Camera2D* came
     float warp = world_time_get_timewarp_multiplier(t);
     char  warpLine[160];
     if (warp > 1.0f)
-        snprintf(warpLine, sizeof(warpLine), "Accélération x%.0f | Obscurité %.2f", warp, s_currentDarkness);
+        snprintf(warpLine, sizeof(warpLine), "Accélération x%.0f | Obscurité %.2f", warp, t->darkness);
     else
-        snprintf(warpLine, sizeof(warpLine), "Obscurité %.2f | T pour accélérer", s_currentDarkness);
+        snprintf(warpLine, sizeof(warpLine), "Obscurité %.2f | T pour accélérer", t->darkness);
 
     const char* biomeName       = "GLOBAL";
-    float       biomeFertility  = s_avgFertility;
-    float       biomeHumidity   = s_avgHumidity;
-    float       biomeTemp       = s_avgTemperature;
-    int         biomeTiles      = s_totalTiles;
-    bool        biomeStatsValid = false;
+    float       biomeFertility  = map ? map->climateMean.fertility : 0.0f;
+    float       biomeHumidity   = map ? map->climateMean.humidity : 0.0f;
+    float       biomeTemp       = map ? map->climateMean.temperature : 0.0f;
+    int         biomeTiles      = map ? tile_stats_global(map)->totalTiles : 0;
+    bool        localValid      = false;
+    float       localTemp       = 0.0f;
+    float       localHumidity   = 0.0f;
 
     if (map && camera)
     {
@@ -471,25 +308,30 @@ void world_time_draw_ui(const WorldTime* t, const Map* map, const Camera2D* came
 
         if (tileX >= 0 && tileX < map->width && tileY >= 0 && tileY < map->height)
         {
+            localValid    = true;
+            localTemp     = climate_field_temperature_at(map, tileX, tileY);
+            localHumidity = climate_field_humidity_at(map, tileX, tileY);
+
+            // Regional figures: the focused biome over the chunks currently in view.
+            Rectangle view = {camera->target.x - camera->offset.x / camera->zoom,
+                              camera->target.y - camera->offset.y / camera->zoom,
+                              (float)GetScreenWidth() / camera->zoom,
+                              (float)GetScreenHeight() / camera->zoom};
+            TileStatsSummary region;
+            tile_stats_query_rect(map, view, &region);
+
             TileTypeID tid   = map->tiles[tileY][tileX];
-            BiomeKind  biome = biome_from_tile(tid);
-            if (biome >= 0 && biome < BIO_MAX && s_biomeTileCounts[biome] > 0)
+            BiomeKind  biome = tile_stats_biome_of(tid);
+            if (biome >= 0 && biome < BIO_MAX && region.biomeCounts[biome] > 0)
             {
-                biomeStatsValid = true;
-                biomeName       = get_biome_name(biome);
+                biomeName = get_biome_name(biome);
                 if (!biomeName)
                     biomeName = "UNKNOWN";
-                biomeTiles     = s_biomeTileCounts[biome];
-                biomeFertility = s_biomeAvgFertility[biome];
-                biomeHumidity  = s_biomeAvgHumidity[biome];
-                biomeTemp      = s_biomeAvgTemperature[biome];
+                biomeTiles = tile_stats_climate_means(map, &region, biome, &biomeFertility, &biomeHumidity, &biomeTemp);
             }
         }
     }
 
-    if (!biomeStatsValid && biomeTiles <= 0)
-        biomeTiles = s_totalTiles;
-
     char statsLine[200];
     snprintf(statsLine, sizeof(statsLine), "Biome %s (%d) | Fert %.2f | Humid %.2f | %.1fC",
              biomeName,
@@ -497,6 +339,11 @@ void world_time_draw_ui(const WorldTime* t, const Map* map, const Camera2D* came
              biomeFertility,
              biomeHumidity,
              biomeTemp);
+    if (localValid)
+    {
+        size_t used = strlen(statsLine);
+        snprintf(statsLine + used, sizeof(statsLine) - used, " | Local %.1fC %.2f", localTemp, localHumidity);
+    }
     const UiTheme* ui = ui_theme_get();
     Color textPrimary   = ui ? ui->textPrimary : WHITE;
     Color textSecondary = ui ? ui->textSecondary : ColorAlpha(WHITE, 0.85f);